@@ -8,19 +8,67 @@
    ----------------------------------------------- */
 
 #include "configparser.h"
-#include "../window.h"
-#include <sys\stat.h>
+#include "../util/logging.h"
+#include <sys/stat.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+/* ---------
+   Constants
+   --------- */
+#define CONFIG_RELOAD_INTERVAL_MS 500
+
+/* --------------
+   Internal Types
+   -------------- */
+typedef std::unordered_map<stringID, std::string>   ConfigSection;
+typedef std::unordered_map<stringID, ConfigSection> ConfigSections;
+
+struct ConfigFile
+{
+    stringID       cf_name;
+    std::string    cf_path;
+    time_t         cf_modifiedTime;
+    off_t          cf_fileSize;
+    ConfigSections cf_sections;
+};
 
 /* -------
    Globals
    ------- */
-static std::string i_configFileName;
+static std::vector<ConfigFile> i_configFiles;
+static std::mutex              i_configMutex;
+static uint32                  i_configRevision = 0U;
 
 /* -------------------
    Internal Signatures
    ------------------- */
 static bool
+getModifiedTime(const std::string& path,
+                time_t&            outModifiedTime,
+                off_t&             outFileSize);
+
+static bool
+parseFile(const std::string& path,
+          ConfigSections&    outSections);
+
+static bool
+coversSections(const ConfigSections& sections,
+               const ConfigSections& previous);
+
+static std::string
+trim(const std::string& str);
+
+static const std::string*
+findValue(cstring section,
+          cstring varname);
+
+static bool
 getBoolBuffer(cstring buffer);
 
 static int
@@ -35,37 +83,145 @@ getBufferFloat(cstring charBuffer);
 bool
 config::initConfigFile(cstring configName)
 {
-    std::string fullPath(configName);
-    fullPath = "config/" + fullPath + ".ini";
+    std::lock_guard<std::mutex> lock(i_configMutex);
 
-    struct stat buffer;
-    if (stat(fullPath.c_str(), &buffer))
+    const stringID configID = hashString(configName);
+    for (auto citer = i_configFiles.cbegin();
+              citer != i_configFiles.cend();
+            ++citer)
     {
-        std::string message("The ");
-        message += configName;
-        message += " config file could not be found. Press OK to exit the application";
-        MessageBox(nullptr, message.c_str(), "Config file not Found", MB_ICONERROR);
+        if (citer->cf_name == configID) return true;
+    }
+
+    ConfigFile file = {};
+    file.cf_name = configID;
+    file.cf_path = "config/" + std::string(configName) + ".ini";
+
+    if (!getModifiedTime(file.cf_path, file.cf_modifiedTime, file.cf_fileSize) ||
+        !parseFile(file.cf_path, file.cf_sections))
+    {
+        logstring("Config file not found: ");
+        logline(file.cf_path.c_str());
         return false;
     }
 
-    i_configFileName = fullPath;
+    i_configFiles.push_back(file);
+    ++i_configRevision;
     return true;
 }
 
+bool
+config::reloadChangedFiles()
+{
+    typedef std::chrono::steady_clock clock;
+    static clock::time_point s_lastCheck;
+
+    const clock::time_point now = clock::now();
+    if (now - s_lastCheck < std::chrono::milliseconds(CONFIG_RELOAD_INTERVAL_MS)) return false;
+    s_lastCheck = now;
+
+    std::lock_guard<std::mutex> lock(i_configMutex);
+
+    bool reloaded = false;
+    for (auto iter = i_configFiles.begin();
+              iter != i_configFiles.end();
+            ++iter)
+    {
+        // Modification times only have a resolution of a second,
+        // so a second save within it is told apart by its size
+        time_t modifiedTime = 0;
+        off_t  fileSize     = 0;
+        if (!getModifiedTime(iter->cf_path, modifiedTime, fileSize) ||
+            (modifiedTime == iter->cf_modifiedTime && fileSize == iter->cf_fileSize)) continue;
+
+        // A file caught mid save still parses, only short. A reload
+        // must therefore keep every section and key of the previous
+        // parse, or it is rejected and the old values (and the old
+        // modification time, so that the next poll retries) are
+        // kept. Removing keys takes a restart
+        ConfigSections sections;
+        if (!parseFile(iter->cf_path, sections) ||
+            !coversSections(sections, iter->cf_sections))
+        {
+            logstring("Rejected incomplete config file: ");
+            logline(iter->cf_path.c_str());
+            continue;
+        }
+
+        iter->cf_modifiedTime = modifiedTime;
+        iter->cf_fileSize     = fileSize;
+        iter->cf_sections.swap(sections);
+        ++i_configRevision;
+        reloaded = true;
+
+        logstring("Reloaded config file: ");
+        logline(iter->cf_path.c_str());
+    }
+
+    return reloaded;
+}
+
+uint32
+config::getRevision()
+{
+    std::lock_guard<std::mutex> lock(i_configMutex);
+    return i_configRevision;
+}
+
+bool
+config::hasValue(cstring section,
+                 cstring varname)
+{
+    std::lock_guard<std::mutex> lock(i_configMutex);
+    return findValue(section, varname) != nullptr;
+}
+
+bool
+config::getBool(cstring    section,
+                cstring    varname,
+                const bool defaultValue)
+{
+    std::lock_guard<std::mutex> lock(i_configMutex);
+    const std::string* value = findValue(section, varname);
+    return value ? getBoolBuffer(value->c_str()) : defaultValue;
+}
+
+uint32
+config::getUint(cstring      section,
+                cstring      varname,
+                const uint32 defaultValue)
+{
+    std::lock_guard<std::mutex> lock(i_configMutex);
+    const std::string* value = findValue(section, varname);
+    return value ? static_cast<uint32>(getBufferInt(value->c_str())) : defaultValue;
+}
+
+real32
+config::getFloat(cstring      section,
+                 cstring      varname,
+                 const real32 defaultValue)
+{
+    std::lock_guard<std::mutex> lock(i_configMutex);
+    const std::string* value = findValue(section, varname);
+    return value ? getBufferFloat(value->c_str()) : defaultValue;
+}
+
+stringID
+config::getString(cstring section,
+                  cstring varname,
+                  cstring defaultValue)
+{
+    std::lock_guard<std::mutex> lock(i_configMutex);
+    const std::string* value = findValue(section, varname);
+    return internString(value ? value->c_str() : defaultValue);
+}
+
 void
 config::extractConfigString(cstring   section,
                             cstring   varname,
                             stringID* outStringID)
 {
-    char buffer[32];
-    GetPrivateProfileString(section,
-                            varname,
-                            "",
-                            buffer,
-                            ARRAYSIZE(buffer),
-                            i_configFileName.c_str());
-
-    *outStringID = internString(buffer);
+    *outStringID = getString(section, varname, "");
 }
 
 void
@@ -73,15 +229,7 @@ config::extractConfigBool(cstring section,
                           cstring varname,
                           bool*   outBool)
 {
-    char buffer[8];
-    GetPrivateProfileString(section,
-                            varname,
-                            "",
-                            buffer,
-                            ARRAYSIZE(buffer),
-                            i_configFileName.c_str());
-
-    *outBool = getBoolBuffer(buffer);
+    *outBool = getBool(section, varname, false);
 }
 
 void 
@@ -89,15 +237,7 @@ config::extractConfigUint(cstring section,
                           cstring varname,
                           uint32* outUint)
 {
-    char buffer[16];
-    GetPrivateProfileString(section,
-		                    varname,
-		                    "",
-		                    buffer,
-		                    ARRAYSIZE(buffer),
-                    		i_configFileName.c_str());
-
-    *outUint = getBufferInt(buffer);
+    *outUint = getUint(section, varname, 0U);
 }
 
 void
@@ -105,20 +245,123 @@ config::extractConfigFloat(cstring section,
                            cstring varname,
                            float*  outFloat)
 {
-    char buffer[16];
-    GetPrivateProfileString(section,
-		                    varname,
-		                    "",
-		                    buffer,
-		                    ARRAYSIZE(buffer),
-                    		i_configFileName.c_str());
-
-    *outFloat = getBufferFloat(buffer);
+    *outFloat = getFloat(section, varname, 0.0f);
 }
 
 /* ------------------
    Internal Functions
    ------------------ */
+static bool
+getModifiedTime(const std::string& path,
+                time_t&            outModifiedTime,
+                off_t&             outFileSize)
+{
+    struct stat buffer;
+    if (stat(path.c_str(), &buffer)) return false;
+
+    outModifiedTime = buffer.st_mtime;
+    outFileSize     = buffer.st_size;
+    return true;
+}
+
+static bool
+parseFile(const std::string& path,
+          ConfigSections&    outSections)
+{
+    std::ifstream file(path);
+    if (!file) return false;
+
+    // Keys before the first section header are ignored, as are
+    // lines starting with ';' or '#'
+    ConfigSection* currSection = nullptr;
+    std::string    line;
+    while (std::getline(file, line))
+    {
+        line = trim(line);
+        if (line.empty() || line[0] == ';' || line[0] == '#') continue;
+
+        if (line[0] == '[')
+        {
+            const size_t sectionEnd = line.find(']');
+            if (sectionEnd == std::string::npos) continue;
+
+            currSection = &outSections[hashString(trim(line.substr(1, sectionEnd - 1)).c_str())];
+            continue;
+        }
+
+        const size_t separator = line.find('=');
+        if (!currSection || separator == std::string::npos) continue;
+
+        // Values may be quoted to keep surrounding whitespace
+        std::string value = trim(line.substr(separator + 1));
+        if (value.size() >= 2U && value.front() == '"' && value.back() == '"')
+        {
+            value = value.substr(1, value.size() - 2U);
+        }
+
+        (*currSection)[hashString(trim(line.substr(0, separator)).c_str())] = value;
+    }
+
+    return true;
+}
+
+static bool
+coversSections(const ConfigSections& sections,
+               const ConfigSections& previous)
+{
+    if (sections.empty()) return false;
+
+    for (auto citer = previous.cbegin();
+              citer != previous.cend();
+            ++citer)
+    {
+        auto sectionIter = sections.find(citer->first);
+        if (sectionIter == sections.cend()) return false;
+
+        for (auto keyIter = citer->second.cbegin();
+                  keyIter != citer->second.cend();
+                ++keyIter)
+        {
+            if (!sectionIter->second.count(keyIter->first)) return false;
+        }
+    }
+
+    return true;
+}
+
+static std::string
+trim(const std::string& str)
+{
+    static cstring s_whitespace = " \t\r\n";
+
+    const size_t first = str.find_first_not_of(s_whitespace);
+    if (first == std::string::npos) return std::string();
+
+    const size_t last = str.find_last_not_of(s_whitespace);
+    return str.substr(first, last - first + 1);
+}
+
+static const std::string*
+findValue(cstring section,
+          cstring varname)
+{
+    const stringID sectionID = hashString(section);
+    const stringID varID     = hashString(varname);
+
+    for (auto citer = i_configFiles.cbegin();
+              citer != i_configFiles.cend();
+            ++citer)
+    {
+        auto sectionIter = citer->cf_sections.find(sectionID);
+        if (sectionIter == citer->cf_sections.cend()) continue;
+
+        auto valueIter = sectionIter->second.find(varID);
+        if (valueIter != sectionIter->second.cend()) return &valueIter->second;
+    }
+
+    return nullptr;
+}
+
 static bool
 getBoolBuffer(cstring buffer)
 {
@@ -138,4 +381,4 @@ float
 getBufferFloat(cstring charBuffer)
 {
     return (float) atof(charBuffer);
-}
\ No newline at end of file
+}
@@ -4,18 +4,76 @@
    File name:        configparser.h
    
    File description: A class containing helper
-   methods for parsing config files
+   methods for parsing config files.
+
+   Config files are parsed once into an in memory
+   table of sections and keys (hashed by their
+   string IDs), so lookups never touch the disk.
+   Any number of files can be loaded at once, and
+   a section is looked up across all of them.
+   Files changed on disk are reloaded by
+   reloadChangedFiles, which lets tuning values be
+   edited while the game runs.
    ----------------------------------------------- */
 
 #pragma once
 
 #include "../util/strings.h"
+#include "../dotmdef.h"
 
 namespace config
 {
+    // Loads config/<configName>.ini, unless already loaded.
+    // Returns false if the file is missing or unreadable, in
+    // which case the caller decides how to report it
     bool
     initConfigFile(cstring configName);
 
+    // <summary>
+    // <para>
+    // Reloads the loaded files whose modification time or size
+    // changed. A reload missing any section or key of the values
+    // in use (e.g. a file caught mid save) is rejected and retried
+    // on the next check. Cheap enough to call every frame, as the
+    // files are only checked a couple of times per second. Returns
+    // true if any file was reloaded.
+    // </para>
+    // </summary>
+    bool
+    reloadChangedFiles();
+
+    // Incremented whenever a file is (re)loaded, so that values
+    // read once can be read again only when they may have changed
+    uint32
+    getRevision();
+
+    bool
+    hasValue(cstring section,
+             cstring varname);
+
+    // Typed lookups, returning the default if the key is missing
+    bool
+    getBool(cstring    section,
+            cstring    varname,
+            const bool defaultValue);
+
+    uint32
+    getUint(cstring      section,
+            cstring      varname,
+            const uint32 defaultValue);
+
+    real32
+    getFloat(cstring      section,
+             cstring      varname,
+             const real32 defaultValue);
+
+    stringID
+    getString(cstring section,
+              cstring varname,
+              cstring defaultValue);
+
+    // The extract functions write the value of an empty key
+    // (false, 0 or the empty string) for missing keys
     void
     extractConfigString(cstring   section,
                         cstring   varname,
@@ -36,6 +94,3 @@ namespace config
                        cstring varname,
                        float*  outFloat);
 }
-
-
-
@@ -13,9 +13,17 @@
 #endif
 
 #include "window.h"
+#include "config/configparser.h"
 #include "states/gsqueue.h"
 #include "rendering/renderer.h"
+#include "rendering/meshcooker.h"
+#include "rendering/meshstreamer.h"
 #include "handlers/inputhandler.h"
+#include "util/assetpack.h"
+#include "util/jobsystem.h"
+#include "util/memtracker.h"
+#include "util/profiler.h"
+#include <string>
 
 /* -------
    Globals
@@ -31,6 +39,11 @@ messageHandler(HWND   windowHandle,
 			   WPARAM wparam,
 			   LPARAM lparam);			   
 
+static bool
+getCmdLineValue(cstring      cmdLine,
+                cstring      option,
+                std::string& outValue);
+
 /* ----------------
    Main Entry Point
    ---------------- */
@@ -40,6 +53,21 @@ WinMain(HINSTANCE hInstance,
 		LPSTR     lpCmdLine,
 		int       nCmdShow)
 {
+    // Offline mesh cooking mode, no window or device required
+    if (lpCmdLine && strstr(lpCmdLine, "-cookmeshes"))
+    {
+        meshcooker::CookReport report;
+        const bool cooked = meshcooker::cookAll(report);
+        meshcooker::writeReport("meshcook_report.txt", report);
+
+        MessageBox(NULL,
+                   cooked ? "Meshes cooked, see meshcook_report.txt" :
+                            "Some meshes failed to cook, see meshcook_report.txt",
+                   "Mesh Cooker",
+                   cooked ? MB_ICONINFORMATION : MB_ICONEXCLAMATION);
+        return cooked ? 0 : 1;
+    }
+
 	Window window("winconfig",
 				  hInstance,
 				  messageHandler);
@@ -48,9 +76,28 @@ WinMain(HINSTANCE hInstance,
     if (!window.isReady()) return 1;
     g_window = &window;
 
-    // Initialize Singletons
+    memtracker::loadBudgets();
+
+    // Initialize Singletons. The job system comes first so that it
+    // outlives the singletons queueing work on it, and the asset pack
+    // is warmed up while the renderer compiles its shaders
+    JobSystem::get();
+    AssetPack::get()->prefetch();
     Renderer::get();
     InputHandler::get();
+    MeshStreamer::get();
+
+    // Input is recorded (-recordinput <file>) or replayed at full
+    // speed (-replayinput <file>), before any state reads the seed
+    std::string inputRecordingPath;
+    if (getCmdLineValue(lpCmdLine, "-replayinput", inputRecordingPath))
+    {
+        if (!InputHandler::get()->startReplay(inputRecordingPath.c_str())) return 1;
+    }
+    else if (getCmdLineValue(lpCmdLine, "-recordinput", inputRecordingPath))
+    {
+        InputHandler::get()->startRecording(inputRecordingPath.c_str());
+    }
 
     // Initialize Game State Queue
 	GameStateQueue gsq;
@@ -67,6 +114,20 @@ WinMain(HINSTANCE hInstance,
 		}
 		else
 		{
+            profiler::beginFrame();
+            memtracker::beginFrame();
+            if (InputHandler::get()->isReplayFinished()) break;
+            InputHandler::get()->beginFrame();
+            JobSystem::get()->pumpMainThread();
+            if (InputHandler::get()->requiresDeterminism())
+            {
+                MeshStreamer::get()->flushUploads();
+            }
+            else
+            {
+                MeshStreamer::get()->processUploads();
+            }
+            config::reloadChangedFiles();
 			gsq.update();
 			if (gsq.isDone()) break;
             gsq.render();
@@ -74,6 +135,7 @@ WinMain(HINSTANCE hInstance,
 		}
 	}
 
+    InputHandler::get()->stopRecording();
 	return EXIT_SUCCESS;
 }
 
@@ -108,4 +170,26 @@ messageHandler(HWND   windowHandle,
     InputHandler::get()->handleInput(message, wparam, lparam);
 
 	return DefWindowProc(windowHandle, message, wparam, lparam);
+}
+
+static bool
+getCmdLineValue(cstring      cmdLine,
+                cstring      option,
+                std::string& outValue)
+{
+    cstring optionStart = cmdLine ? strstr(cmdLine, option) : nullptr;
+    if (!optionStart) return false;
+
+    cstring valueStart = optionStart + strlen(option);
+    while (*valueStart == ' ') ++valueStart;
+
+    // Quoted values may contain spaces, e.g. -recordinput "my runs/a.drec"
+    const char terminator = *valueStart == '"' ? '"' : ' ';
+    if (terminator == '"') ++valueStart;
+
+    cstring valueEnd = valueStart;
+    while (*valueEnd && *valueEnd != terminator) ++valueEnd;
+
+    outValue.assign(valueStart, valueEnd);
+    return !outValue.empty();
 }
\ No newline at end of file
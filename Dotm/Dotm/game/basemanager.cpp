@@ -23,6 +23,13 @@ const real32 BaseManager::BM_HI_HIGHLIGHT_VAL = 1.0f;
 const real32 BaseManager::BM_LO_HIGHLIGHT_VAL = 0.7f;
 const real32 BaseManager::BM_HIGHLIGHT_INC_VAL = 0.006f;
 
+/* -------------
+   Internal Vars
+   ------------- */
+static constexpr HashedString s_turretName("turret01");
+static constexpr HashedString s_turretTopName("turret01_top");
+static constexpr HashedString s_turretBaseName("turret01_base");
+
 /* --------------
    Public Methods
    -------------- */
@@ -121,7 +128,9 @@ BaseManager::update()
                     nullptr,
                     nullptr))
                 {
-                    new ETurret("turret01",
+                    new ETurret(s_turretName,
+                        s_turretTopName,
+                        s_turretBaseName,
                         m_cameraRef,
                         m_tilemapRef,
                         m_sceneRef,
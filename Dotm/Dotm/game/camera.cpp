@@ -45,25 +45,11 @@ Camera::Camera():
     m_right(CAM_DEFAULT_RIGHT),
     m_pitch(0.0f),
     m_yaw(0.0f),
-    m_roll(0.0f)
+    m_roll(0.0f),
+    m_configRevision(0U)
 {
-    float horDragSpace, verDragSpace;
     config::initConfigFile("camconfig");
-    config::extractConfigFloat("camconfig", "fov", &m_fov);
-    config::extractConfigFloat("camconfig", "hor_drag_area_perc", &horDragSpace);
-    config::extractConfigFloat("camconfig", "ver_drag_area_perc", &verDragSpace);
-    config::extractConfigFloat("camconfig", "x_drag_speed", &m_xDragSpeed);
-    config::extractConfigFloat("camconfig", "y_drag_speed", &m_yDragSpeed);
-    config::extractConfigFloat("camconfig", "min_zoom", &m_minZoom);
-    config::extractConfigFloat("camconfig", "max_zoom", &m_maxZoom);
-    config::extractConfigFloat("camconfig", "zoom_speed", &m_zoomSpeed);
-    config::extractConfigFloat("camconfig", "move_speed", &m_moveSpeed);
-    config::extractConfigFloat("camconfig", "look_speed", &m_lookSpeed);    
-
-    m_leftDragArea   = g_window->getWidth() / horDragSpace;
-    m_rightDragArea  = (real32) (g_window->getWidth() - m_leftDragArea);
-    m_topDragArea    = g_window->getHeight() / verDragSpace;
-    m_bottomDragArea = (real32) (g_window->getHeight() - m_topDragArea);
+    loadConfig();
 }
 
 Camera::~Camera()
@@ -74,6 +60,8 @@ Camera::~Camera()
 void
 Camera::update()
 {    
+    if (config::getRevision() != m_configRevision) loadConfig();
+
     // Manual Zoom
     int32 wheelDelta = InputHandler::get()->getWheelDelta();
         
@@ -328,6 +316,32 @@ Camera::getPosition() logical_const
     return m_position;
 }
 
+/* -----------------
+   Protected Methods
+   ----------------- */
+void
+Camera::loadConfig()
+{
+    m_configRevision = config::getRevision();
+
+    float horDragSpace, verDragSpace;
+    config::extractConfigFloat("camconfig", "fov", &m_fov);
+    config::extractConfigFloat("camconfig", "hor_drag_area_perc", &horDragSpace);
+    config::extractConfigFloat("camconfig", "ver_drag_area_perc", &verDragSpace);
+    config::extractConfigFloat("camconfig", "x_drag_speed", &m_xDragSpeed);
+    config::extractConfigFloat("camconfig", "y_drag_speed", &m_yDragSpeed);
+    config::extractConfigFloat("camconfig", "min_zoom", &m_minZoom);
+    config::extractConfigFloat("camconfig", "max_zoom", &m_maxZoom);
+    config::extractConfigFloat("camconfig", "zoom_speed", &m_zoomSpeed);
+    config::extractConfigFloat("camconfig", "move_speed", &m_moveSpeed);
+    config::extractConfigFloat("camconfig", "look_speed", &m_lookSpeed);    
+
+    m_leftDragArea   = g_window->getWidth() / horDragSpace;
+    m_rightDragArea  = (real32) (g_window->getWidth() - m_leftDragArea);
+    m_topDragArea    = g_window->getHeight() / verDragSpace;
+    m_bottomDragArea = (real32) (g_window->getHeight() - m_topDragArea);
+}
+
 /* ==========================
    Class: WorldViewCamera
    ========================== */
@@ -61,6 +61,13 @@ protected:
     static const real32 CAM_ZNEAR;
     static const real32 CAM_ZFAR;       
 
+protected:
+
+    // Reads the tuning values, again whenever a config file
+    // has been reloaded since the last read
+    void
+    loadConfig();
+
 protected:
     
     vec3f  m_position;
@@ -86,6 +93,8 @@ protected:
     real32 m_moveSpeed;
     real32 m_lookSpeed;
 
+    uint32 m_configRevision;
+
 };
 
 /* ==========================
@@ -8,7 +8,9 @@
    ------------------------------------------------- */
 
 #include "command.h"
+#include "eturret.h"
 #include "../util/math.h"
+#include "../util/memtracker.h"
 
 /* ==============
    Class: Command
@@ -24,6 +26,18 @@ Command::~Command()
 {
 }
 
+void*
+Command::operator new(size_t size)
+{
+    return memtracker::allocateTagged(size, memtracker::MEM_TAG_COMMANDS);
+}
+
+void
+Command::operator delete(void* ptr)
+{
+    ::operator delete(ptr);
+}
+
 
 /* ==================
    Class: MoveCommand
@@ -69,4 +83,27 @@ DamageCommand::execute()
 {
     m_entity->damage(m_damage);
     delete this;
-}
\ No newline at end of file
+}
+
+/* ===================
+   Class: ShootCommand
+   =================== */
+ShootCommand::ShootCommand(const vec3f& targetPos,
+                           ETurret*     turret):
+
+                           Command(turret),
+                           m_targetPos(targetPos)
+{
+}
+
+ShootCommand::~ShootCommand()
+{
+
+}
+
+void
+ShootCommand::execute()
+{
+    static_cast<ETurret*>(m_entity)->shoot(m_targetPos);
+    delete this;
+}
@@ -29,6 +29,14 @@ public:
     virtual
     ~Command() = 0;
 
+    // Commands, including derived ones, are accounted under the
+    // commands memory tag, to show the churn of short lived ones
+    static void*
+    operator new(size_t size);
+
+    static void
+    operator delete(void* ptr);
+
     virtual void
     execute() = 0;
 
@@ -79,3 +87,25 @@ private:
     int32 m_damage;
 
 };
+
+/* ===================
+   Class: ShootCommand
+   =================== */
+class ETurret;
+class ShootCommand: public Command
+{
+public:
+
+    ShootCommand(const vec3f& targetPos,
+                 ETurret*     turret);
+
+    ~ShootCommand();
+
+    void
+    execute() override;
+
+private:
+
+    vec3f m_targetPos;
+
+};
@@ -12,6 +12,7 @@
 #include "command.h"
 #include "tilemap.h"
 #include "healthbar.h"
+#include "../handlers/inputhandler.h"
 
 /* --------------
    Public Methods
@@ -39,15 +40,18 @@ EAIMinion::EAIMinion(const cstring               name,
                      m_velocity(optVelocity)                   
 {
     m_stamina   = 4;
-    m_healthbar = new Healthbar("minion_healthbar",                                 
-                                m_bodies[0]->position, 
-                                m_stamina);    
+    m_healthbars = scene->getHealthbars("minion_healthbar");
+    m_healthbar  = m_healthbars->add(m_bodies[0]->position, 
+                                     m_stamina);    
 
     m_enemy = true;
 }
 
 EAIMinion::~EAIMinion()
 {
+    // In flight path searches still reference this minion
+    JobSystem::get()->waitFor(&m_pathJobs);
+
     for (auto iter = m_path.begin();
         iter != m_path.end();
         ++iter)
@@ -55,7 +59,7 @@ EAIMinion::~EAIMinion()
         delete *iter;
     }
 
-    if (m_healthbar) delete m_healthbar;
+    m_healthbars->remove(m_healthbar);
 
     Tile* currTile = m_levelTMref->getTile(m_bodies[0]->position);      
 }
@@ -65,6 +69,10 @@ EAIMinion::update()
 {
     //m_bodies[0]->rotation.y += 0.01f;
 
+    // Path searches running on the job system update the
+    // path and the target, so movement happens under the lock
+    std::unique_lock<std::mutex> pathLock(m_pathMutex);
+
     // Movement
     if (m_hasTarget)
     {
@@ -85,8 +93,6 @@ EAIMinion::update()
         // have reached the goal and have returned 1 on lerp. And hence nBodies * 3 (x, y, z)
         if (goalAccum == nBodies * 3)
         {
-            // Atomic path update
-            m_pathMutex.lock();
             if (m_path.size() > 0)
             {
                 m_path.front()->execute();
@@ -97,27 +103,22 @@ EAIMinion::update()
                 m_goalPosition = m_bodies[0]->position;
                 m_hasTarget = false;
             }
-            m_pathMutex.unlock();
         }
     }
+    pathLock.unlock();
 
-    m_healthbar->update(m_bodies[0]->position);
+    m_healthbars->setPosition(m_healthbar, m_bodies[0]->position);
     Entity::update();
 }
 
-void
-EAIMinion::renderInternalComponents()
-{
-    m_healthbar->render();
-}
-
 void
 EAIMinion::damage(const int32 damage)
 {
     m_stamina -= damage;
-    m_healthbar->setHitpoints(m_stamina);
+    m_healthbars->setHitpoints(m_healthbar, m_stamina);
 
-    if(!m_stamina)
+    // Several deferred hits may land within the same tick
+    if(m_stamina <= 0)
     {
         m_alive = false;
     }
@@ -127,11 +128,20 @@ void
 EAIMinion::findPathTo(const vec3f&   target,                      
                       const bool     erasePrevious)
 {      
-    m_pathThread = std::thread([=]()
+    // Sample the start position and the solid tiles now, the
+    // body keeps moving and turrets may come and go while the
+    // search runs
+    const vec3f startPos = m_bodies[0]->position;
+
+    pathfinding::SolidityGrid solidity = {};
+    pathfinding::snapshotSolidity(m_levelTMref, solidity);
+
+    auto searchPath = [=]()
     {
         std::list<Command*> newInstructions;
         pathfinding::findPath(m_levelTMref,
-                              m_levelTMref->getTile(m_bodies[0]->position),
+                              solidity,
+                              m_levelTMref->getTile(startPos),
                               m_levelTMref->getTile(target), 
                               this,
                               &newInstructions);
@@ -177,12 +187,27 @@ EAIMinion::findPathTo(const vec3f&   target,
             m_path.pop_front();
         }
         m_pathMutex.unlock();        
-    });
-    m_pathThread.detach();
+    };
+
+    // Jobs finish on a timing dependent frame, which recordings
+    // cannot reproduce
+    if (InputHandler::get()->requiresDeterminism())
+    {
+        searchPath();
+    }
+    else
+    {
+        JobSystem::get()->run(searchPath, &m_pathJobs);
+    }
 }
 
 void
 EAIMinion::recalculatePath()
 {    
-    findPathTo(m_goalPosition, true);
+    vec3f goalPosition;
+    {
+        std::lock_guard<std::mutex> pathLock(m_pathMutex);
+        goalPosition = m_goalPosition;
+    }
+    findPathTo(goalPosition, true);
 }
\ No newline at end of file
@@ -9,10 +9,10 @@
 
 #pragma once
 #include "entity.h"
-#include <thread>
+#include "../util/jobsystem.h"
 #include <mutex>
 
-class Healthbar;
+class HealthbarSystem;
 class EAIMinion: public Entity
 {
 
@@ -34,9 +34,6 @@ public:
     virtual void
     update() override;
 
-    virtual void
-    renderInternalComponents() override;
-
     virtual void
     damage(const int32 damage) override;
 
@@ -49,9 +46,10 @@ public:
 
 private:
 
-    Healthbar*          m_healthbar;
+    HealthbarSystem*    m_healthbars;
+    uint32              m_healthbar;
     std::list<Command*> m_path;
-    std::thread         m_pathThread;
+    JobCounter          m_pathJobs;
     std::mutex          m_pathMutex;
     vec3f               m_velocity;
     vec3f               m_goalPosition;
@@ -11,8 +11,10 @@
 #include "scene.h"
 #include "camera.h"
 #include "tilemap.h"
+#include "../rendering/meshstreamer.h"
 #include "../util/physics.h"
-#include <thread>
+#include "../util/jobsystem.h"
+#include "../util/memtracker.h"
 
 #define SYNC_INIT
 
@@ -26,10 +28,22 @@ Entity::bufferModel(const std::vector<cstring>& meshNames)
               citer != meshNames.cend();
             ++citer)
     {
-        Mesh m(*citer, Mesh::MESH_TYPE_NORMAL);
+        MeshStreamer::get()->requestAsync(*citer);
     }
 }
 
+void*
+Entity::operator new(size_t size)
+{
+    return memtracker::allocateTagged(size, memtracker::MEM_TAG_ENTITIES);
+}
+
+void
+Entity::operator delete(void* ptr)
+{
+    ::operator delete(ptr);
+}
+
 /* --------------
    Public Methods
    -------------- */
@@ -55,21 +69,32 @@ Entity::Entity(const cstring               name,
                m_invisible(false)         
                
 {    
-    size_t nMeshes = meshNames.size();
-
-    if(nMeshes < 2)
-    {
-        // Synchronous body initialization
-        singleBodyInit(meshNames[0], optPosition, optExternTexName);
-    }
-    else
-    {
-        // Asynchronous body initialization
-        multiBodyInit(meshNames, nMeshes, optPosition, optExternTexName);
-    }
+    std::vector<HashedString> hashedNames(meshNames.cbegin(), meshNames.cend());
+    bodyInit(&hashedNames[0], hashedNames.size(), optPosition, optExternTexName);
+}
 
-    // Add self to scene
-    m_sceneRef->queueAddEntity(this);
+Entity::Entity(const HashedString&                 name,
+               std::initializer_list<HashedString> meshNames,
+               const Camera*                       camera,
+               const Tilemap*                      levelTilemap,
+               Scene*                              scene,
+               const uint32                        entityProperties,
+               const vec3f&                        optPosition,     /* vec3f() */
+               const cstring                       optExternTexName /* nullptr*/):
+
+               m_name(name.hs_id),
+               m_properties(entityProperties),
+               m_cameraRef(camera),
+               m_levelTMref(levelTilemap),
+               m_sceneRef(scene),
+               m_targetPos(vec3f()),
+               m_hasTarget(false),
+               m_alive(true),
+               m_enemy(false),
+               m_turret(false),
+               m_invisible(false)
+{
+    bodyInit(meshNames.begin(), meshNames.size(), optPosition, optExternTexName);
 }
 
 Entity::~Entity()
@@ -91,11 +116,6 @@ Entity::update()
     }
 }
 
-void
-Entity::renderInternalComponents()
-{
-}
-
 void
 Entity::damage(const int32 damage)
 {
@@ -198,9 +218,32 @@ Entity::setTargetPos(const vec3f& targetPos)
    Private Methods
    --------------- */
 void
-Entity::singleBodyInit(const cstring meshName,
-                       const vec3f&  optPosition,
-                       const cstring optExternTexName)
+Entity::bodyInit(const HashedString* meshNames,
+                 const size_t        nMeshes,
+                 const vec3f&        optPosition,
+                 const cstring       optExternTexName)
+{
+    MEM_TAG_SCOPE(memtracker::MEM_TAG_ENTITIES);
+
+    if(nMeshes < 2)
+    {
+        // Synchronous body initialization
+        singleBodyInit(meshNames[0], optPosition, optExternTexName);
+    }
+    else
+    {
+        // Asynchronous body initialization
+        multiBodyInit(meshNames, nMeshes, optPosition, optExternTexName);
+    }
+
+    // Add self to scene
+    m_sceneRef->queueAddEntity(this);
+}
+
+void
+Entity::singleBodyInit(const HashedString& meshName,
+                       const vec3f&        optPosition,
+                       const cstring       optExternTexName)
 {
     uint32 meshFlags = Mesh::MESH_TYPE_NORMAL;
     if (!optExternTexName) meshFlags |= Mesh::MESH_LOAD_SAME_TEXTURE;
@@ -213,14 +256,14 @@ Entity::singleBodyInit(const cstring meshName,
 }
 
 void
-Entity::multiBodyInit(const std::vector<cstring>& meshNames, 
-                      const size_t nMeshes,
-                      const vec3f& optPosition,
-                      const cstring optExternTexName)
+Entity::multiBodyInit(const HashedString* meshNames,
+                      const size_t        nMeshes,
+                      const vec3f&        optPosition,
+                      const cstring       optExternTexName)
 {   
 
 #ifndef SYNC_INIT
-    std::vector<std::thread> initThreads;
+    JobCounter initJobs;
 #endif
 
     Mesh** tempMeshArray = new Mesh*[nMeshes];
@@ -232,33 +275,40 @@ Entity::multiBodyInit(const std::vector<cstring>& meshNames,
     {
 
 #ifndef SYNC_INIT
-        initThreads.push_back(std::thread([=]()
+        JobSystem::get()->run([=, &initJobs]()
         {
-#endif
-            uint32 meshFlags = Mesh::MESH_TYPE_NORMAL;
-            if (!optExternTexName) meshFlags |= Mesh::MESH_LOAD_SAME_TEXTURE;
+            // Textures go through the immediate context and so
+            // are loaded separately on the main thread
+            Mesh* body = new Mesh(meshNames[i], Mesh::MESH_TYPE_NORMAL);
+            body->position = optPosition;
+            tempMeshArray[i] = body;
 
-            Mesh* body = new Mesh(meshNames[i], meshFlags);
+            cstring texName = optExternTexName ? optExternTexName : meshNames[i].hs_str;
+            JobSystem::get()->runOnMainThread([=]()
+            {
+                body->loadNewTexture(texName);
+            }, &initJobs);
 
-            if (optExternTexName)  body->loadNewTexture(optExternTexName);
-            body->position = optPosition;
+        }, &initJobs);
+#else
+        uint32 meshFlags = Mesh::MESH_TYPE_NORMAL;
+        if (!optExternTexName) meshFlags |= Mesh::MESH_LOAD_SAME_TEXTURE;
 
-            tempMeshArray[i] = body;
+        Mesh* body = new Mesh(meshNames[i], meshFlags);
 
-#ifndef SYNC_INIT
-        }));
+        if (optExternTexName)  body->loadNewTexture(optExternTexName);
+        body->position = optPosition;
+
+        tempMeshArray[i] = body;
 #endif
     }   
 
 #ifndef SYNC_INIT
-    for (auto iter = initThreads.begin();
-              iter != initThreads.end();
-            ++iter)
-    {
-        iter->join();
-    }
+    // The main thread serves the texture jobs while waiting
+    JobSystem::get()->waitFor(&initJobs);
 #endif
+
     // Assign to final body vector
     m_bodies.assign(tempMeshArray, tempMeshArray + nMeshes);
-    delete tempMeshArray;
+    delete[] tempMeshArray;
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "../util/strings.h"
 #include "../rendering/mesh.h"
 #include "../util/math.h"
+#include <initializer_list>
 #include <vector>
 #include <list>
 #include <unordered_map>
@@ -39,6 +40,14 @@ public:
     static void
     bufferModel(const std::vector<cstring>& meshNames);
 
+    // Entities, including derived ones, are accounted under
+    // the entities memory tag
+    static void*
+    operator new(size_t size);
+
+    static void
+    operator delete(void* ptr);
+
 public:
 
     Entity(const cstring               name,
@@ -50,15 +59,29 @@ public:
            const vec3f&                optPosition = vec3f(),
            const cstring               optExternTexName = nullptr);
 
+    // <summary>
+    // <para>
+    // For entities spawned often (e.g. projectiles), with names
+    // hashed at compile time. Spawning one whose meshes are cached
+    // does no string hashing or allocation. The name is not
+    // interned, so only its ID is available.
+    // </para>
+    // </summary>
+    Entity(const HashedString&                 name,
+           std::initializer_list<HashedString> meshNames,
+           const Camera*                       camera,
+           const Tilemap*                      levelTilemap,
+           Scene*                              scene,
+           const uint32                        entityProperties,
+           const vec3f&                        optPosition = vec3f(),
+           const cstring                       optExternTexName = nullptr);
+
     virtual
     ~Entity();
 
     virtual void
     update();
 
-    virtual void
-    renderInternalComponents();
-
     virtual void
     damage(const int32 damage);
 
@@ -105,15 +128,21 @@ public:
 private:
 
     void
-    singleBodyInit(const cstring meshName,
-                   const vec3f&  optPosition,
-                   const cstring optExternTexName);
+    bodyInit(const HashedString* meshNames,
+             const size_t        nMeshes,
+             const vec3f&        optPosition,
+             const cstring       optExternTexName);
+
+    void
+    singleBodyInit(const HashedString& meshName,
+                   const vec3f&        optPosition,
+                   const cstring       optExternTexName);
 
     void
-    multiBodyInit(const std::vector<cstring>& meshNames,
-                  const size_t nMeshes,
-                  const vec3f& optPosition,
-                  const cstring optExternTexName);
+    multiBodyInit(const HashedString* meshNames,
+                  const size_t        nMeshes,
+                  const vec3f&        optPosition,
+                  const cstring       optExternTexName);
 
 protected:
 
@@ -22,13 +22,13 @@ extern vec2f g_zLevelBounds;
 /* --------------
    Public Methods
    -------------- */
-EProjectile::EProjectile(const cstring  name,            
-                         const Camera*  camera,
-                         const Tilemap* levelTilemap,
-                         Scene*         scene,
-                         const vec3f&   position,                         
-                         const vec3f&   targPos,
-                         const real32   initRot):
+EProjectile::EProjectile(const HashedString& name,
+                         const Camera*       camera,
+                         const Tilemap*      levelTilemap,
+                         Scene*              scene,
+                         const vec3f&        position,
+                         const vec3f&        targPos,
+                         const real32        initRot):
 
                          Entity(name,
                                 {name},
@@ -69,6 +69,7 @@ EProjectile::update()
     // Damage Check
     Tile* currTile = m_tileRefs[m_sceneRef->getInternalTilemap()];
     std::vector<Entity*> nearbyEntities = currTile->t_entities;
+    const math::Sphere   bodySphere     = m_bodies[0]->getCollidableGeometry();
 
     for (auto iter = nearbyEntities.begin();
               iter != nearbyEntities.end();
@@ -78,15 +79,16 @@ EProjectile::update()
             !(*iter)->isEnemy() ||
             !(*iter)->isAlive()) continue;
 
+        const math::Sphere enemySphere = (*iter)->getBody()->getCollidableGeometry();
         if (physics::intersectionTest(physics::PHYSICS_INTERSECTION_TYPE_SPHERESPHERE,
-                                      &m_bodies[0]->getCollidableGeometry(),
-                                      &(*iter)->getBody()->getCollidableGeometry()))
+                                      &bodySphere,
+                                      &enemySphere))
         {
             DamageCommand* selfDamage = new DamageCommand(1, this);
-            DamageCommand* enemDamage = new DamageCommand(1, *iter);
-
             selfDamage->execute();
-            enemDamage->execute();
+
+            // The enemy is not ours to modify during the parallel update
+            m_sceneRef->deferCommand(new DamageCommand(1, *iter));
 
             break;
         }
@@ -16,13 +16,14 @@ class EProjectile: public Entity
 {    
 public:
        
-    EProjectile(const cstring  name,            
-                const Camera*  camera,
-                const Tilemap* levelTilemap,
-                Scene*         scene,
-                const vec3f&   position,                
-                const vec3f&   targPos,
-                const real32   initRot);
+    // The name is also the projectile's mesh
+    EProjectile(const HashedString& name,
+                const Camera*       camera,
+                const Tilemap*      levelTilemap,
+                Scene*              scene,
+                const vec3f&        position,
+                const vec3f&        targPos,
+                const real32        initRot);
 
     ~EProjectile();
 
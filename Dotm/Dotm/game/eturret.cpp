@@ -12,8 +12,8 @@
 #include "eprojectile.h"
 #include "scene.h"
 #include "tilemap.h"
+#include "command.h"
 #include "../util/physics.h"
-#include "../util/stringutils.h"
 #include "../util/logging.h"
 
 #ifdef _DEBUG
@@ -25,21 +25,27 @@
    --------------- */
 const real32 ETurret::ETURRET_INIT_ROT = 0.0f;
 
+/* -------------
+   Internal Vars
+   ------------- */
+static constexpr HashedString s_projectileName("bullet01");
+
 /* --------------
    Public Methods
    -------------- */
-ETurret::ETurret(const cstring  name,                 
-                 const Camera*  camera,
-                 const Tilemap* levelTilemap,
-                 Scene*         scene,
-                 const vec3f&   position,
-                 const real32   rotVel,
-                 const real32   range,
-                 const uint32   reloadFrames):
+ETurret::ETurret(const HashedString& name,
+                 const HashedString& topMeshName,
+                 const HashedString& baseMeshName,
+                 const Camera*       camera,
+                 const Tilemap*      levelTilemap,
+                 Scene*              scene,
+                 const vec3f&        position,
+                 const real32        rotVel,
+                 const real32        range,
+                 const uint32        reloadFrames):
 
                  Entity(name,
-                        { string_utils::strcat(name, "_top").c_str(),
-                          string_utils::strcat(name, "_base").c_str() },
+                        { topMeshName, baseMeshName },
                         camera, 
                         levelTilemap,
                         scene,
@@ -123,13 +129,10 @@ ETurret::update()
             {
                 m_reloadCounter = m_reloadFrames;
 
-                EProjectile* projectile = new EProjectile("bullet01",
-                                                           m_cameraRef,
-                                                           m_levelTMref,
-                                                           m_sceneRef,
-                                                           m_bodies[0]->position,
-                                                           m_targetEnemy->getBody()->position,
-                                                           m_bodies[0]->rotation.y);
+                // Spawning touches the scene so it is deferred
+                // until the serial phase of the scene update
+                m_sceneRef->deferCommand(new ShootCommand(m_targetEnemy->getBody()->position,
+                                                          this));
             }
         }break;
     }   
@@ -158,6 +161,18 @@ ETurret::renderDebug()
 #endif
 }
 
+void
+ETurret::shoot(const vec3f& targetPos)
+{
+    new EProjectile(s_projectileName,
+                    m_cameraRef,
+                    m_levelTMref,
+                    m_sceneRef,
+                    m_bodies[0]->position,
+                    targetPos,
+                    m_bodies[0]->rotation.y);
+}
+
 /* ---------------
    Private Methods
    --------------- */
@@ -16,14 +16,18 @@ class ETurret: public Entity
 {
 public:
 
-    ETurret(const cstring  name,            
-            const Camera*  camera,
-            const Tilemap* levelTilemap,
-            Scene*         scene,
-            const vec3f&   position,
-            const real32   rotvel,
-            const real32   range,
-            const uint32   reloadFrames);
+    // The turret is built from a top and a base mesh, named
+    // by convention name + "_top" and name + "_base"
+    ETurret(const HashedString& name,
+            const HashedString& topMeshName,
+            const HashedString& baseMeshName,
+            const Camera*       camera,
+            const Tilemap*      levelTilemap,
+            Scene*              scene,
+            const vec3f&        position,
+            const real32        rotvel,
+            const real32        range,
+            const uint32        reloadFrames);
 
     ~ETurret();
 
@@ -39,6 +43,9 @@ public:
     void
     renderDebug();
 
+    void
+    shoot(const vec3f& targetPos);
+
 private:
 
     bool
@@ -4,116 +4,240 @@
    File name:        healthbar.cpp
 
    File description: Implementation of the
-   Healthbar class declared in healthbar.h
+   HealthbarSystem class declared in healthbar.h
    --------------------------------------------- */
 
 #include "healthbar.h"
 #include "../rendering/mesh.h"
+#include "../rendering/renderer.h"
 #include "../util/stringutils.h"
 #include "../util/logging.h"
 
 /* ---------------
    Class Constants
    --------------- */
-const real32 Healthbar::HEALTHBAR_INIT_SCALE_X = 4.0f;
-const real32 Healthbar::HEALTHBAR_LERP_SPEED   = 0.05f;
-const real32 Healthbar::HEALTHBAR_VER_PADDING  = 3.0f;
+const real32 HealthbarSystem::HEALTHBAR_INIT_SCALE_X = 4.0f;
+const real32 HealthbarSystem::HEALTHBAR_LERP_SPEED   = 0.05f;
+const real32 HealthbarSystem::HEALTHBAR_VER_PADDING  = 3.0f;
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static void
+composeWorldMatrix(const real32  scaleX,
+                   const real32  scaleY,
+                   const real32  scaleZ,
+                   const mat4x4& rotationMatrix,
+                   const real32  x,
+                   const real32  y,
+                   const real32  z,
+                   mat4x4&       outWorldMatrix);
 
 /* --------------
    Public Methods
    -------------- */
-Healthbar::Healthbar(const cstring healthbarType,                     
-                     const vec3f&  minionPos,
-                     const int32   maxHitpoints):
-                     
-                     m_maxHitpoints(maxHitpoints),
-                     m_curHitpoints(maxHitpoints),
-                     m_targetScale(HEALTHBAR_INIT_SCALE_X),
-                     m_decreaseOffset(0.0f)
+HealthbarSystem::HealthbarSystem(const cstring healthbarType):
+
+    m_typeID(internString(healthbarType)),
+    m_backMesh(new Mesh(string_utils::strcat(healthbarType, "_back").c_str(),
+                        Mesh::MESH_TYPE_BILLBOARD | Mesh::MESH_LOAD_SAME_TEXTURE)),
+    m_frontMesh(new Mesh(string_utils::strcat(healthbarType, "_front").c_str(),
+                         Mesh::MESH_TYPE_BILLBOARD | Mesh::MESH_LOAD_SAME_TEXTURE))
 {
-    m_components.push_back(new Mesh(string_utils::strcat(healthbarType, "_back").c_str(),
-                                    Mesh::MESH_TYPE_BILLBOARD | Mesh::MESH_LOAD_SAME_TEXTURE));
-    m_components.push_back(new Mesh(string_utils::strcat(healthbarType, "_front").c_str(),
-                                    Mesh::MESH_TYPE_BILLBOARD | Mesh::MESH_LOAD_SAME_TEXTURE));
-
-    positionComponents(minionPos);
-    
-    m_components[0]->scale.x = 0.0f;
-    m_components[1]->scale.x = HEALTHBAR_INIT_SCALE_X;    
-
-    m_components[0]->scale.y /= 2.0f;
-    m_components[1]->scale.y /= 2.0f;
+    // Correct rotation to face camera naturally
+    D3DXMatrixRotationX(&m_rotationMatrix, PI_FL / 4);
+
+    m_backMesh->scale.y  /= 2.0f;
+    m_frontMesh->scale.y /= 2.0f;
 }
 
-Healthbar::~Healthbar()
+HealthbarSystem::~HealthbarSystem()
 {
-    for (auto iter = m_components.begin();
-              iter != m_components.end();
-            ++iter)
+    delete m_backMesh;
+    delete m_frontMesh;
+}
+
+HealthbarSystem::Handle
+HealthbarSystem::add(const vec3f& minionPos,
+                     const int32  maxHitpoints)
+{
+    Handle handle = INVALID_HANDLE;
+    if (!m_freeHandles.empty())
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+    }
+    else
     {
-        delete *iter;
+        handle = static_cast<Handle>(m_handleBars.size());
+        m_handleBars.push_back(0U);
     }
 
-    m_components.clear();
+    // Bars start at full health, the lost health bar behind
+    // at 0 scale next to it
+    m_handleBars[handle] = static_cast<uint32>(m_barHandles.size());
+    m_barHandles.push_back(handle);
+    m_positionX.push_back(minionPos.x);
+    m_positionY.push_back(minionPos.y);
+    m_positionZ.push_back(minionPos.z);
+    m_frontScale.push_back(HEALTHBAR_INIT_SCALE_X);
+    m_targetScale.push_back(HEALTHBAR_INIT_SCALE_X);
+    m_decreaseOffset.push_back(0.0f);
+    m_maxHitpoints.push_back(maxHitpoints);
+
+    return handle;
+}
+
+void
+HealthbarSystem::remove(const Handle handle)
+{
+    if (handle >= m_handleBars.size() || m_handleBars[handle] == INVALID_HANDLE) return;
+
+    // The last bar fills the removed one's slot
+    const uint32 bar  = m_handleBars[handle];
+    const uint32 last = static_cast<uint32>(m_barHandles.size()) - 1U;
+    if (bar != last) moveBar(last, bar);
+
+    m_barHandles.pop_back();
+    m_positionX.pop_back();
+    m_positionY.pop_back();
+    m_positionZ.pop_back();
+    m_frontScale.pop_back();
+    m_targetScale.pop_back();
+    m_decreaseOffset.pop_back();
+    m_maxHitpoints.pop_back();
+
+    m_handleBars[handle] = INVALID_HANDLE;
+    m_freeHandles.push_back(handle);
+}
+
+void
+HealthbarSystem::setPosition(const Handle handle,
+                             const vec3f& minionPos)
+{
+    const uint32 bar = m_handleBars[handle];
+    m_positionX[bar] = minionPos.x;
+    m_positionY[bar] = minionPos.y;
+    m_positionZ[bar] = minionPos.z;
+}
+
+void
+HealthbarSystem::setHitpoints(const Handle handle,
+                              const int32  hitpoints)
+{
+    const uint32 bar   = m_handleBars[handle];
+    m_targetScale[bar] = (hitpoints * HEALTHBAR_INIT_SCALE_X) / m_maxHitpoints[bar];
 }
 
 void
-Healthbar::update(const vec3f& minionPos)
-{    
+HealthbarSystem::update()
+{
     // Essentially to produce the effect of the current stamina bar
     // in front and the lost stamina bar behind (black), we start
-    // both objects next to each other with the stamina bar being 
+    // both objects next to each other with the stamina bar being
     // at full scale and the lost stamina bar at 0 scale. Whenever
     // stamina is lost, we decrease the scale of the curr stamina bar
     // and increase the scale of the lost stamina bar.
+    const size_t nBars = m_barHandles.size();
+    m_backInstances.resize(nBars);
+    m_frontInstances.resize(nBars);
 
-    // Save previous scale
-    real32 scale0 = m_components[1]->scale.x;
-
-    // Calculate next scale
-    math::lerpf(m_components[1]->scale.x, m_targetScale, HEALTHBAR_LERP_SPEED);    
-    m_components[0]->scale.x = HEALTHBAR_INIT_SCALE_X - m_components[1]->scale.x;
-
-    // Calculate the offset needed to position the bars correctly
-    m_decreaseOffset += (scale0 - m_components[1]->scale.x) / 2;
-        
-    positionComponents(minionPos);    
+    for (size_t i = 0;
+                i < nBars;
+              ++i)
+    {
+        // Save previous scale and calculate next scale
+        const real32 scale0 = m_frontScale[i];
+        math::lerpf(m_frontScale[i], m_targetScale[i], HEALTHBAR_LERP_SPEED);
+
+        // Calculate the offset needed to position the bars correctly
+        m_decreaseOffset[i] += (scale0 - m_frontScale[i]) / 2;
+
+        // Bars sit above the model, next to each other
+        const real32 x = m_positionX[i] + m_decreaseOffset[i];
+        const real32 y = m_positionY[i] + HEALTHBAR_VER_PADDING;
+        const real32 z = m_positionZ[i];
+
+        composeWorldMatrix(HEALTHBAR_INIT_SCALE_X - m_frontScale[i],
+                           m_backMesh->scale.y,
+                           m_backMesh->scale.z,
+                           m_rotationMatrix,
+                           x - HEALTHBAR_INIT_SCALE_X / 2.0f,
+                           y,
+                           z,
+                           m_backInstances[i].id_worldMatrix);
+        m_backInstances[i].id_highlight = 0;
+
+        composeWorldMatrix(m_frontScale[i],
+                           m_frontMesh->scale.y,
+                           m_frontMesh->scale.z,
+                           m_rotationMatrix,
+                           x,
+                           y,
+                           z,
+                           m_frontInstances[i].id_worldMatrix);
+        m_frontInstances[i].id_highlight = 0;
+    }
 }
 
 void
-Healthbar::render()
+HealthbarSystem::render()
 {
-    Renderer::get()->renderMesh(m_components[0]);
-    Renderer::get()->renderMesh(m_components[1]);
+    Renderer::get()->renderMeshInstances(m_backMesh, m_backInstances);
+    Renderer::get()->renderMeshInstances(m_frontMesh, m_frontInstances);
 }
 
-void
-Healthbar::setHitpoints(const int32 hitpoints)
+stringID
+HealthbarSystem::getTypeID() logical_const
 {
-   
-    m_curHitpoints = hitpoints;
-    m_targetScale  = (hitpoints * HEALTHBAR_INIT_SCALE_X) / m_maxHitpoints;    
+    return m_typeID;
+}
+
+uint32
+HealthbarSystem::getCount() logical_const
+{
+    return static_cast<uint32>(m_barHandles.size());
 }
 
 /* ---------------
    Private Methods
    --------------- */
 void
-Healthbar::positionComponents(const vec3f& minionPos)
+HealthbarSystem::moveBar(const uint32 from,
+                         const uint32 to)
 {
-    // Start by setting the components' position to the minion's position
-    m_components[0]->position = minionPos;
-    m_components[1]->position = minionPos;
-
-    // Move components above model
-    m_components[0]->position.y += HEALTHBAR_VER_PADDING;
-    m_components[1]->position.y += HEALTHBAR_VER_PADDING;
-
-    // Position bars next to each other
-    m_components[0]->position.x += m_decreaseOffset - HEALTHBAR_INIT_SCALE_X / 2.0f;
-    m_components[1]->position.x += m_decreaseOffset;
-    
-    // Correct rotation to face camera naturally
-    m_components[0]->rotation.x = PI_FL / 4;
-    m_components[1]->rotation.x = PI_FL / 4;
-}
\ No newline at end of file
+    m_barHandles[to]     = m_barHandles[from];
+    m_positionX[to]      = m_positionX[from];
+    m_positionY[to]      = m_positionY[from];
+    m_positionZ[to]      = m_positionZ[from];
+    m_frontScale[to]     = m_frontScale[from];
+    m_targetScale[to]    = m_targetScale[from];
+    m_decreaseOffset[to] = m_decreaseOffset[from];
+    m_maxHitpoints[to]   = m_maxHitpoints[from];
+
+    m_handleBars[m_barHandles[to]] = to;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static void
+composeWorldMatrix(const real32  scaleX,
+                   const real32  scaleY,
+                   const real32  scaleZ,
+                   const mat4x4& rotationMatrix,
+                   const real32  x,
+                   const real32  y,
+                   const real32  z,
+                   mat4x4&       outWorldMatrix)
+{
+    // Scale * rotation * translation, with the diagonal scale
+    // applied to the rotation's rows directly
+    outWorldMatrix = rotationMatrix;
+    outWorldMatrix._11 *= scaleX; outWorldMatrix._12 *= scaleX; outWorldMatrix._13 *= scaleX;
+    outWorldMatrix._21 *= scaleY; outWorldMatrix._22 *= scaleY; outWorldMatrix._23 *= scaleY;
+    outWorldMatrix._31 *= scaleZ; outWorldMatrix._32 *= scaleZ; outWorldMatrix._33 *= scaleZ;
+    outWorldMatrix._41  = x;
+    outWorldMatrix._42  = y;
+    outWorldMatrix._43  = z;
+}
@@ -4,48 +4,79 @@
    File name:        healthbar.h
 
    File description: A general purpose healthbar
-   class used to represent all the types of 
-   minion healthbars in game
+   system used to represent all the types of
+   minion healthbars in game. The state of every
+   bar of a type is kept in flat arrays, updated
+   in a single loop and drawn as one instanced
+   billboard draw per bar texture.
    --------------------------------------------- */
 
 #pragma once
 
-#include "../rendering/renderer.h"
+#include "../rendering/instancing.h"
 #include "../util/math.h"
 #include "../dotmdef.h"
 #include "../util/strings.h"
 #include <vector>
 
 class Mesh;
-class Healthbar
+class HealthbarSystem
 {
 public:
 
-    Healthbar(const cstring healthbarType,              
-              const vec3f&  minionPos,
-              const int32   maxHitpoints);
+    typedef uint32 Handle;
 
-    virtual
-    ~Healthbar();
+    static const Handle INVALID_HANDLE = 0xFFFFFFFFU;
 
-    Healthbar(const Healthbar& rhs) = delete;
+public:
+
+    // Loads the two bar meshes shared by all the bars of the
+    // type (healthbarType + "_back" and healthbarType + "_front")
+    HealthbarSystem(const cstring healthbarType);
+
+    ~HealthbarSystem();
+
+    HealthbarSystem(const HealthbarSystem& rhs) = delete;
 
-    Healthbar&
-    operator = (const Healthbar& rhs) = delete;
-    
-    virtual void
-    update(const vec3f& minionPos);
+    HealthbarSystem&
+    operator = (const HealthbarSystem& rhs) = delete;
+
+    Handle
+    add(const vec3f& minionPos,
+        const int32  maxHitpoints);
 
     void
-    render();
+    remove(const Handle handle);
+
+    // Only writes the bar's own slot, so distinct bars may be
+    // moved in parallel (e.g. from the entity update jobs)
+    void
+    setPosition(const Handle handle,
+                const vec3f& minionPos);
 
     void
-    setHitpoints(const int32 hitpoints);
+    setHitpoints(const Handle handle,
+                 const int32  hitpoints);
+
+    // Advances every bar towards its target fraction and
+    // recomputes the instance data of both bar meshes
+    void
+    update();
+
+    void
+    render();
+
+    stringID
+    getTypeID() logical_const;
+
+    uint32
+    getCount() logical_const;
 
 private:
 
     void
-    positionComponents(const vec3f& minionPos);
+    moveBar(const uint32 from,
+            const uint32 to);
 
 private:
 
@@ -55,9 +86,25 @@ private:
 
 private:
 
-    std::vector<Mesh*> m_components;    
-    int32              m_maxHitpoints;
-    int32              m_curHitpoints;
-    real32             m_targetScale;    
-    real32             m_decreaseOffset;
-};
\ No newline at end of file
+    stringID m_typeID;
+    Mesh*    m_backMesh;
+    Mesh*    m_frontMesh;
+    mat4x4   m_rotationMatrix;
+
+    // Bar state, one dense entry per live bar
+    std::vector<real32> m_positionX;
+    std::vector<real32> m_positionY;
+    std::vector<real32> m_positionZ;
+    std::vector<real32> m_frontScale;
+    std::vector<real32> m_targetScale;
+    std::vector<real32> m_decreaseOffset;
+    std::vector<int32>  m_maxHitpoints;
+
+    // Handles stay valid while bars are moved around
+    std::vector<Handle> m_barHandles;
+    std::vector<uint32> m_handleBars;
+    std::vector<Handle> m_freeHandles;
+
+    std::vector<instancing::InstanceData> m_backInstances;
+    std::vector<instancing::InstanceData> m_frontInstances;
+};
@@ -15,6 +15,8 @@
 #include <unordered_map>
 #include <list>
 #include "../util/logging.h"
+#include "../util/profiler.h"
+#include "../util/memtracker.h"
 
 /* ---------
    Constants
@@ -33,20 +35,58 @@ findLowestFScore(std::unordered_set<const Tile*>&         nodeSet,
                  std::unordered_map<const Tile*, uint32>& fScores);
 
 static void
-findNeighbours(const Tile*             node,
-               const Tilemap*          grid,
-               std::list<const Tile*>* outNeighbours);
+findNeighbours(const Tile*                       node,
+               const Tilemap*                    grid,
+               const pathfinding::SolidityGrid&  solidity,
+               std::list<const Tile*>*           outNeighbours);
 
 /* ----------------
    Public Functions
    ---------------- */
+void
+pathfinding::snapshotSolidity(const Tilemap* grid,
+                              SolidityGrid&  outSolidity)
+{
+    outSolidity.sg_cols = grid->getCols();
+    outSolidity.sg_rows = grid->getRows();
+    outSolidity.sg_solid.resize(outSolidity.sg_cols * outSolidity.sg_rows);
+
+    for (size_t y = 0;
+                y < outSolidity.sg_rows;
+              ++y)
+    {
+        for (size_t x = 0;
+                    x < outSolidity.sg_cols;
+                  ++x)
+        {
+            outSolidity.sg_solid[y * outSolidity.sg_cols + x] = grid->getTile(x, y)->isSolid() ? 1U : 0U;
+        }
+    }
+}
+
 bool
 pathfinding::findPath(const Tilemap*         grid, 
                       const Tile*            start,
                       const Tile*            end, 
                       Entity*                entity,
                       std::list<Command*>*   outCommandChain)
-{        
+{
+    SolidityGrid solidity = {};
+    snapshotSolidity(grid, solidity);
+    return findPath(grid, solidity, start, end, entity, outCommandChain);
+}
+
+bool
+pathfinding::findPath(const Tilemap*         grid, 
+                      const SolidityGrid&    solidity,
+                      const Tile*            start,
+                      const Tile*            end, 
+                      Entity*                entity,
+                      std::list<Command*>*   outCommandChain)
+{
+    PROFILE_ZONE("pathfinding::findPath");
+    MEM_TAG_SCOPE(memtracker::MEM_TAG_PATHFINDING);
+
     if (start == end) return true;
 
     std::unordered_set<const Tile*> closedSet;
@@ -95,7 +135,7 @@ pathfinding::findPath(const Tilemap*         grid,
         closedSet.insert(current);
 
         std::list<const Tile*> neighbours;
-        findNeighbours(current, grid, &neighbours);
+        findNeighbours(current, grid, solidity, &neighbours);
 
         for (auto citer = neighbours.cbegin();
                   citer != neighbours.cend();
@@ -142,13 +182,18 @@ findLowestFScore(std::unordered_set<const Tile*>&         nodeSet,
     uint32 minF         = PF_INFINITY;
     const Tile* minNode = nullptr;
 
+    // Ties are broken by tile row and column rather than by the
+    // set's iteration order, which depends on tile addresses
     for (auto citer = nodeSet.cbegin();
               citer != nodeSet.cend();
             ++citer)
     {
-        if (fScores[*citer] < minF)
+        const uint32 f = fScores[*citer];
+        if (f < minF ||
+           (f == minF && minNode && ((*citer)->t_row <  minNode->t_row ||
+                                    ((*citer)->t_row == minNode->t_row && (*citer)->t_col < minNode->t_col))))
         {
-            minF    = fScores[*citer];
+            minF    = f;
             minNode = *citer;
         }
     }
@@ -157,19 +202,24 @@ findLowestFScore(std::unordered_set<const Tile*>&         nodeSet,
 }
 
 static void
-findNeighbours(const Tile*             node,
-               const Tilemap*          grid,
-               std::list<const Tile*>* outNeighbours)
+findNeighbours(const Tile*                       node,
+               const Tilemap*                    grid,
+               const pathfinding::SolidityGrid&  solidity,
+               std::list<const Tile*>*           outNeighbours)
 {
     outNeighbours->clear();
 
-    const Tile* nNeighbour = grid->getTile(node->t_col - 1, node->t_row    );
-    const Tile* sNeighbour = grid->getTile(node->t_col + 1, node->t_row    );
-    const Tile* wNeighbour = grid->getTile(node->t_col    , node->t_row - 1);
-    const Tile* eNeighbour = grid->getTile(node->t_col    , node->t_row + 1);
+    // Tile positions never change, only their flags do, so the
+    // tiles are looked up in the grid and their solidity in the
+    // snapshot
+    const size_t cols[4] = { node->t_col - 1, node->t_col + 1, node->t_col,     node->t_col     };
+    const size_t rows[4] = { node->t_row,     node->t_row,     node->t_row - 1, node->t_row + 1 };
 
-    if (nNeighbour && !nNeighbour->isSolid()) outNeighbours->push_back(nNeighbour);
-    if (sNeighbour && !sNeighbour->isSolid()) outNeighbours->push_back(sNeighbour);
-    if (wNeighbour && !wNeighbour->isSolid()) outNeighbours->push_back(wNeighbour);
-    if (eNeighbour && !eNeighbour->isSolid()) outNeighbours->push_back(eNeighbour);
+    for (size_t i = 0;
+                i < 4;
+              ++i)
+    {
+        const Tile* neighbour = grid->getTile(cols[i], rows[i]);
+        if (neighbour && !solidity.sg_solid[rows[i] * solidity.sg_cols + cols[i]]) outNeighbours->push_back(neighbour);
+    }
 }
\ No newline at end of file
@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include "../dotmdef.h"
 #include <list>
+#include <vector>
 
 struct Tile;
 class  Tilemap;
@@ -17,6 +19,31 @@ class  Command;
 class  Entity;
 namespace pathfinding
 {
+    // The solid flags of a tilemap at one point in time. Searches
+    // running in jobs read these instead of the tiles, which the
+    // main thread keeps changing (turret placement and removal)
+    struct SolidityGrid
+    {
+        size_t             sg_cols;
+        size_t             sg_rows;
+        std::vector<uint8> sg_solid;
+    };
+
+    // Must be called where the tilemap is not being changed,
+    // i.e. on the main thread or during the scene's parallel phase
+    void
+    snapshotSolidity(const Tilemap* grid,
+                     SolidityGrid&  outSolidity);
+
+    bool
+    findPath(const Tilemap*         grid, 
+             const SolidityGrid&    solidity,
+             const Tile*            start,
+             const Tile*            end, 
+             Entity*                entity,
+             std::list<Command*>*   outCommandChain);
+
+    // Searches the current state of the tiles. Main thread only
     bool
     findPath(const Tilemap*         grid, 
              const Tile*            start,
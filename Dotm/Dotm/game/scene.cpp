@@ -12,8 +12,14 @@
 #include "entity.h"
 #include "eaiminion.h"
 #include "tilemap.h"
+#include "command.h"
+#include "healthbar.h"
 #include <algorithm>
+#include <limits>
 #include "../util/logging.h"
+#include "../util/jobsystem.h"
+#include "../util/profiler.h"
+#include "../util/memtracker.h"
 
 #define SPPART
 
@@ -29,6 +35,16 @@ vec2f g_zLevelBounds;
 const real32 Scene::SCENE_CELL_SIZE     = 20.0f;
 const uint32 Scene::SCENE_HOR_NUM_CELLS = 5U;
 const uint32 Scene::SCENE_VER_NUM_CELLS = 5U;
+
+#define SCENE_UPDATE_GRAIN_SIZE 16
+
+/* -------------
+   Internal Vars
+   ------------- */
+
+// Position in m_cachedEntities of the entity currently being
+// updated on this thread. Used to order deferred commands.
+static thread_local size_t s_currentIssuer = std::numeric_limits<size_t>::max();
    
 /* --------------
    Public Methods
@@ -37,7 +53,8 @@ Scene::Scene():
     m_entityGraph(new Tilemap(SCENE_HOR_NUM_CELLS, 
                               SCENE_VER_NUM_CELLS, 
                               SCENE_CELL_SIZE, 
-                              {0.0f, 2.0f, 0.0f}))
+                              {0.0f, 2.0f, 0.0f})),
+    m_deferredCommands(JobSystem::get()->getNumWorkers() + 1U)
 {
     g_xLevelBounds = { -real32(SCENE_HOR_NUM_CELLS / 2.0f) * SCENE_CELL_SIZE,                         
                         ( SCENE_HOR_NUM_CELLS / 2.0f) * SCENE_CELL_SIZE };
@@ -50,53 +67,36 @@ Scene::~Scene()
 {
     clearScene();
     delete m_entityGraph;
+
+    // Destroyed minions have released their bars by now
+    for (auto iter = m_healthbarSystems.begin();
+              iter != m_healthbarSystems.end();
+            ++iter)
+    {
+        delete *iter;
+    }
 }
 
 void
 Scene::update()
 {
-    for (auto iter = m_cachedEntities.begin();
-              iter != m_cachedEntities.end();
-            ++iter)
-    {
-        // Update entity
-        (*iter)->update();                
-
-        if (!(*iter)->isAlive())
-        {            
-            queueKillEntity(*iter);
-            continue;
-        }
+    PROFILE_ZONE("Scene::update");
 
-        Tile* oldTile    = (*iter)->getTileRef(m_entityGraph);
-        Tile* targetTile = m_entityGraph->getTile(
-            m_entityGraph->getCol((*iter)->getBody()->position.x),
-            m_entityGraph->getRow((*iter)->getBody()->position.z));
+    // Parallel phase. Enemies only move themselves, so they go
+    // first. Turrets and projectiles then read the settled enemy
+    // positions while only writing their own state.
+    updateEntities(true);
+    updateEntities(false);
 
-        // Out of bounds or Death check
-        if (!targetTile)
-        {            
-            (*iter)->setAlive(false);
-            queueKillEntity(*iter);            
-            continue;
-        }
+    // Serial phase. Cross entity effects and structural changes
+    applyDeferredCommands();
+    updateTileRefs();
 
-        // Tile update
-        if (targetTile != oldTile)
-        {
-            for (size_t i = 0;
-                        i < oldTile->t_entities.size();
-                      ++i)
-            {
-                if (oldTile->t_entities[i] == (*iter)) 
-                {
-                    oldTile->t_entities.erase(oldTile->t_entities.begin() + i);
-                    break;
-                }
-            }
-            targetTile->t_entities.push_back(*iter);            
-            (*iter)->setTileRef(m_entityGraph, targetTile);
-        }
+    for (auto iter = m_healthbarSystems.begin();
+              iter != m_healthbarSystems.end();
+            ++iter)
+    {
+        (*iter)->update();
     }
 
     bool turretMod = false;
@@ -151,7 +151,25 @@ Scene::clearScene()
         m_waitToKillEntities.pop();
     }
 
-    m_lights.clear();    
+    for (auto iter = m_deferredCommands.begin();
+              iter != m_deferredCommands.end();
+            ++iter)
+    {
+        for (auto citer = iter->cbegin();
+                  citer != iter->cend();
+                ++citer)
+        {
+            delete citer->dc_command;
+        }
+        iter->clear();
+    }
+
+    m_directionalLights.clear();
+    m_directionalHandles.clear();
+    m_pointLights.clear();
+    m_pointHandles.clear();
+    m_lightSlots.clear();
+    m_freeLightSlots.clear();
 }
 
 void
@@ -162,10 +180,16 @@ Scene::renderDebug()
 #endif
 }
 
-const std::vector<const Light*>&
-Scene::getLights() logical_const
+const std::vector<const DirectionalLight*>&
+Scene::getDirectionalLights() logical_const
+{
+    return m_directionalLights;
+}
+
+const std::vector<const PointLight*>&
+Scene::getPointLights() logical_const
 {
-    return m_lights;
+    return m_pointLights;
 }
 
 const std::vector<Entity*>&
@@ -208,6 +232,26 @@ Scene::getHighlightedEntity() bitwise_const
     return highlighted;
 }
 
+HealthbarSystem*
+Scene::getHealthbars(const cstring healthbarType)
+{
+    const stringID typeID = internString(healthbarType);
+    for (auto iter = m_healthbarSystems.begin();
+              iter != m_healthbarSystems.end();
+            ++iter)
+    {
+        if ((*iter)->getTypeID() == typeID) return *iter;
+    }
+
+    m_healthbarSystems.push_back(new HealthbarSystem(healthbarType));
+    return m_healthbarSystems.back();
+}
+
+const std::vector<HealthbarSystem*>&
+Scene::getHealthbarSystems() logical_const
+{
+    return m_healthbarSystems;
+}
 
 void
 Scene::queueAddEntity(Entity* entity)
@@ -222,31 +266,233 @@ Scene::queueKillEntity(Entity* entity)
 }
 
 void
-Scene::addLight(const Light* light)
+Scene::deferCommand(Command* command)
 {
-    m_lights.push_back(light);
+    DeferredCommand deferred = {};
+    deferred.dc_issuer  = s_currentIssuer;
+    deferred.dc_command = command;
+
+    const size_t workerIndex = JobSystem::getWorkerIndex();
+    if (workerIndex == JobSystem::INVALID_WORKER_INDEX)
+    {
+        std::lock_guard<std::mutex> lock(m_foreignCommandMutex);
+        m_deferredCommands.back().push_back(deferred);
+        return;
+    }
+
+    m_deferredCommands[workerIndex].push_back(deferred);
 }
 
+Scene::LightHandle
+Scene::addLight(const DirectionalLight* light)
+{
+    if (!light) return INVALID_LIGHT_HANDLE;
+
+    const LightHandle handle = allocateLightHandle(Light::LIGHT_DIRECTIONAL,
+                                                   static_cast<uint32>(m_directionalLights.size()));
+    if (handle == INVALID_LIGHT_HANDLE) return INVALID_LIGHT_HANDLE;
+
+    m_directionalLights.push_back(light);
+    m_directionalHandles.push_back(handle);
+    return handle;
+}
+
+Scene::LightHandle
+Scene::addLight(const PointLight* light)
+{
+    if (!light) return INVALID_LIGHT_HANDLE;
+
+    const LightHandle handle = allocateLightHandle(Light::LIGHT_POINT,
+                                                   static_cast<uint32>(m_pointLights.size()));
+    if (handle == INVALID_LIGHT_HANDLE) return INVALID_LIGHT_HANDLE;
+
+    m_pointLights.push_back(light);
+    m_pointHandles.push_back(handle);
+    return handle;
+}
 
 void
-Scene::removeLight(const Light* light)
+Scene::removeLight(const LightHandle handle)
 {
-    for (size_t i = 0;
-                i < m_lights.size();
-              ++i)
+    LightSlot* slot = findLightSlot(handle);
+    if (!slot) return;
+
+    // The last light of the type fills the removed one's slot
+    const uint32 index = slot->ls_index;
+    switch (slot->ls_type)
     {
-        if (m_lights[i] == light) m_lights.erase(m_lights.begin() + i);
-        break;
+        case Light::LIGHT_DIRECTIONAL:
+        {
+            m_directionalLights[index]  = m_directionalLights.back();
+            m_directionalHandles[index] = m_directionalHandles.back();
+            m_lightSlots[m_directionalHandles[index] & LIGHT_HANDLE_INDEX_MASK].ls_index = index;
+            m_directionalLights.pop_back();
+            m_directionalHandles.pop_back();
+        } break;
+
+        case Light::LIGHT_POINT:
+        {
+            m_pointLights[index]  = m_pointLights.back();
+            m_pointHandles[index] = m_pointHandles.back();
+            m_lightSlots[m_pointHandles[index] & LIGHT_HANDLE_INDEX_MASK].ls_index = index;
+            m_pointLights.pop_back();
+            m_pointHandles.pop_back();
+        } break;
+
+        default: break;
     }
+
+    // Bumping the generation invalidates every copy of the handle
+    slot->ls_index      = INVALID_LIGHT_HANDLE;
+    slot->ls_generation = (slot->ls_generation + 1U) % LIGHT_HANDLE_NUM_GENS;
+    m_freeLightSlots.push_back(handle & LIGHT_HANDLE_INDEX_MASK);
 }
 
 /* ---------------
    Private Methods
    --------------- */
+Scene::LightHandle
+Scene::allocateLightHandle(const Light::LightType lightType,
+                           const uint32           index)
+{
+    uint32 slotIndex = 0U;
+    if (!m_freeLightSlots.empty())
+    {
+        slotIndex = m_freeLightSlots.back();
+        m_freeLightSlots.pop_back();
+    }
+    else
+    {
+        if (m_lightSlots.size() > LIGHT_HANDLE_INDEX_MASK) return INVALID_LIGHT_HANDLE;
+
+        slotIndex = static_cast<uint32>(m_lightSlots.size());
+        m_lightSlots.push_back(LightSlot());
+        m_lightSlots.back().ls_generation = 0U;
+    }
+
+    LightSlot& slot = m_lightSlots[slotIndex];
+    slot.ls_type  = lightType;
+    slot.ls_index = index;
+    return (slot.ls_generation << LIGHT_HANDLE_INDEX_BITS) | slotIndex;
+}
+
+Scene::LightSlot*
+Scene::findLightSlot(const LightHandle handle)
+{
+    const uint32 slotIndex = handle & LIGHT_HANDLE_INDEX_MASK;
+    if (slotIndex >= m_lightSlots.size()) return nullptr;
+
+    LightSlot& slot = m_lightSlots[slotIndex];
+    if (slot.ls_index == INVALID_LIGHT_HANDLE) return nullptr;
+    if (slot.ls_generation != handle >> LIGHT_HANDLE_INDEX_BITS) return nullptr;
+    return &slot;
+}
+
+void
+Scene::updateEntities(const bool enemies)
+{
+    JobSystem::get()->parallelFor(m_cachedEntities.size(),
+                                  SCENE_UPDATE_GRAIN_SIZE,
+                                  [this, enemies](size_t begin, size_t end)
+    {
+        for (size_t i = begin;
+                    i < end;
+                  ++i)
+        {
+            Entity* entity = m_cachedEntities[i];
+            if (entity->isEnemy() != enemies) continue;
+
+            s_currentIssuer = i;
+            entity->update();
+        }
+        s_currentIssuer = std::numeric_limits<size_t>::max();
+    });
+}
+
+void
+Scene::applyDeferredCommands()
+{
+    m_mergedCommands.clear();
+    for (auto iter = m_deferredCommands.begin();
+              iter != m_deferredCommands.end();
+            ++iter)
+    {
+        m_mergedCommands.insert(m_mergedCommands.end(), iter->begin(), iter->end());
+        iter->clear();
+    }
+
+    // All the commands of a single issuer come from the same worker
+    // buffer in issue order, so a stable sort on the issuer yields
+    // the same sequence regardless of how entities were scheduled
+    std::stable_sort(m_mergedCommands.begin(),
+                     m_mergedCommands.end(),
+                     [](const DeferredCommand& a, const DeferredCommand& b)
+                     {
+                         return a.dc_issuer < b.dc_issuer;
+                     });
+
+    for (auto iter = m_mergedCommands.begin();
+              iter != m_mergedCommands.end();
+            ++iter)
+    {
+        // Commands delete themselves on execution
+        iter->dc_command->execute();
+    }
+    m_mergedCommands.clear();
+}
+
+void
+Scene::updateTileRefs()
+{
+    MEM_TAG_SCOPE(memtracker::MEM_TAG_ENTITIES);
+
+    for (auto iter = m_cachedEntities.begin();
+              iter != m_cachedEntities.end();
+            ++iter)
+    {
+        if (!(*iter)->isAlive())
+        {            
+            queueKillEntity(*iter);
+            continue;
+        }
+
+        Tile* oldTile    = (*iter)->getTileRef(m_entityGraph);
+        Tile* targetTile = m_entityGraph->getTile(
+            m_entityGraph->getCol((*iter)->getBody()->position.x),
+            m_entityGraph->getRow((*iter)->getBody()->position.z));
+
+        // Out of bounds or Death check
+        if (!targetTile)
+        {            
+            (*iter)->setAlive(false);
+            queueKillEntity(*iter);            
+            continue;
+        }
+
+        // Tile update
+        if (targetTile != oldTile)
+        {
+            for (size_t i = 0;
+                        i < oldTile->t_entities.size();
+                      ++i)
+            {
+                if (oldTile->t_entities[i] == (*iter)) 
+                {
+                    oldTile->t_entities.erase(oldTile->t_entities.begin() + i);
+                    break;
+                }
+            }
+            targetTile->t_entities.push_back(*iter);            
+            (*iter)->setTileRef(m_entityGraph, targetTile);
+        }
+    }
+}
 
 void
 Scene::addEntity(Entity* entity)
 {
+    MEM_TAG_SCOPE(memtracker::MEM_TAG_ENTITIES);
+
     Tile* targetTile = m_entityGraph->getTile(
         m_entityGraph->getCol(entity->getBody()->position.x),
         m_entityGraph->getRow(entity->getBody()->position.z));
@@ -10,15 +10,27 @@
 #pragma once
 
 #include <vector>
+#include <mutex>
 #include <queue>
+#include "../rendering/lights.h"
 #include "../util/strings.h"
 #include "../dotmdef.h"
 
 class Entity;
-class Light;
+class Command;
 class Tilemap;
+class HealthbarSystem;
 class Scene
 {
+public:
+
+    // The low bits of a handle select its light slot and the high
+    // bits carry the slot's generation, so that a handle kept after
+    // its light was removed does not resolve to a later light
+    typedef uint32 LightHandle;
+
+    static const LightHandle INVALID_LIGHT_HANDLE = 0xFFFFFFFFU;
+
 public:
     
     static const real32 SCENE_CELL_SIZE;
@@ -45,8 +57,14 @@ public:
     void
     renderDebug();
 
-    const std::vector<const Light*>&
-    getLights() logical_const;
+    // Lights are kept densely per type. Removing a light moves
+    // the last light of its type into its place, so the order
+    // of the arrays is not stable
+    const std::vector<const DirectionalLight*>&
+    getDirectionalLights() logical_const;
+
+    const std::vector<const PointLight*>&
+    getPointLights() logical_const;
 
     const std::vector<Entity*>&
     getEntities() logical_const;
@@ -60,6 +78,15 @@ public:
     Entity*
     getHighlightedEntity() bitwise_const;
 
+    // Returns the system holding the bars of the given type,
+    // creating it on first use. Must not be called while the
+    // entities update in parallel
+    HealthbarSystem*
+    getHealthbars(const cstring healthbarType);
+
+    const std::vector<HealthbarSystem*>&
+    getHealthbarSystems() logical_const;
+
 
     // <summary>
     // <para>
@@ -77,11 +104,30 @@ public:
     // </summary>
     void queueKillEntity(Entity* entity);
 
-    void
-    addLight(const Light* light);
+    // <summary>
+    // <para>
+    // Entities are updated in parallel and may only modify
+    // their own state while doing so. Anything touching other
+    // entities or the scene structure (damage, spawning) must be
+    // deferred through this method. Deferred commands are executed
+    // serially after the parallel phase, ordered by the issuing
+    // entity's position in the scene so that the outcome does not
+    // depend on the number of worker threads. The scene takes
+    // ownership of the command until it is executed.
+    // </para>
+    // </summary>
+    void deferCommand(Command* command);
+
+    // The light is not owned by the scene, and must outlive
+    // its registration
+    LightHandle
+    addLight(const DirectionalLight* light);
+
+    LightHandle
+    addLight(const PointLight* light);
 
     void
-    removeLight(const Light* light);
+    removeLight(const LightHandle handle);
 
 private:
 
@@ -91,13 +137,70 @@ private:
     void
     removeEntity(Entity* entity);
 
+    void
+    updateEntities(const bool enemies);
+
+    void
+    applyDeferredCommands();
+
+    void
+    updateTileRefs();
+
+    LightHandle
+    allocateLightHandle(const Light::LightType lightType,
+                        const uint32           index);
+
+private:
+
+    static const uint32 LIGHT_HANDLE_INDEX_BITS = 20U;
+    static const uint32 LIGHT_HANDLE_INDEX_MASK = (1U << LIGHT_HANDLE_INDEX_BITS) - 1U;
+
+    // One short of the 12 generation bits, so that no live
+    // handle equals INVALID_LIGHT_HANDLE
+    static const uint32 LIGHT_HANDLE_NUM_GENS   = 0xFFFU;
+
+    struct DeferredCommand
+    {
+        size_t   dc_issuer;
+        Command* dc_command;
+    };
+
+    // Where a handle's light lives in the arrays of its type
+    struct LightSlot
+    {
+        Light::LightType ls_type;
+        uint32           ls_index;
+        uint32           ls_generation;
+    };
+
+private:
+
+    // Returns the slot of a live handle, or nullptr if the handle
+    // is invalid or its light has been removed
+    LightSlot*
+    findLightSlot(const LightHandle handle);
+
 private:
     
-    std::vector<const Light*> m_lights;
     std::vector<Entity*>      m_cachedEntities;
     std::vector<Entity*>      m_enemies;
     std::queue<Entity*>       m_waitToAddEntities;
     std::queue<Entity*>       m_waitToKillEntities;
     Tilemap*                  m_entityGraph;  
 
+    std::vector<HealthbarSystem*> m_healthbarSystems;
+
+    std::vector<const DirectionalLight*> m_directionalLights;
+    std::vector<LightHandle>             m_directionalHandles;
+    std::vector<const PointLight*>       m_pointLights;
+    std::vector<LightHandle>             m_pointHandles;
+    std::vector<LightSlot>               m_lightSlots;
+    std::vector<uint32>                  m_freeLightSlots;
+
+    // One command buffer per job system worker, plus a locked
+    // one shared by threads outside the pool
+    std::vector<std::vector<DeferredCommand>> m_deferredCommands;
+    std::mutex                                m_foreignCommandMutex;
+    std::vector<DeferredCommand>              m_mergedCommands;
+
 };
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "inputhandler.h"
 #include "../window.h"
 #include "../util/logging.h"
+#include <ctime>
 
 /* -------------
    External Vars
@@ -36,6 +37,9 @@ InputHandler::handleInput(const uint32 msg,
                           const WPARAM wparam,
                           const LPARAM lparam)
 {
+    // The recording drives the input while replaying
+    if (m_replayActive) return;
+
     switch (msg)
     {
         // Key down events
@@ -89,6 +93,30 @@ InputHandler::handleInput(const uint32 msg,
     }
 }
 
+void
+InputHandler::beginFrame()
+{
+    if (m_replayActive)
+    {
+        if (m_replayFrame >= m_recording.ir_frames.size()) return;
+
+        const inputrecording::InputFrame& frame = m_recording.ir_frames[m_replayFrame++];
+        m_currState  = frame.if_state;
+        m_wheelDelta = frame.if_wheelDelta;
+        m_mousePos.x = static_cast<real32>(frame.if_mouseX);
+        m_mousePos.y = static_cast<real32>(frame.if_mouseY);
+    }
+    else if (m_recordingActive)
+    {
+        inputrecording::InputFrame frame = {};
+        frame.if_state      = m_currState;
+        frame.if_wheelDelta = m_wheelDelta;
+        frame.if_mouseX     = static_cast<int16>(m_mousePos.x);
+        frame.if_mouseY     = static_cast<int16>(m_mousePos.y);
+        m_recording.ir_frames.push_back(frame);
+    }
+}
+
 void
 InputHandler::endFrame()
 {
@@ -128,6 +156,64 @@ InputHandler::getMousePos() logical_const
     return m_mousePos;
 }
 
+void
+InputHandler::startRecording(cstring path)
+{
+    m_recording.ir_seed = m_sessionSeed;
+    m_recording.ir_frames.clear();
+    m_recordingPath     = path;
+    m_recordingActive   = true;
+}
+
+bool
+InputHandler::stopRecording()
+{
+    if (!m_recordingActive) return false;
+
+    m_recordingActive = false;
+    return inputrecording::save(m_recordingPath.c_str(), m_recording);
+}
+
+bool
+InputHandler::startReplay(cstring path)
+{
+    if (!inputrecording::load(path, m_recording))
+    {
+        logline("Could not load the input recording");
+        return false;
+    }
+
+    m_sessionSeed     = m_recording.ir_seed;
+    m_replayFrame     = 0U;
+    m_recordingActive = false;
+    m_replayActive    = true;
+    return true;
+}
+
+bool
+InputHandler::isReplaying() logical_const
+{
+    return m_replayActive;
+}
+
+bool
+InputHandler::requiresDeterminism() logical_const
+{
+    return m_recordingActive || m_replayActive;
+}
+
+bool
+InputHandler::isReplayFinished() logical_const
+{
+    return m_replayActive && m_replayFrame >= m_recording.ir_frames.size();
+}
+
+uint32
+InputHandler::getSessionSeed() logical_const
+{
+    return m_sessionSeed;
+}
+
 /* ---------------
    Private Methods
    --------------- */
@@ -136,7 +222,12 @@ InputHandler::InputHandler():
     m_currState(0U),
     m_prevState(0U),
     m_wheelDelta(0U),
-    m_mousePos()    
+    m_mousePos(),
+    m_recording(),
+    m_replayFrame(0U),
+    m_sessionSeed(static_cast<uint32>(std::time(NULL))),
+    m_recordingActive(false),
+    m_replayActive(false)
 {
     m_recognizedInput[VK_SPACE]  = KEY_SPACE;
     m_recognizedInput[VK_LEFT]   = KEY_LEFT;
@@ -149,5 +240,7 @@ InputHandler::InputHandler():
     m_recognizedInput[0x53]      = KEY_S;
     m_recognizedInput[0x45]      = KEY_E;
     m_recognizedInput[0x51]      = KEY_Q;
+    m_recognizedInput[0x50]      = KEY_P;
+    m_recognizedInput[0x4D]      = KEY_M;
     m_recognizedInput[VK_ESCAPE] = KEY_ESCAPE;
 }
\ No newline at end of file
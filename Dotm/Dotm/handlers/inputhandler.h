@@ -4,7 +4,11 @@
    File name:        inputhandler.h
 
    File description: A singleton class representing
-   the main keyboard and mouse input handler.
+   the main keyboard and mouse input handler. The
+   input seen by every frame can be recorded to a
+   file, or replayed from one in place of the live
+   Win32 messages, together with the session's RNG
+   seed, for identical benchmark sessions.
    ------------------------------------------------ */
 
 #pragma once
@@ -12,6 +16,8 @@
 #include "../dotmdef.h"
 #include "../window.h"
 #include "../util/math.h"
+#include "inputrecording.h"
+#include <string>
 #include <unordered_map>
 
 class InputHandler
@@ -30,9 +36,57 @@ public:
                 const WPARAM wparam,
                 const LPARAM lparam);
 
+    // Fixes the input state of the frame about to run: recorded
+    // while recording, read from the recording while replaying
+    void
+    beginFrame();
+
     void
     endFrame();
 
+    // Records from the next frame on, until stopRecording
+    void
+    startRecording(cstring path);
+
+    // Writes the recording. Returns false if nothing was being
+    // recorded or the file could not be written
+    bool
+    stopRecording();
+
+    // <summary>
+    // <para>
+    // Loads a recording and replays it from the next frame on.
+    // Live input is ignored while replaying, and the session seed
+    // becomes the recorded one. Call before any game state reads
+    // the seed.
+    // </para>
+    // </summary>
+    bool
+    startReplay(cstring path);
+
+    bool
+    isReplaying() logical_const;
+
+    // <summary>
+    // <para>
+    // True while recording or replaying. Systems whose results
+    // would otherwise depend on thread or disk timings (path
+    // searches, mesh streaming) must then complete their work on a
+    // fixed frame, so that replays follow the recorded session.
+    // </para>
+    // </summary>
+    bool
+    requiresDeterminism() logical_const;
+
+    // True once every recorded frame has been replayed
+    bool
+    isReplayFinished() logical_const;
+
+    // Seeds the gameplay RNG, so that replays make the same
+    // random choices as the recorded session
+    uint32
+    getSessionSeed() logical_const;
+
     bool
     isPressed(const uint32 code) logical_const;
 
@@ -74,6 +128,8 @@ public:
     static const uint32 KEY_Q         = 0x1000;
     static const uint32 KEY_E         = 0x2000;
     static const uint32 KEY_ESCAPE    = 0x4000;
+    static const uint32 KEY_P         = 0x8000;
+    static const uint32 KEY_M         = 0x10000;
     
 private:
 
@@ -83,4 +139,11 @@ private:
     uint32 m_prevState;
     int32  m_wheelDelta;    
     vec2f  m_mousePos;    
+
+    inputrecording::InputRecording m_recording;
+    std::string                    m_recordingPath;
+    size_t                         m_replayFrame;
+    uint32                         m_sessionSeed;
+    bool                           m_recordingActive;
+    bool                           m_replayActive;
 };
\ No newline at end of file
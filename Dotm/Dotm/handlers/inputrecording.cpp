@@ -0,0 +1,183 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        inputrecording.cpp
+
+   File description: Implementation of the input
+   recording functions declared in inputrecording.h
+   ------------------------------------------------ */
+
+#include "inputrecording.h"
+#include <cstdio>
+
+/* ---------
+   Constants
+   --------- */
+#define RECORDING_MAGIC   0x43455244U // "DREC"
+#define RECORDING_VERSION 1U
+
+#define FRAME_STATE_CHANGED 0x01U
+#define FRAME_WHEEL_CHANGED 0x02U
+#define FRAME_MOUSE_CHANGED 0x04U
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static void
+writeUint(std::vector<uint8>& outBytes,
+          const uint32        value,
+          const uint32        nBytes);
+
+static bool
+readUint(const std::vector<uint8>& bytes,
+         size_t&                   offset,
+         const uint32              nBytes,
+         uint32&                   outValue);
+
+/* ----------------
+   Public Functions
+   ---------------- */
+bool
+inputrecording::save(cstring               path,
+                     const InputRecording& recording)
+{
+    // Little endian throughout, whatever the host
+    std::vector<uint8> bytes;
+    bytes.reserve(16U + recording.ir_frames.size());
+    writeUint(bytes, RECORDING_MAGIC, 4U);
+    writeUint(bytes, RECORDING_VERSION, 4U);
+    writeUint(bytes, recording.ir_seed, 4U);
+    writeUint(bytes, static_cast<uint32>(recording.ir_frames.size()), 4U);
+
+    InputFrame previous = {};
+    for (size_t i = 0;
+                i < recording.ir_frames.size();
+              ++i)
+    {
+        const InputFrame& frame = recording.ir_frames[i];
+
+        uint8 flags = 0U;
+        if (frame.if_state      != previous.if_state)      flags |= FRAME_STATE_CHANGED;
+        if (frame.if_wheelDelta != previous.if_wheelDelta) flags |= FRAME_WHEEL_CHANGED;
+        if (frame.if_mouseX     != previous.if_mouseX ||
+            frame.if_mouseY     != previous.if_mouseY)     flags |= FRAME_MOUSE_CHANGED;
+
+        bytes.push_back(flags);
+        if (flags & FRAME_STATE_CHANGED) writeUint(bytes, frame.if_state, 4U);
+        if (flags & FRAME_WHEEL_CHANGED) writeUint(bytes, static_cast<uint8>(frame.if_wheelDelta), 1U);
+        if (flags & FRAME_MOUSE_CHANGED)
+        {
+            writeUint(bytes, static_cast<uint16>(frame.if_mouseX), 2U);
+            writeUint(bytes, static_cast<uint16>(frame.if_mouseY), 2U);
+        }
+
+        previous = frame;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+
+    const bool written = fwrite(bytes.data(), 1U, bytes.size(), file) == bytes.size();
+    return fclose(file) == 0 && written;
+}
+
+bool
+inputrecording::load(cstring         path,
+                     InputRecording& outRecording)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    std::vector<uint8> bytes;
+    uint8  chunk[4096];
+    size_t nRead = 0U;
+    while ((nRead = fread(chunk, 1U, sizeof(chunk), file)) > 0U)
+    {
+        bytes.insert(bytes.end(), chunk, chunk + nRead);
+    }
+    fclose(file);
+
+    size_t offset  = 0U;
+    uint32 magic   = 0U;
+    uint32 version = 0U;
+    uint32 nFrames = 0U;
+    if (!readUint(bytes, offset, 4U, magic)   || magic   != RECORDING_MAGIC   ||
+        !readUint(bytes, offset, 4U, version) || version != RECORDING_VERSION ||
+        !readUint(bytes, offset, 4U, outRecording.ir_seed) ||
+        !readUint(bytes, offset, 4U, nFrames))
+    {
+        return false;
+    }
+
+    // Every frame takes at least its flags byte
+    if (nFrames > bytes.size() - offset) return false;
+
+    outRecording.ir_frames.resize(nFrames);
+
+    InputFrame frame = {};
+    for (uint32 i = 0;
+                i < nFrames;
+              ++i)
+    {
+        uint32 flags = 0U;
+        uint32 value = 0U;
+        if (!readUint(bytes, offset, 1U, flags)) return false;
+
+        if (flags & FRAME_STATE_CHANGED)
+        {
+            if (!readUint(bytes, offset, 4U, frame.if_state)) return false;
+        }
+        if (flags & FRAME_WHEEL_CHANGED)
+        {
+            if (!readUint(bytes, offset, 1U, value)) return false;
+            frame.if_wheelDelta = static_cast<int8>(value);
+        }
+        if (flags & FRAME_MOUSE_CHANGED)
+        {
+            if (!readUint(bytes, offset, 2U, value)) return false;
+            frame.if_mouseX = static_cast<int16>(value);
+            if (!readUint(bytes, offset, 2U, value)) return false;
+            frame.if_mouseY = static_cast<int16>(value);
+        }
+
+        outRecording.ir_frames[i] = frame;
+    }
+
+    return true;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static void
+writeUint(std::vector<uint8>& outBytes,
+          const uint32        value,
+          const uint32        nBytes)
+{
+    for (uint32 i = 0;
+                i < nBytes;
+              ++i)
+    {
+        outBytes.push_back(static_cast<uint8>(value >> (i * 8U)));
+    }
+}
+
+static bool
+readUint(const std::vector<uint8>& bytes,
+         size_t&                   offset,
+         const uint32              nBytes,
+         uint32&                   outValue)
+{
+    if (bytes.size() - offset < nBytes) return false;
+
+    outValue = 0U;
+    for (uint32 i = 0;
+                i < nBytes;
+              ++i)
+    {
+        outValue |= static_cast<uint32>(bytes[offset + i]) << (i * 8U);
+    }
+
+    offset += nBytes;
+    return true;
+}
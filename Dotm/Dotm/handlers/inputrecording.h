@@ -0,0 +1,52 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        inputrecording.h
+
+   File description: The binary format of input
+   recordings. A recording holds the RNG seed of
+   the session and the input state seen by every
+   frame (keys and buttons, wheel and mouse
+   position), so that replaying it through the
+   InputHandler reproduces the session exactly.
+
+   Frames are delta encoded: each frame is a
+   byte of flags naming the fields that changed
+   since the previous frame, followed by those
+   fields only, so idle stretches cost one byte
+   per frame.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include "../util/strings.h"
+#include <vector>
+
+namespace inputrecording
+{
+    // The wheel delta is stored as a byte, the InputHandler
+    // only reporting its sign
+    struct InputFrame
+    {
+        uint32 if_state;
+        int32  if_wheelDelta;
+        int16  if_mouseX;
+        int16  if_mouseY;
+    };
+
+    struct InputRecording
+    {
+        uint32                  ir_seed;
+        std::vector<InputFrame> ir_frames;
+    };
+
+    bool
+    save(cstring               path,
+         const InputRecording& recording);
+
+    // Fails for files of another format or version, or cut short
+    bool
+    load(cstring         path,
+         InputRecording& outRecording);
+}
@@ -0,0 +1,394 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        commandlist.cpp
+
+   File description: Implementation of the command
+   list and the null executor declared in
+   commandlist.h
+   ------------------------------------------------ */
+
+#include "commandlist.h"
+#include <cstring>
+#include <sstream>
+
+/* ---------
+   Constants
+   --------- */
+#define CL_CONSTANT_ALIGNMENT 16
+
+/* -------------
+   Internal Vars
+   ------------- */
+static cstring s_commandNames[CommandList::CMD_COUNT] =
+{
+    "set_shader",
+    "set_vertex_buffer",
+    "set_index_buffer",
+    "set_instance_stream",
+    "set_texture",
+    "set_shader_resource",
+    "set_depth_state",
+    "set_raster_state",
+    "update_constants",
+    "bind_constants",
+    "clear_depth",
+    "draw_indexed",
+    "draw_indexed_instanced"
+};
+
+/* ==================
+   Class: CommandList
+   ================== */
+
+/* --------------
+   Public Methods
+   -------------- */
+CommandList::CommandList():
+
+    m_instanceStride(0U)
+{
+
+}
+
+CommandList::~CommandList()
+{
+
+}
+
+void
+CommandList::clear()
+{
+    m_commands.clear();
+    m_constantData.clear();
+    m_ringData.clear();
+    m_instanceData.clear();
+    m_instanceStride = 0U;
+}
+
+void
+CommandList::append(const CommandList& rhs)
+{
+    const uint32 dataBase     = static_cast<uint32>(m_constantData.size());
+    const uint32 ringBase     = static_cast<uint32>(m_ringData.size());
+    const uint32 instanceBase = rhs.m_instanceData.empty() ? 0U :
+                                appendInstances(&rhs.m_instanceData[0],
+                                                static_cast<uint32>(rhs.m_instanceData.size() / rhs.m_instanceStride),
+                                                rhs.m_instanceStride);
+
+    m_constantData.insert(m_constantData.end(), rhs.m_constantData.cbegin(), rhs.m_constantData.cend());
+    m_ringData.insert(m_ringData.end(), rhs.m_ringData.cbegin(), rhs.m_ringData.cend());
+    for (auto citer = rhs.m_commands.cbegin();
+              citer != rhs.m_commands.cend();
+            ++citer)
+    {
+        m_commands.push_back(*citer);
+        if (citer->c_type == CMD_UPDATE_CONSTANTS)       m_commands.back().c_args[0] += dataBase;
+        if (citer->c_type == CMD_BIND_CONSTANTS)         m_commands.back().c_args[0] += ringBase;
+        if (citer->c_type == CMD_DRAW_INDEXED_INSTANCED) m_commands.back().c_args[3] += instanceBase;
+    }
+}
+
+void
+CommandList::setShader(const Shader* shader)
+{
+    push(CMD_SET_SHADER, shader);
+}
+
+void
+CommandList::setVertexBuffer(const void*  buffer,
+                             const uint32 slot,
+                             const uint32 stride)
+{
+    push(CMD_SET_VERTEX_BUFFER, buffer, slot, stride);
+}
+
+void
+CommandList::setIndexBuffer(const void*  buffer,
+                            const uint32 indexSize)
+{
+    push(CMD_SET_INDEX_BUFFER, buffer, indexSize);
+}
+
+void
+CommandList::setInstanceStream(const uint32 stride)
+{
+    push(CMD_SET_INSTANCE_STREAM, nullptr, stride);
+}
+
+void
+CommandList::setTexture(const void* texture)
+{
+    push(CMD_SET_TEXTURE, texture);
+}
+
+void
+CommandList::setShaderResource(const void*  resource,
+                               const uint32 slot)
+{
+    push(CMD_SET_SHADER_RESOURCE, resource, slot);
+}
+
+void
+CommandList::setDepthState(const DepthState depthState)
+{
+    push(CMD_SET_DEPTH_STATE, nullptr, depthState);
+}
+
+void
+CommandList::setRasterState(const RasterState rasterState)
+{
+    push(CMD_SET_RASTER_STATE, nullptr, rasterState);
+}
+
+void
+CommandList::updateConstants(const void*  constantBuffer,
+                             const void*  data,
+                             const uint32 size)
+{
+    // Every block starts aligned, as the upload may read it
+    // with aligned loads. The list's own size stays aligned
+    // too, which keeps appended lists' blocks aligned
+    const uint32 offset        = static_cast<uint32>(m_constantData.size());
+    const uint32 alignedSize   = (size + CL_CONSTANT_ALIGNMENT - 1) & ~(CL_CONSTANT_ALIGNMENT - 1);
+    m_constantData.resize(offset + alignedSize, 0U);
+    memcpy(&m_constantData[offset], data, size);
+
+    push(CMD_UPDATE_CONSTANTS, constantBuffer, offset, size);
+}
+
+void
+CommandList::bindConstants(const ShaderStage stage,
+                           const uint32      slot,
+                           const void*       data,
+                           const uint32      size)
+{
+    // Padding every block to the binding granularity keeps the
+    // ring a single contiguous upload, bindable at any block
+    const uint32 offset      = static_cast<uint32>(m_ringData.size());
+    const uint32 alignedSize = (size + RING_ALIGNMENT - 1) & ~(RING_ALIGNMENT - 1);
+    m_ringData.resize(offset + alignedSize, 0U);
+    memcpy(&m_ringData[offset], data, size);
+
+    push(CMD_BIND_CONSTANTS, nullptr, offset, size, stage, slot);
+}
+
+uint32
+CommandList::appendInstances(const void*  instances,
+                             const uint32 nInstances,
+                             const uint32 stride)
+{
+    // Should the stride ever change, the stream is padded so
+    // that the new instances still start at a whole index
+    const uint32 firstInstance = static_cast<uint32>((m_instanceData.size() + stride - 1) / stride);
+    m_instanceData.resize((firstInstance + nInstances) * stride, 0U);
+    memcpy(&m_instanceData[firstInstance * stride], instances, nInstances * stride);
+    m_instanceStride = stride;
+
+    return firstInstance;
+}
+
+void
+CommandList::clearDepth()
+{
+    push(CMD_CLEAR_DEPTH, nullptr);
+}
+
+void
+CommandList::drawIndexed(const uint32 indexCount,
+                         const uint32 firstIndex)
+{
+    push(CMD_DRAW_INDEXED, nullptr, indexCount, firstIndex);
+}
+
+void
+CommandList::drawIndexedInstanced(const uint32 indexCount,
+                                  const uint32 instanceCount,
+                                  const uint32 firstIndex,
+                                  const uint32 firstInstance)
+{
+    push(CMD_DRAW_INDEXED_INSTANCED, nullptr, indexCount, instanceCount, firstIndex, firstInstance);
+}
+
+const std::vector<CommandList::Command>&
+CommandList::getCommands() logical_const
+{
+    return m_commands;
+}
+
+const uint8*
+CommandList::getConstantData(const Command& command) logical_const
+{
+    return command.c_type == CMD_BIND_CONSTANTS ? &m_ringData[command.c_args[0]] :
+                                                  &m_constantData[command.c_args[0]];
+}
+
+const std::vector<uint8>&
+CommandList::getRingData() logical_const
+{
+    return m_ringData;
+}
+
+const std::vector<uint8>&
+CommandList::getInstanceData() logical_const
+{
+    return m_instanceData;
+}
+
+size_t
+CommandList::getConstantBytes() logical_const
+{
+    return m_constantData.size() + m_ringData.size();
+}
+
+/* ---------------
+   Private Methods
+   --------------- */
+void
+CommandList::push(const CommandType type,
+                  const void*       handle,
+                  const uint32      arg0 /* 0U */,
+                  const uint32      arg1 /* 0U */,
+                  const uint32      arg2 /* 0U */,
+                  const uint32      arg3 /* 0U */,
+                  const uint32      arg4 /* 0U */)
+{
+    Command command = {};
+    command.c_type     = type;
+    command.c_handle   = handle;
+    command.c_args[0]  = arg0;
+    command.c_args[1]  = arg1;
+    command.c_args[2]  = arg2;
+    command.c_args[3]  = arg3;
+    command.c_args[4]  = arg4;
+    m_commands.push_back(command);
+}
+
+/* ======================
+   Class: CommandExecutor
+   ====================== */
+CommandExecutor::~CommandExecutor()
+{
+
+}
+
+/* ===================
+   Class: NullExecutor
+   =================== */
+
+/* --------------
+   Public Methods
+   -------------- */
+NullExecutor::NullExecutor(const bool transcribe /* false */):
+
+    m_transcribe(transcribe),
+    m_stats()
+{
+
+}
+
+NullExecutor::~NullExecutor()
+{
+
+}
+
+void
+NullExecutor::execute(const CommandList& commandList)
+{
+    const std::vector<CommandList::Command>& commands = commandList.getCommands();
+
+    std::ostringstream transcript;
+    for (auto citer = commands.cbegin();
+              citer != commands.cend();
+            ++citer)
+    {
+        ++m_stats.es_commands[citer->c_type];
+
+        switch (citer->c_type)
+        {
+            case CommandList::CMD_UPDATE_CONSTANTS:
+            case CommandList::CMD_BIND_CONSTANTS:
+            {
+                m_stats.es_constantBytes += citer->c_args[1];
+            } break;
+
+            case CommandList::CMD_DRAW_INDEXED:
+            {
+                m_stats.es_triangles += citer->c_args[0] / 3;
+            } break;
+
+            case CommandList::CMD_DRAW_INDEXED_INSTANCED:
+            {
+                m_stats.es_triangles += citer->c_args[0] / 3 * citer->c_args[1];
+            } break;
+
+            default: break;
+        }
+
+        if (!m_transcribe) continue;
+
+        // Constant data is summarized by its size and a hash, which
+        // is enough to tell streams with different values apart
+        transcript << s_commandNames[citer->c_type];
+        if (citer->c_handle) transcript << " #" << getHandleID(citer->c_handle);
+        if (citer->c_type == CommandList::CMD_BIND_CONSTANTS)
+        {
+            transcript << " stage " << citer->c_args[2] << " slot " << citer->c_args[3];
+        }
+        if (citer->c_type == CommandList::CMD_UPDATE_CONSTANTS ||
+            citer->c_type == CommandList::CMD_BIND_CONSTANTS)
+        {
+            const uint8* data = commandList.getConstantData(*citer);
+            uint32 hash = 2166136261U;
+            for (size_t i = 0;
+                        i < citer->c_args[1];
+                      ++i)
+            {
+                hash = (hash ^ data[i]) * 16777619U;
+            }
+            transcript << " " << citer->c_args[1] << " bytes hash " << std::hex << hash << std::dec;
+        }
+        else
+        {
+            for (size_t i = 0;
+                        i < 5;
+                      ++i)
+            {
+                transcript << " " << citer->c_args[i];
+            }
+        }
+        transcript << "\n";
+    }
+
+    if (m_transcribe) m_transcript += transcript.str();
+}
+
+void
+NullExecutor::reset()
+{
+    m_stats = ExecutionStats();
+    m_transcript.clear();
+    m_handleIDs.clear();
+}
+
+const NullExecutor::ExecutionStats&
+NullExecutor::getStats() logical_const
+{
+    return m_stats;
+}
+
+const std::string&
+NullExecutor::getTranscript() logical_const
+{
+    return m_transcript;
+}
+
+/* ---------------
+   Private Methods
+   --------------- */
+uint32
+NullExecutor::getHandleID(const void* handle)
+{
+    auto result = m_handleIDs.insert(std::make_pair(handle, static_cast<uint32>(m_handleIDs.size())));
+    return result.first->second;
+}
@@ -0,0 +1,298 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        commandlist.h
+
+   File description: A backend agnostic list of
+   rendering commands. The renderer records binds,
+   constant updates and draws into it, and an
+   executor replays them later: the D3D11 executor
+   against the device context, or the null executor
+   which only counts and transcribes them. Lists
+   own a copy of all their constant data, so they
+   can be recorded on any thread and replayed any
+   number of times.
+
+   Constants come in two kinds. Updates write a
+   whole constant buffer owned by the caller,
+   while binds place their data in the list's
+   constant ring, which the executor uploads once
+   per execution and binds at each block's offset.
+   Per instance data is handled the same way: it is
+   appended to the list's instance stream and
+   uploaded once, so any number of instanced draws
+   can be recorded during a frame.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include "../util/strings.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Shader;
+
+/* ==================
+   Class: CommandList
+   ================== */
+class CommandList
+{
+public:
+
+    enum CommandType
+    {
+        CMD_SET_SHADER,
+        CMD_SET_VERTEX_BUFFER,
+        CMD_SET_INDEX_BUFFER,
+        CMD_SET_INSTANCE_STREAM,
+        CMD_SET_TEXTURE,
+        CMD_SET_SHADER_RESOURCE,
+        CMD_SET_DEPTH_STATE,
+        CMD_SET_RASTER_STATE,
+        CMD_UPDATE_CONSTANTS,
+        CMD_BIND_CONSTANTS,
+        CMD_CLEAR_DEPTH,
+        CMD_DRAW_INDEXED,
+        CMD_DRAW_INDEXED_INSTANCED,
+        CMD_COUNT
+    };
+
+    enum DepthState
+    {
+        DEPTH_ENABLED,
+        DEPTH_DISABLED
+    };
+
+    enum RasterState
+    {
+        RASTER_SOLID,
+        RASTER_WIREFRAME
+    };
+
+    enum ShaderStage
+    {
+        STAGE_VERTEX,
+        STAGE_PIXEL,
+        STAGE_COUNT
+    };
+
+    // Ring blocks start at multiples of this, the offset
+    // granularity of constant buffer binding (16 constants)
+    static const uint32 RING_ALIGNMENT = 256U;
+
+    // Resources are opaque handles that only the executor
+    // interprets (for D3D11: the COM object pointers)
+    struct Command
+    {
+        CommandType c_type;
+        const void* c_handle;
+        uint32      c_args[5];
+    };
+
+public:
+
+    CommandList();
+
+    ~CommandList();
+
+    // Removes all the commands, keeping the allocated memory
+    void
+    clear();
+
+    // Appends the commands of another list, e.g. one recorded
+    // on a worker thread
+    void
+    append(const CommandList& rhs);
+
+    void
+    setShader(const Shader* shader);
+
+    // Binds to slot 0 for the mesh vertices or slot 1 for
+    // the per instance data
+    void
+    setVertexBuffer(const void*  buffer,
+                    const uint32 slot,
+                    const uint32 stride);
+
+    void
+    setIndexBuffer(const void*  buffer,
+                   const uint32 indexSize);
+
+    // Binds the list's instance stream to slot 1
+    void
+    setInstanceStream(const uint32 stride);
+
+    void
+    setTexture(const void* texture);
+
+    // Binds a pixel shader resource other than the texture, which
+    // owns slot 0. Like constant bindings it persists across
+    // shader changes
+    void
+    setShaderResource(const void*  resource,
+                      const uint32 slot);
+
+    void
+    setDepthState(const DepthState depthState);
+
+    void
+    setRasterState(const RasterState rasterState);
+
+    // The data is copied into the list
+    void
+    updateConstants(const void*  constantBuffer,
+                    const void*  data,
+                    const uint32 size);
+
+    // <summary>
+    // <para>
+    // Copies the data into the constant ring and binds it to the
+    // given slot of the shader stage. Bindings are pipeline state
+    // and persist across shader changes, so data shared by every
+    // draw (e.g. the frame's lights) only needs binding once.
+    // </para>
+    // </summary>
+    void
+    bindConstants(const ShaderStage stage,
+                  const uint32      slot,
+                  const void*       data,
+                  const uint32      size);
+
+    // <summary>
+    // <para>
+    // Copies the instances into the instance stream and returns
+    // the index of the first one, to be passed as the first
+    // instance of the draws using them. All the instances of a
+    // list are expected to share the same stride.
+    // </para>
+    // </summary>
+    uint32
+    appendInstances(const void*  instances,
+                    const uint32 nInstances,
+                    const uint32 stride);
+
+    void
+    clearDepth();
+
+    void
+    drawIndexed(const uint32 indexCount,
+                const uint32 firstIndex);
+
+    void
+    drawIndexedInstanced(const uint32 indexCount,
+                         const uint32 instanceCount,
+                         const uint32 firstIndex,
+                         const uint32 firstInstance);
+
+    const std::vector<Command>&
+    getCommands() logical_const;
+
+    // Constant data of a CMD_UPDATE_CONSTANTS or a
+    // CMD_BIND_CONSTANTS command
+    const uint8*
+    getConstantData(const Command& command) logical_const;
+
+    // The whole constant ring, RING_ALIGNMENT padded
+    const std::vector<uint8>&
+    getRingData() logical_const;
+
+    const std::vector<uint8>&
+    getInstanceData() logical_const;
+
+    // Constant bytes an execution of the list uploads
+    size_t
+    getConstantBytes() logical_const;
+
+private:
+
+    void
+    push(const CommandType type,
+         const void*       handle,
+         const uint32      arg0 = 0U,
+         const uint32      arg1 = 0U,
+         const uint32      arg2 = 0U,
+         const uint32      arg3 = 0U,
+         const uint32      arg4 = 0U);
+
+private:
+
+    std::vector<Command> m_commands;
+    std::vector<uint8>   m_constantData;
+    std::vector<uint8>   m_ringData;
+    std::vector<uint8>   m_instanceData;
+    uint32               m_instanceStride;
+
+};
+
+/* ======================
+   Class: CommandExecutor
+   ====================== */
+class CommandExecutor
+{
+public:
+
+    virtual
+    ~CommandExecutor();
+
+    virtual void
+    execute(const CommandList& commandList) = 0;
+
+};
+
+/* ===================
+   Class: NullExecutor
+   =================== */
+class NullExecutor: public CommandExecutor
+{
+public:
+
+    struct ExecutionStats
+    {
+        uint32 es_commands[CommandList::CMD_COUNT];
+        uint32 es_triangles;
+        uint64 es_constantBytes;
+    };
+
+public:
+
+    // <summary>
+    // <para>
+    // If transcribe is set, every executed command is also
+    // appended as a line of text to the transcript. Handles are
+    // numbered in order of first use, so transcripts of the same
+    // command stream compare equal across runs and can be diffed.
+    // </para>
+    // </summary>
+    explicit
+    NullExecutor(const bool transcribe = false);
+
+    ~NullExecutor();
+
+    void
+    execute(const CommandList& commandList) override;
+
+    // Clears the stats, the transcript and the handle numbering
+    void
+    reset();
+
+    const ExecutionStats&
+    getStats() logical_const;
+
+    const std::string&
+    getTranscript() logical_const;
+
+private:
+
+    uint32
+    getHandleID(const void* handle);
+
+private:
+
+    bool                                    m_transcribe;
+    ExecutionStats                          m_stats;
+    std::string                             m_transcript;
+    std::unordered_map<const void*, uint32> m_handleIDs;
+
+};
@@ -0,0 +1,187 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        culling.cpp
+
+   File description: Implementation of the batched
+   culling functions declared in culling.h
+   ------------------------------------------------ */
+
+#include "culling.h"
+#include "../util/physics.h"
+#include <xmmintrin.h>
+#include <chrono>
+
+/* ---------
+   Constants
+   --------- */
+#define CULLING_NUM_PLANES 6
+#define CULLING_LANE_WIDTH 4
+
+/* ----------------
+   Public Functions
+   ---------------- */
+void
+culling::cullSpheres(const math::Frustum& frustum,
+                     const SphereSet&     spheres,
+                     std::vector<uint32>& outVisible)
+{
+    outVisible.clear();
+
+    const size_t nSpheres = spheres.size();
+    const size_t nBatched = nSpheres - (nSpheres % CULLING_LANE_WIDTH);
+
+    // Splat each plane's coefficients across a whole register once
+    __m128 planeA[CULLING_NUM_PLANES];
+    __m128 planeB[CULLING_NUM_PLANES];
+    __m128 planeC[CULLING_NUM_PLANES];
+    __m128 planeD[CULLING_NUM_PLANES];
+
+    for (size_t p = 0;
+                p < CULLING_NUM_PLANES;
+              ++p)
+    {
+        const plane& currPlane = frustum.getPlane(p);
+        planeA[p] = _mm_set1_ps(currPlane.a);
+        planeB[p] = _mm_set1_ps(currPlane.b);
+        planeC[p] = _mm_set1_ps(currPlane.c);
+        planeD[p] = _mm_set1_ps(currPlane.d);
+    }
+
+    const real32* xs = spheres.ss_centerX.data();
+    const real32* ys = spheres.ss_centerY.data();
+    const real32* zs = spheres.ss_centerZ.data();
+    const real32* rs = spheres.ss_radius.data();
+    const __m128  zero = _mm_setzero_ps();
+
+    for (size_t i = 0;
+                i < nBatched;
+                i += CULLING_LANE_WIDTH)
+    {
+        __m128 x = _mm_loadu_ps(xs + i);
+        __m128 y = _mm_loadu_ps(ys + i);
+        __m128 z = _mm_loadu_ps(zs + i);
+        __m128 negRadius = _mm_sub_ps(zero, _mm_loadu_ps(rs + i));
+
+        // A lane is culled as soon as its sphere lies fully
+        // behind one of the planes (dist < -radius)
+        __m128 outside = _mm_setzero_ps();
+        for (size_t p = 0;
+                    p < CULLING_NUM_PLANES;
+                  ++p)
+        {
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeA[p], x),
+                                                _mm_mul_ps(planeB[p], y)),
+                                     _mm_add_ps(_mm_mul_ps(planeC[p], z),
+                                                planeD[p]));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, negRadius));
+        }
+
+        int32 visibleMask = ~_mm_movemask_ps(outside);
+        for (size_t lane = 0;
+                    lane < CULLING_LANE_WIDTH;
+                  ++lane)
+        {
+            if ((visibleMask >> lane) & 1) outVisible.push_back(static_cast<uint32>(i + lane));
+        }
+    }
+
+    // Remaining spheres that do not fill a whole register
+    cullSpheresScalar(frustum, spheres, nBatched, outVisible);
+}
+
+void
+culling::cullSpheresScalar(const math::Frustum& frustum,
+                           const SphereSet&     spheres,
+                           const size_t         first,
+                           std::vector<uint32>& outVisible)
+{
+    for (size_t i = first;
+                i < spheres.size();
+              ++i)
+    {
+        bool outside = false;
+        for (size_t p = 0;
+                    p < CULLING_NUM_PLANES && !outside;
+                  ++p)
+        {
+            const plane& currPlane = frustum.getPlane(p);
+            real32 dist = currPlane.a * spheres.ss_centerX[i] +
+                          currPlane.b * spheres.ss_centerY[i] +
+                          currPlane.c * spheres.ss_centerZ[i] +
+                          currPlane.d;
+
+            outside = dist < -spheres.ss_radius[i];
+        }
+
+        if (!outside) outVisible.push_back(static_cast<uint32>(i));
+    }
+}
+
+culling::BenchmarkResult
+culling::benchmark(const math::Frustum& frustum,
+                   const SphereSet&     spheres,
+                   const uint32         nIterations)
+{
+    typedef std::chrono::high_resolution_clock clock;
+
+    BenchmarkResult result = {};
+    result.br_nSpheres = spheres.size();
+    if (!nIterations) return result;
+
+    // Build the per mesh geometry up front so that only the
+    // intersection tests themselves are timed
+    std::vector<math::Sphere> meshSpheres;
+    meshSpheres.reserve(spheres.size());
+    for (size_t i = 0;
+                i < spheres.size();
+              ++i)
+    {
+        meshSpheres.push_back(math::Sphere(vec3f(spheres.ss_centerX[i],
+                                                 spheres.ss_centerY[i],
+                                                 spheres.ss_centerZ[i]),
+                                           spheres.ss_radius[i]));
+    }
+
+    std::vector<uint32> visible;
+    visible.reserve(spheres.size());
+
+    // Batched SIMD path
+    auto batchedStart = clock::now();
+    for (uint32 iter = 0;
+                iter < nIterations;
+              ++iter)
+    {
+        cullSpheres(frustum, spheres, visible);
+    }
+    auto batchedEnd = clock::now();
+    result.br_nVisible = visible.size();
+
+    // Current per mesh path
+    auto perMeshStart = clock::now();
+    for (uint32 iter = 0;
+                iter < nIterations;
+              ++iter)
+    {
+        visible.clear();
+        for (size_t i = 0;
+                    i < meshSpheres.size();
+                  ++i)
+        {
+            if (!physics::intersectionTest(physics::PHYSICS_INTERSECTION_TYPE_FRUSTUMSPHERE,
+                                           &frustum,
+                                           &meshSpheres[i]))
+            {
+                visible.push_back(static_cast<uint32>(i));
+            }
+        }
+    }
+    auto perMeshEnd = clock::now();
+
+    typedef std::chrono::duration<real64, std::micro> micros;
+    result.br_batchedMicros = micros(batchedEnd - batchedStart).count() / nIterations;
+    result.br_perMeshMicros = micros(perMeshEnd - perMeshStart).count() / nIterations;
+
+    return result;
+}
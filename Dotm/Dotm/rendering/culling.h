@@ -0,0 +1,95 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        culling.h
+
+   File description: A batched visibility stage.
+   Bounding spheres of every candidate mesh are
+   laid out in SoA form and tested against the six
+   frustum planes four at a time with SSE, producing
+   a list of visible indices before any draw call
+   is submitted.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../util/math.h"
+#include "../dotmdef.h"
+#include <vector>
+
+namespace culling
+{
+    struct SphereSet
+    {
+        std::vector<real32> ss_centerX;
+        std::vector<real32> ss_centerY;
+        std::vector<real32> ss_centerZ;
+        std::vector<real32> ss_radius;
+
+        inline size_t
+        size() logical_const { return ss_radius.size(); }
+
+        inline void
+        clear()
+        {
+            ss_centerX.clear();
+            ss_centerY.clear();
+            ss_centerZ.clear();
+            ss_radius.clear();
+        }
+
+        inline void
+        push(const vec3f& center, const real32 radius)
+        {
+            ss_centerX.push_back(center.x);
+            ss_centerY.push_back(center.y);
+            ss_centerZ.push_back(center.z);
+            ss_radius.push_back(radius);
+        }
+    };
+
+    struct BenchmarkResult
+    {
+        uint32 br_nSpheres;
+        uint32 br_nVisible;
+        real64 br_batchedMicros;
+        real64 br_perMeshMicros;
+    };
+
+    // <summary>
+    // <para>
+    // Appends the indices (in push order) of all the spheres
+    // that are not fully behind any of the frustum's planes
+    // to outVisible. The output vector is cleared first.
+    // </para>
+    // </summary>
+    void
+    cullSpheres(const math::Frustum&  frustum,
+                const SphereSet&      spheres,
+                std::vector<uint32>&  outVisible);
+
+    // <summary>
+    // <para>
+    // Scalar reference implementation of cullSpheres.
+    // Used for the remaining spheres that do not fill
+    // a whole SIMD lane and for validation.
+    // </para>
+    // </summary>
+    void
+    cullSpheresScalar(const math::Frustum& frustum,
+                      const SphereSet&     spheres,
+                      const size_t         first,
+                      std::vector<uint32>& outVisible);
+
+    // <summary>
+    // <para>
+    // Times nIterations of the batched path against the
+    // per mesh physics::intersectionTest path over the
+    // same sphere set. Timings are averaged per iteration.
+    // </para>
+    // </summary>
+    BenchmarkResult
+    benchmark(const math::Frustum& frustum,
+              const SphereSet&     spheres,
+              const uint32         nIterations);
+}
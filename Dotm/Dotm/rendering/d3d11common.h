@@ -13,6 +13,7 @@
 // Necessary header inclusion
 #include <wrl\client.h>
 #include <d3d11.h>
+#include <d3d11_1.h>
 #include <dxgi.h>
 #include <dxerr.h>
 
@@ -0,0 +1,269 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        d3d11executor.cpp
+
+   File description: Implementation of the D3D11
+   command executor declared in d3d11executor.h
+   ------------------------------------------------ */
+
+#include "d3d11executor.h"
+#include "shader.h"
+#include <algorithm>
+#include <cstring>
+
+/* ---------
+   Constants
+   --------- */
+#define MIN_RING_CAPACITY     65536
+#define MIN_INSTANCE_CAPACITY 16384
+#define BYTES_PER_CONSTANT    16
+
+/* --------------
+   Public Methods
+   -------------- */
+D3D11Executor::D3D11Executor(D3D11State* d3dState):
+
+    m_d3dState(d3dState),
+    m_ringCapacity(0U),
+    m_slotCapacities(),
+    m_ringUploaded(false),
+    m_instanceCapacity(0U),
+    m_instancesUploaded(false)
+{
+    // Binding by offset needs the D3D11.1 runtime and driver
+    // support, regardless of the device's feature level
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+    if (SUCCEEDED(m_d3dState->m_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS,
+                                                            &options,
+                                                            sizeof(options))) &&
+        options.ConstantBufferOffsetting)
+    {
+        m_d3dState->m_devcon.As(&m_devcon1);
+    }
+}
+
+D3D11Executor::~D3D11Executor()
+{
+
+}
+
+void
+D3D11Executor::execute(const CommandList& commandList)
+{
+    ID3D11DeviceContext* devcon = m_d3dState->m_devcon.Get();
+    const std::vector<CommandList::Command>& commands = commandList.getCommands();
+    if (commands.empty()) return;
+
+    // Every recorded draw is a triangle list
+    devcon->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    // All the bound constants and all the instances of
+    // the list in one upload each
+    m_ringUploaded      = m_devcon1 && uploadStream(commandList.getRingData(),
+                                                    D3D11_BIND_CONSTANT_BUFFER,
+                                                    m_ringBuffer,
+                                                    m_ringCapacity);
+    m_instancesUploaded = uploadStream(commandList.getInstanceData(),
+                                       D3D11_BIND_VERTEX_BUFFER,
+                                       m_instanceBuffer,
+                                       m_instanceCapacity);
+
+    for (auto citer = commands.cbegin();
+              citer != commands.cend();
+            ++citer)
+    {
+        const CommandList::Command& command = *citer;
+
+        switch (command.c_type)
+        {
+            case CommandList::CMD_SET_SHADER:
+            {
+                const Shader* shader = static_cast<const Shader*>(command.c_handle);
+                devcon->IASetInputLayout(shader->getShaderLayout().Get());
+                devcon->VSSetShader(shader->getVertexShader().Get(), NULL, NULL);
+                devcon->PSSetShader(shader->getPixelShader().Get(), NULL, NULL);
+            } break;
+
+            case CommandList::CMD_SET_VERTEX_BUFFER:
+            {
+                ID3D11Buffer* buffer = static_cast<ID3D11Buffer*>(const_cast<void*>(command.c_handle));
+                const uint32  stride = command.c_args[1];
+                const uint32  offset = 0U;
+                devcon->IASetVertexBuffers(command.c_args[0], 1, &buffer, &stride, &offset);
+            } break;
+
+            case CommandList::CMD_SET_INDEX_BUFFER:
+            {
+                ID3D11Buffer* buffer = static_cast<ID3D11Buffer*>(const_cast<void*>(command.c_handle));
+                devcon->IASetIndexBuffer(buffer,
+                                         command.c_args[0] == sizeof(uint16) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT,
+                                         0U);
+            } break;
+
+            case CommandList::CMD_SET_INSTANCE_STREAM:
+            {
+                if (!m_instancesUploaded) break;
+                const uint32 stride = command.c_args[0];
+                const uint32 offset = 0U;
+                devcon->IASetVertexBuffers(1, 1, m_instanceBuffer.GetAddressOf(), &stride, &offset);
+            } break;
+
+            case CommandList::CMD_SET_TEXTURE:
+            {
+                ID3D11ShaderResourceView* texture = static_cast<ID3D11ShaderResourceView*>(const_cast<void*>(command.c_handle));
+                devcon->PSSetShaderResources(0, 1, &texture);
+            } break;
+
+            case CommandList::CMD_SET_SHADER_RESOURCE:
+            {
+                ID3D11ShaderResourceView* resource = static_cast<ID3D11ShaderResourceView*>(const_cast<void*>(command.c_handle));
+                devcon->PSSetShaderResources(command.c_args[0], 1, &resource);
+            } break;
+
+            case CommandList::CMD_SET_DEPTH_STATE:
+            {
+                devcon->OMSetDepthStencilState(command.c_args[0] == CommandList::DEPTH_DISABLED ?
+                                               m_d3dState->m_disabledDepth.Get() :
+                                               m_d3dState->m_enabledDepth.Get(), 1);
+            } break;
+
+            case CommandList::CMD_SET_RASTER_STATE:
+            {
+                devcon->RSSetState(command.c_args[0] == CommandList::RASTER_WIREFRAME ?
+                                   m_d3dState->m_wireFrameRastState.Get() :
+                                   m_d3dState->m_solidRastState.Get());
+            } break;
+
+            case CommandList::CMD_UPDATE_CONSTANTS:
+            {
+                ID3D11Buffer* buffer = static_cast<ID3D11Buffer*>(const_cast<void*>(command.c_handle));
+                devcon->UpdateSubresource(buffer, NULL, NULL, commandList.getConstantData(command), NULL, NULL);
+            } break;
+
+            case CommandList::CMD_BIND_CONSTANTS:
+            {
+                bindRingConstants(commandList, command);
+            } break;
+
+            case CommandList::CMD_CLEAR_DEPTH:
+            {
+                devcon->ClearDepthStencilView(m_d3dState->m_depthStencilView.Get(),
+                                              D3D11_CLEAR_DEPTH,
+                                              1.0f,
+                                              0);
+            } break;
+
+            case CommandList::CMD_DRAW_INDEXED:
+            {
+                devcon->DrawIndexed(command.c_args[0], command.c_args[1], 0);
+            } break;
+
+            case CommandList::CMD_DRAW_INDEXED_INSTANCED:
+            {
+                devcon->DrawIndexedInstanced(command.c_args[0],
+                                             command.c_args[1],
+                                             command.c_args[2],
+                                             0,
+                                             command.c_args[3]);
+            } break;
+
+            default: break;
+        }
+    }
+}
+
+/* ---------------
+   Private Methods
+   --------------- */
+bool
+D3D11Executor::uploadStream(const std::vector<uint8>& data,
+                            const uint32              bindFlags,
+                            comptr<ID3D11Buffer>&     buffer,
+                            uint32&                   capacity)
+{
+    if (data.empty()) return true;
+
+    if (data.size() > capacity)
+    {
+        // Grow geometrically so that the buffer is only
+        // recreated a handful of times
+        const uint32 minCapacity = bindFlags == D3D11_BIND_CONSTANT_BUFFER ? MIN_RING_CAPACITY :
+                                                                             MIN_INSTANCE_CAPACITY;
+        const uint32 newCapacity = std::max<uint32>(std::max<uint32>(capacity * 2U, minCapacity),
+                                                    static_cast<uint32>(data.size()));
+
+        D3D11_BUFFER_DESC streamBufferDesc = {};
+        streamBufferDesc.Usage             = D3D11_USAGE_DYNAMIC;
+        streamBufferDesc.BindFlags         = bindFlags;
+        streamBufferDesc.CPUAccessFlags    = D3D11_CPU_ACCESS_WRITE;
+        streamBufferDesc.ByteWidth         = newCapacity;
+
+        buffer.Reset();
+        capacity = 0U;
+        HR(m_d3dState->m_device->CreateBuffer(&streamBufferDesc, nullptr, &buffer));
+        if (!buffer) return false;
+        capacity = newCapacity;
+    }
+
+    // Discarding hands back fresh memory instead of waiting
+    // for the draws of the previous execution
+    D3D11_MAPPED_SUBRESOURCE mappedStream = {};
+    if (FAILED(m_d3dState->m_devcon->Map(buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedStream))) return false;
+    memcpy(mappedStream.pData, &data[0], data.size());
+    m_d3dState->m_devcon->Unmap(buffer.Get(), 0);
+    return true;
+}
+
+void
+D3D11Executor::bindRingConstants(const CommandList&          commandList,
+                                 const CommandList::Command& command)
+{
+    ID3D11DeviceContext* devcon = m_d3dState->m_devcon.Get();
+    const uint32         size   = command.c_args[1];
+    const uint32         stage  = command.c_args[2];
+    const uint32         slot   = command.c_args[3];
+
+    if (m_ringUploaded)
+    {
+        // Blocks are padded to the ring alignment, so the bound
+        // range is always a multiple of 16 constants
+        ID3D11Buffer* ring          = m_ringBuffer.Get();
+        const UINT    firstConstant = command.c_args[0] / BYTES_PER_CONSTANT;
+        const UINT    numConstants  = (size + CommandList::RING_ALIGNMENT - 1) / CommandList::RING_ALIGNMENT *
+                                      (CommandList::RING_ALIGNMENT / BYTES_PER_CONSTANT);
+
+        if (stage == CommandList::STAGE_VERTEX) m_devcon1->VSSetConstantBuffers1(slot, 1, &ring, &firstConstant, &numConstants);
+        else                                    m_devcon1->PSSetConstantBuffers1(slot, 1, &ring, &firstConstant, &numConstants);
+        return;
+    }
+
+    if (stage >= CommandList::STAGE_COUNT || slot >= MAX_CONSTANT_SLOTS) return;
+
+    comptr<ID3D11Buffer>& slotBuffer   = m_slotBuffers[stage][slot];
+    uint32&               slotCapacity = m_slotCapacities[stage][slot];
+    if (size > slotCapacity)
+    {
+        D3D11_BUFFER_DESC slotBufferDesc = {};
+        slotBufferDesc.Usage             = D3D11_USAGE_DYNAMIC;
+        slotBufferDesc.BindFlags         = D3D11_BIND_CONSTANT_BUFFER;
+        slotBufferDesc.CPUAccessFlags    = D3D11_CPU_ACCESS_WRITE;
+        slotBufferDesc.ByteWidth         = (size + BYTES_PER_CONSTANT - 1) & ~(BYTES_PER_CONSTANT - 1);
+
+        slotBuffer.Reset();
+        slotCapacity = 0U;
+        HR(m_d3dState->m_device->CreateBuffer(&slotBufferDesc, nullptr, &slotBuffer));
+        if (!slotBuffer) return;
+        slotCapacity = slotBufferDesc.ByteWidth;
+    }
+
+    // Discarding renames the buffer, so draws recorded before
+    // this bind keep reading their own data
+    D3D11_MAPPED_SUBRESOURCE mappedSlot = {};
+    if (FAILED(devcon->Map(slotBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSlot))) return;
+    memcpy(mappedSlot.pData, commandList.getConstantData(command), size);
+    devcon->Unmap(slotBuffer.Get(), 0);
+
+    if (stage == CommandList::STAGE_VERTEX) devcon->VSSetConstantBuffers(slot, 1, slotBuffer.GetAddressOf());
+    else                                    devcon->PSSetConstantBuffers(slot, 1, slotBuffer.GetAddressOf());
+}
@@ -0,0 +1,74 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        d3d11executor.h
+
+   File description: The command executor replaying
+   command lists against the D3D11 immediate
+   context. Resource handles are the COM object
+   pointers the renderer recorded, and shader
+   handles are Shader instances.
+
+   The constant ring is uploaded with a single
+   discarding map per execution and bound by offset
+   where the runtime supports it (D3D11.1). On
+   older runtimes every bind falls back to mapping
+   a small dynamic buffer per stage and slot. The
+   instance stream gets its own dynamic vertex
+   buffer, uploaded the same way as the ring.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "commandlist.h"
+#include "d3d11state.h"
+
+class D3D11Executor: public CommandExecutor
+{
+public:
+
+    D3D11Executor(D3D11State* d3dState);
+
+    ~D3D11Executor();
+
+    D3D11Executor(const D3D11Executor& rhs) = delete;
+
+    D3D11Executor&
+    operator = (const D3D11Executor& rhs) = delete;
+
+    void
+    execute(const CommandList& commandList) override;
+
+private:
+
+    // Writes the data into the dynamic buffer with a discarding
+    // map, growing the buffer first if needed. Returns false if
+    // the buffer could not be created or mapped
+    bool
+    uploadStream(const std::vector<uint8>& data,
+                 const uint32              bindFlags,
+                 comptr<ID3D11Buffer>&     buffer,
+                 uint32&                   capacity);
+
+    void
+    bindRingConstants(const CommandList&          commandList,
+                      const CommandList::Command& command);
+
+private:
+
+    static const uint32 MAX_CONSTANT_SLOTS = 4U;
+
+private:
+
+    D3D11State*                   m_d3dState;
+    comptr<ID3D11DeviceContext1>  m_devcon1;
+    comptr<ID3D11Buffer>          m_ringBuffer;
+    uint32                        m_ringCapacity;
+    comptr<ID3D11Buffer>          m_slotBuffers[CommandList::STAGE_COUNT][MAX_CONSTANT_SLOTS];
+    uint32                        m_slotCapacities[CommandList::STAGE_COUNT][MAX_CONSTANT_SLOTS];
+    bool                          m_ringUploaded;
+    comptr<ID3D11Buffer>          m_instanceBuffer;
+    uint32                        m_instanceCapacity;
+    bool                          m_instancesUploaded;
+
+};
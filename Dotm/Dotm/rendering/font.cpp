@@ -9,7 +9,6 @@
 
 #include "font.h"
 #include "texture.h"
-#include "mesh.h"
 #include "../util/stringutils.h"
 #include <fstream>
 #include <string>
@@ -21,6 +20,7 @@ Font::Font(cstring fontName,
            real32  fontSize):
 
            m_fontName(internString(fontName)),
+           m_glyphTable(),
            m_fontSize(fontSize)
 {
     loadTexture();
@@ -31,25 +31,22 @@ Font::~Font()
 {    
 }
 
-std::shared_ptr<Mesh>
-Font::getGlyph(uint8 chr) 
+const textbatch::GlyphTable&
+Font::getGlyphTable() logical_const
 {
-    if(m_glyphs.count(chr)) return m_glyphs[chr];
-    return nullptr;
+    return m_glyphTable;
+}
+
+std::shared_ptr<Texture>
+Font::getTexture() logical_const
+{
+    return m_fontTexture;
 }
 
 void
 Font::setSize(const real32 size)
 {
     m_fontSize = size;
-    for (auto iter = m_glyphs.begin();
-              iter != m_glyphs.end();
-            ++iter)
-    {
-        iter->second->scale = vec3f(m_fontSize,
-                                    m_fontSize,
-                                    m_fontSize);          
-    }
 }
 
 real32
@@ -108,8 +105,8 @@ Font::loadGlyphs()
         glyphChars.clear();
         string_utils::split(line, ' ', glyphChars);
         
-        // Iterate through the glyphs and create
-        // the respective mesh
+        // Iterate through the glyphs and record
+        // their atlas boxes
         for (auto citer = glyphChars.cbegin();
                   citer != glyphChars.cend();
                 ++citer)
@@ -117,18 +114,10 @@ Font::loadGlyphs()
             uint8 currChar = citer->at(0);
             
             // Tex coord calculation
-            vec2f customTexCoords[] = { vec2f( xCoord / texWidth,            yCoord / texHeight),
-                                        vec2f((xCoord + boxSize) / texWidth, yCoord / texHeight),
-                                        vec2f((xCoord + boxSize) / texWidth, (yCoord + boxSize) / texHeight),
-                                        vec2f( xCoord / texWidth,            (yCoord + boxSize) / texHeight) };            
-            
-            std::shared_ptr<Mesh> glyph(new Mesh("sample_plane",
-                                                 Mesh::MESH_EXTERNAL_TEXCOORDS | Mesh::MESH_TYPE_HUD,
-                                                 customTexCoords,
-                                                 ARRAYSIZE(customTexCoords)));
-                                    
-            glyph->setTexture(m_fontTexture);            
-            m_glyphs[currChar] = glyph;
+            textbatch::GlyphRect& rect = m_glyphTable.gt_glyphs[currChar];
+            rect.gr_minTexCoord = vec2f( xCoord / texWidth,             yCoord / texHeight);
+            rect.gr_maxTexCoord = vec2f((xCoord + boxSize) / texWidth, (yCoord + boxSize) / texHeight);
+            rect.gr_valid       = true;
             xCoord += boxSize;
         }
         xCoord  = 0U;
@@ -5,18 +5,19 @@
    
    File description: A class encapsulating 
    the properties of a font family ready 
-   for rendering
+   for rendering. Glyphs are boxes in the font's
+   atlas texture, drawn in batches by the renderer
+   (see textbatch.h)
    ------------------------------------------ */
 
 #pragma once
 
+#include "textbatch.h"
 #include "../util/strings.h"
 #include "../dotmdef.h"
 #include <memory>
-#include <unordered_map>
 
 class Texture;
-class Mesh;
 class Font
 {
 
@@ -29,8 +30,11 @@ public:
 
     ~Font();
 
-    std::shared_ptr<Mesh>
-    getGlyph(uint8 chr);
+    const textbatch::GlyphTable&
+    getGlyphTable() logical_const;
+
+    std::shared_ptr<Texture>
+    getTexture() logical_const;
 
     void
     setSize(const real32 size);
@@ -48,9 +52,9 @@ private:
 
 private:
 
-    stringID                                         m_fontName;
-    std::shared_ptr<Texture>                         m_fontTexture;
-    std::unordered_map<uint8, std::shared_ptr<Mesh>> m_glyphs;
-    real32                                           m_fontSize;
+    stringID                 m_fontName;
+    std::shared_ptr<Texture> m_fontTexture;
+    textbatch::GlyphTable    m_glyphTable;
+    real32                   m_fontSize;
 
 };
@@ -0,0 +1,81 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        instancing.cpp
+
+   File description: Implementation of the instance
+   grouping functions declared in instancing.h
+   ------------------------------------------------ */
+
+#include "instancing.h"
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static bool
+sharesDrawState(const instancing::InstanceInput& a,
+                const instancing::InstanceInput& b);
+
+/* ---------
+   Constants
+   --------- */
+#define INSTANCING_LOD_BITS 8
+
+/* ----------------
+   Public Functions
+   ---------------- */
+ullong64
+instancing::makeGroupKey(const ullong64 sortKey,
+                         const uint32   lod)
+{
+    const ullong64 stateKey = sortKey >> renderqueue::KEY_DEPTH_BITS;
+    return (stateKey << INSTANCING_LOD_BITS) | (lod & ((1U << INSTANCING_LOD_BITS) - 1U));
+}
+
+void
+instancing::buildGroups(const std::vector<InstanceInput>& inputs,
+                        const uint32                      maxGroupSize,
+                        std::vector<InstanceData>&        outInstances,
+                        std::vector<InstanceGroup>&       outGroups)
+{
+    outInstances.clear();
+    outGroups.clear();
+    if (inputs.empty() || !maxGroupSize) return;
+
+    outInstances.reserve(inputs.size());
+
+    size_t groupStart = 0;
+    for (size_t i = 0;
+                i < inputs.size();
+              ++i)
+    {
+        const InstanceInput& input = inputs[i];
+
+        if (outGroups.empty()                                  ||
+            !sharesDrawState(input, inputs[groupStart])        ||
+            outGroups.back().ig_nInstances >= maxGroupSize)
+        {
+            InstanceGroup group = {};
+            group.ig_itemIndex     = input.ii_itemIndex;
+            group.ig_firstInstance = static_cast<uint32>(outInstances.size());
+            outGroups.push_back(group);
+            groupStart = i;
+        }
+
+        outInstances.push_back(input.ii_data);
+        ++outGroups.back().ig_nInstances;
+    }
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static bool
+sharesDrawState(const instancing::InstanceInput& a,
+                const instancing::InstanceInput& b)
+{
+    return a.ii_groupKey == b.ii_groupKey &&
+           a.ii_mesh     == b.ii_mesh     &&
+           a.ii_texture  == b.ii_texture  &&
+           a.ii_shader   == b.ii_shader;
+}
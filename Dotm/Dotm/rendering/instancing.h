@@ -0,0 +1,81 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        instancing.h
+
+   File description: CPU side grouping for the
+   instanced rendering path. Draws that share their
+   mesh, texture, shader and level of detail are
+   packed back to back into one instance array, so
+   that every group is issued as a single
+   DrawIndexedInstanced call. Nothing here touches
+   the GPU.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "renderqueue.h"
+#include "../util/math.h"
+#include "../dotmdef.h"
+#include <vector>
+
+namespace instancing
+{
+    // Per instance vertex data, bound to the second input slot.
+    // The world matrix arrives as four row vectors (WORLD0-3) to
+    // be multiplied as mul(position, world), followed by the
+    // highlight option (HIGHLIGHT)
+    struct InstanceData
+    {
+        mat4x4 id_worldMatrix;
+        int32  id_highlight;
+        int32  _padding[3];
+    };
+
+    // Draws sharing ii_groupKey may share a draw call. Sort IDs
+    // can collide, so the mesh, texture and shader objects the
+    // draw binds must be equal as well; they are only compared,
+    // never dereferenced
+    struct InstanceInput
+    {
+        ullong64     ii_groupKey;
+        const void*  ii_mesh;
+        const void*  ii_texture;
+        const void*  ii_shader;
+        uint32       ii_itemIndex;
+        InstanceData ii_data;
+    };
+
+    // A contiguous range of the packed instance array.
+    // ig_itemIndex is the ii_itemIndex of the group's first input
+    struct InstanceGroup
+    {
+        uint32 ig_itemIndex;
+        uint32 ig_firstInstance;
+        uint32 ig_nInstances;
+    };
+
+    // Builds a group key from a render queue sort key, ignoring
+    // its depth so that draws only differing in depth group
+    // together, and a level of detail
+    ullong64
+    makeGroupKey(const ullong64 sortKey,
+                 const uint32   lod);
+
+    // <summary>
+    // <para>
+    // Splits the inputs into runs of equal group keys and bound
+    // objects, of at most maxGroupSize instances each, and packs
+    // their instance data into outInstances in input order. Inputs
+    // are expected sorted (see renderqueue::sortItems) so that equal
+    // keys are adjacent; unsorted inputs still render correctly,
+    // only in more groups.
+    // Both output vectors are cleared first.
+    // </para>
+    // </summary>
+    void
+    buildGroups(const std::vector<InstanceInput>& inputs,
+                const uint32                      maxGroupSize,
+                std::vector<InstanceData>&        outInstances,
+                std::vector<InstanceGroup>&       outGroups);
+}
@@ -0,0 +1,226 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        lightcluster.cpp
+
+   File description: Implementation of the light
+   clustering functions declared in lightcluster.h
+   ------------------------------------------------ */
+
+#include "lightcluster.h"
+#include <algorithm>
+#include <chrono>
+
+/* ---------
+   Constants
+   --------- */
+#define CLUSTER_BOUNDS_CULLED 0xFFFFFFFFU
+#define CLUSTER_BOUNDS_BITS   8
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static uint32
+getSlice(const lightcluster::ClusterParams& params,
+         const real32                       viewZ);
+
+static uint32
+getTile(const real32 ndc,
+        const uint32 nTiles,
+        const bool   flip);
+
+/* ----------------
+   Public Functions
+   ---------------- */
+lightcluster::ClusterParams
+lightcluster::makeParams(const real32 viewportWidth,
+                         const real32 viewportHeight,
+                         const real32 zNear,
+                         const real32 zFar)
+{
+    // Exponential slices keep clusters roughly cubic along
+    // the view direction
+    const real32 logRatio = std::log(zFar / zNear);
+
+    ClusterParams params = {};
+    params.cp_tileScaleX = CLUSTER_TILES_X / viewportWidth;
+    params.cp_tileScaleY = CLUSTER_TILES_Y / viewportHeight;
+    params.cp_sliceScale = CLUSTER_SLICES / logRatio;
+    params.cp_sliceBias  = -(CLUSTER_SLICES * std::log(zNear)) / logRatio;
+    params.cp_zNear      = zNear;
+    params.cp_zFar       = zFar;
+    params.cp_tilesX     = CLUSTER_TILES_X;
+    params.cp_tilesY     = CLUSTER_TILES_Y;
+    params.cp_slices     = CLUSTER_SLICES;
+    return params;
+}
+
+void
+lightcluster::assignLights(const ClusterParams&             params,
+                           const mat4x4&                    viewMatrix,
+                           const mat4x4&                    projMatrix,
+                           const std::vector<ClusterLight>& lights,
+                           ClusterGrid&                     outGrid)
+{
+    const size_t nLights = lights.size();
+
+    outGrid.cg_clusterRanges.assign(CLUSTER_COUNT * 2U, 0U);
+    outGrid.cg_lightBounds.resize(nLights * 2U);
+    outGrid.cg_nAssignments        = 0U;
+    outGrid.cg_nDroppedAssignments = 0U;
+
+    // First pass: the cluster bounds of every light and the
+    // number of lights per cluster, capped
+    for (size_t i = 0;
+                i < nLights;
+              ++i)
+    {
+        const ClusterLight& light = lights[i];
+        uint32* bounds = &outGrid.cg_lightBounds[i * 2U];
+        bounds[1] = CLUSTER_BOUNDS_CULLED;
+
+        const vec3f& p  = light.cl_position;
+        const real32 r  = light.cl_range;
+        const real32 vx = p.x * viewMatrix._11 + p.y * viewMatrix._21 + p.z * viewMatrix._31 + viewMatrix._41;
+        const real32 vy = p.x * viewMatrix._12 + p.y * viewMatrix._22 + p.z * viewMatrix._32 + viewMatrix._42;
+        const real32 vz = p.x * viewMatrix._13 + p.y * viewMatrix._23 + p.z * viewMatrix._33 + viewMatrix._43;
+
+        const real32 zMin = vz - r;
+        const real32 zMax = vz + r;
+        if (r <= 0.0f || zMax <= params.cp_zNear || zMin >= params.cp_zFar) continue;
+
+        uint32 tileMinX = 0U, tileMaxX = CLUSTER_TILES_X - 1U;
+        uint32 tileMinY = 0U, tileMaxY = CLUSTER_TILES_Y - 1U;
+
+        // Spheres crossing the near plane may cover any tile.
+        // Otherwise x / z over the sphere's bounding box is
+        // extremized at its corners, which bounds the projection
+        if (zMin > params.cp_zNear)
+        {
+            const real32 ndcMinX = projMatrix._11 * (vx - r) / (vx - r < 0.0f ? zMin : zMax);
+            const real32 ndcMaxX = projMatrix._11 * (vx + r) / (vx + r > 0.0f ? zMin : zMax);
+            const real32 ndcMinY = projMatrix._22 * (vy - r) / (vy - r < 0.0f ? zMin : zMax);
+            const real32 ndcMaxY = projMatrix._22 * (vy + r) / (vy + r > 0.0f ? zMin : zMax);
+            if (ndcMinX > 1.0f || ndcMaxX < -1.0f ||
+                ndcMinY > 1.0f || ndcMaxY < -1.0f) continue;
+
+            // Screen rows grow downwards
+            tileMinX = getTile(ndcMinX, CLUSTER_TILES_X, false);
+            tileMaxX = getTile(ndcMaxX, CLUSTER_TILES_X, false);
+            tileMinY = getTile(ndcMaxY, CLUSTER_TILES_Y, true);
+            tileMaxY = getTile(ndcMinY, CLUSTER_TILES_Y, true);
+        }
+
+        const uint32 sliceMin = getSlice(params, std::max(zMin, params.cp_zNear));
+        const uint32 sliceMax = getSlice(params, std::min(zMax, params.cp_zFar));
+
+        bounds[0] = tileMinX | (tileMaxX << CLUSTER_BOUNDS_BITS) |
+                    (tileMinY << (CLUSTER_BOUNDS_BITS * 2)) | (tileMaxY << (CLUSTER_BOUNDS_BITS * 3));
+        bounds[1] = sliceMin | (sliceMax << CLUSTER_BOUNDS_BITS);
+
+        for (uint32 slice = sliceMin; slice <= sliceMax; ++slice)
+        for (uint32 y     = tileMinY; y     <= tileMaxY; ++y)
+        for (uint32 x     = tileMinX; x     <= tileMaxX; ++x)
+        {
+            uint32& count = outGrid.cg_clusterRanges[((slice * CLUSTER_TILES_Y + y) * CLUSTER_TILES_X + x) * 2U + 1U];
+            if (count < MAX_LIGHTS_PER_CLUSTER) ++count;
+            else                                ++outGrid.cg_nDroppedAssignments;
+        }
+    }
+
+    // Cluster offsets into the compact index list
+    uint32 offset = 0U;
+    for (uint32 cluster = 0;
+                cluster < CLUSTER_COUNT;
+              ++cluster)
+    {
+        outGrid.cg_clusterRanges[cluster * 2U] = offset;
+        offset += outGrid.cg_clusterRanges[cluster * 2U + 1U];
+    }
+    outGrid.cg_nAssignments = offset;
+    outGrid.cg_lightIndices.resize(offset);
+
+    // Second pass: the same traversal fills the lists, so the
+    // lights kept in full clusters are the ones counted first
+    outGrid.cg_clusterFill.assign(CLUSTER_COUNT, 0U);
+    for (size_t i = 0;
+                i < nLights;
+              ++i)
+    {
+        const uint32* bounds = &outGrid.cg_lightBounds[i * 2U];
+        if (bounds[1] == CLUSTER_BOUNDS_CULLED) continue;
+
+        const uint32 mask     = (1U << CLUSTER_BOUNDS_BITS) - 1U;
+        const uint32 tileMinX =  bounds[0]                               & mask;
+        const uint32 tileMaxX = (bounds[0] >>  CLUSTER_BOUNDS_BITS)      & mask;
+        const uint32 tileMinY = (bounds[0] >> (CLUSTER_BOUNDS_BITS * 2)) & mask;
+        const uint32 tileMaxY = (bounds[0] >> (CLUSTER_BOUNDS_BITS * 3)) & mask;
+        const uint32 sliceMin =  bounds[1]                               & mask;
+        const uint32 sliceMax = (bounds[1] >>  CLUSTER_BOUNDS_BITS)      & mask;
+
+        for (uint32 slice = sliceMin; slice <= sliceMax; ++slice)
+        for (uint32 y     = tileMinY; y     <= tileMaxY; ++y)
+        for (uint32 x     = tileMinX; x     <= tileMaxX; ++x)
+        {
+            const uint32 cluster = (slice * CLUSTER_TILES_Y + y) * CLUSTER_TILES_X + x;
+            uint32&      fill    = outGrid.cg_clusterFill[cluster];
+            if (fill >= outGrid.cg_clusterRanges[cluster * 2U + 1U]) continue;
+
+            outGrid.cg_lightIndices[outGrid.cg_clusterRanges[cluster * 2U] + fill] = static_cast<uint32>(i);
+            ++fill;
+        }
+    }
+}
+
+lightcluster::BenchmarkResult
+lightcluster::benchmark(const ClusterParams&             params,
+                        const mat4x4&                    viewMatrix,
+                        const mat4x4&                    projMatrix,
+                        const std::vector<ClusterLight>& lights,
+                        const uint32                     nIterations)
+{
+    typedef std::chrono::high_resolution_clock clock;
+
+    BenchmarkResult result = {};
+    result.br_nLights = static_cast<uint32>(lights.size());
+    if (!nIterations) return result;
+
+    ClusterGrid grid = {};
+    auto assignStart = clock::now();
+    for (uint32 iter = 0;
+                iter < nIterations;
+              ++iter)
+    {
+        assignLights(params, viewMatrix, projMatrix, lights, grid);
+    }
+    auto assignEnd = clock::now();
+
+    typedef std::chrono::duration<real64, std::micro> micros;
+    result.br_assignMicros        = micros(assignEnd - assignStart).count() / nIterations;
+    result.br_nAssignments        = grid.cg_nAssignments;
+    result.br_nDroppedAssignments = grid.cg_nDroppedAssignments;
+    return result;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static uint32
+getSlice(const lightcluster::ClusterParams& params,
+         const real32                       viewZ)
+{
+    const real32 slice = std::floor(std::log(viewZ) * params.cp_sliceScale + params.cp_sliceBias);
+    if (slice <= 0.0f) return 0U;
+    return std::min(static_cast<uint32>(slice), lightcluster::CLUSTER_SLICES - 1U);
+}
+
+static uint32
+getTile(const real32 ndc,
+        const uint32 nTiles,
+        const bool   flip)
+{
+    const real32 unit = flip ? 0.5f - ndc * 0.5f : ndc * 0.5f + 0.5f;
+    const real32 tile = std::floor(unit * nTiles);
+    if (tile <= 0.0f) return 0U;
+    return std::min(static_cast<uint32>(tile), nTiles - 1U);
+}
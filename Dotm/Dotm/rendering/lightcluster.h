@@ -0,0 +1,122 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        lightcluster.h
+
+   File description: CPU side clustered light
+   assignment. The view frustum is split into
+   screen tiles times exponential depth slices,
+   and every point light is assigned to the
+   clusters its range sphere may touch. The result
+   is a compact light index list per cluster, which
+   the clustered pixel shaders walk for their own
+   cluster only, so that hundreds of lights can be
+   active at a bounded per pixel cost. Nothing
+   here touches the GPU, so assignment can be
+   benchmarked headlessly (see tools/clusterbench).
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../util/math.h"
+#include "../dotmdef.h"
+#include <vector>
+
+namespace lightcluster
+{
+    static const uint32 CLUSTER_TILES_X        = 16U;
+    static const uint32 CLUSTER_TILES_Y        = 9U;
+    static const uint32 CLUSTER_SLICES         = 24U;
+    static const uint32 CLUSTER_COUNT          = CLUSTER_TILES_X * CLUSTER_TILES_Y * CLUSTER_SLICES;
+
+    // The per pixel cost bound: assignments beyond this many
+    // lights in a cluster are dropped
+    static const uint32 MAX_LIGHTS_PER_CLUSTER = 32U;
+
+    // Same layout as Shader::PointLight, the element of the
+    // clustered shaders' light buffer
+    struct ClusterLight
+    {
+        vec4f  cl_ambientColor;
+        vec4f  cl_diffuseColor;
+        vec3f  cl_position;
+        real32 cl_range;
+    };
+
+    // <summary>
+    // <para>
+    // The grid parameters, also bound as the second pixel constant
+    // buffer of the clustered shaders. A pixel's cluster is found
+    // from its SV_Position as:
+    // tile  = floor(position.xy * cp_tileScale)
+    // slice = floor(log(position.w) * cp_sliceScale + cp_sliceBias)
+    // index = (slice * cp_tilesY + tile.y) * cp_tilesX + tile.x
+    // </para>
+    // </summary>
+    struct ClusterParams
+    {
+        real32 cp_tileScaleX;
+        real32 cp_tileScaleY;
+        real32 cp_sliceScale;
+        real32 cp_sliceBias;
+        real32 cp_zNear;
+        real32 cp_zFar;
+        uint32 cp_tilesX;
+        uint32 cp_tilesY;
+        uint32 cp_slices;
+        uint32 _padding[3];
+    };
+
+    // cg_clusterRanges holds an (offset, count) pair per cluster
+    // into cg_lightIndices, which index into the assigned lights
+    struct ClusterGrid
+    {
+        std::vector<uint32> cg_clusterRanges;
+        std::vector<uint32> cg_lightIndices;
+        uint32              cg_nAssignments;
+        uint32              cg_nDroppedAssignments;
+
+        // Scratch kept between the two assignment passes
+        std::vector<uint32> cg_lightBounds;
+        std::vector<uint32> cg_clusterFill;
+    };
+
+    struct BenchmarkResult
+    {
+        uint32 br_nLights;
+        uint32 br_nAssignments;
+        uint32 br_nDroppedAssignments;
+        real64 br_assignMicros;
+    };
+
+    ClusterParams
+    makeParams(const real32 viewportWidth,
+               const real32 viewportHeight,
+               const real32 zNear,
+               const real32 zFar);
+
+    // <summary>
+    // <para>
+    // Assigns the lights (in world space) to the clusters of the
+    // view. Lights are tested with the view space bounding box of
+    // their range sphere, projected conservatively, so a light may
+    // be assigned to a few clusters its sphere misses but never
+    // misses one it touches. The grid's vectors are reused across
+    // calls.
+    // </para>
+    // </summary>
+    void
+    assignLights(const ClusterParams&             params,
+                 const mat4x4&                    viewMatrix,
+                 const mat4x4&                    projMatrix,
+                 const std::vector<ClusterLight>& lights,
+                 ClusterGrid&                     outGrid);
+
+    // Times nIterations of assignLights, averaged per iteration
+    BenchmarkResult
+    benchmark(const ClusterParams&             params,
+              const mat4x4&                    viewMatrix,
+              const mat4x4&                    projMatrix,
+              const std::vector<ClusterLight>& lights,
+              const uint32                     nIterations);
+}
@@ -19,6 +19,7 @@
 class Entity;
 class Texture;
 class Scene;
+struct MeshCachedData;
 class Mesh
 {
 public:
@@ -37,6 +38,7 @@ public:
     static const uint32 MESH_LOAD_SAME_TEXTURE  = 0x04;
     static const uint32 MESH_EXTERNAL_TEXCOORDS = 0x08;
     static const uint32 MESH_TYPE_BILLBOARD     = 0x10;
+    static const uint32 MESH_LOAD_ASYNC         = 0x20;
 
 private:
 
@@ -51,6 +53,9 @@ public:
     // will attempt to remove itself from that scene during destruction
     // If the MESH_EXTERNAL_TEXCOORDS flag is set,
     // the method expects a valid array of vec2f and its size.    
+    // If the MESH_LOAD_ASYNC flag is set, the mesh file is streamed
+    // in the background and the mesh renders the placeholder
+    // mesh until its data is ready.
     // </para>
     // </summary>
     Mesh(cstring meshName,
@@ -58,6 +63,13 @@ public:
          vec2f*  optExternalCoords  = nullptr,
          uint32  optNExternalCoords = 0U);
 
+    // Cached meshes (and their textures) are found by the
+    // precomputed ID alone
+    Mesh(const HashedString& meshName,
+         uint32              meshCreationFlags,
+         vec2f*              optExternalCoords  = nullptr,
+         uint32              optNExternalCoords = 0U);
+
     ~Mesh();
 
     Mesh(const Mesh& rhs);
@@ -101,6 +113,41 @@ public:
     comptr<ID3D11Buffer>
     getIndexBuffer() bitwise_const;
 
+    DXGI_FORMAT
+    getIndexFormat() logical_const;
+
+    uint32
+    getVertexStride() logical_const;
+
+    // Whether the vertex buffer holds compact vertices, which need
+    // the dequantization matrix applied before the world matrix
+    bool
+    hasCompactVertices() logical_const;
+
+    mat4x4
+    getDequantizationMatrix() logical_const;
+
+    // Number of levels of detail, the full detail one included
+    uint32
+    getLodCount() logical_const;
+
+    // <summary>
+    // <para>
+    // Returns the coarsest level of detail whose error stays within
+    // maxPixelError pixels, when the mesh's largest dimension covers
+    // projectedPixels pixels on screen.
+    // </para>
+    // </summary>
+    uint32
+    selectLod(const real32 projectedPixels,
+              const real32 maxPixelError) logical_const;
+
+    // The range of the index buffer drawn for the given level
+    void
+    getLodIndices(const uint32 lod,
+                  uint32&      outIndexOffset,
+                  uint32&      outIndexCount) logical_const;
+
     Shader::VSCBuffer*
     getSpecialVCBuffer() bitwise_const;
 
@@ -110,14 +157,19 @@ public:
     vec3f
     calculateDimensions() logical_const;
 
+    bool
+    isReady() logical_const;
+
     std::shared_ptr<Texture>
     getTexture() bitwise_const;
     
-    math::Geometry&
-    getCollidableGeometry() bitwise_const;
+    // Computed on every call rather than cached in the mesh, so
+    // that meshes shared between update jobs are only read
+    math::Sphere
+    getCollidableGeometry() logical_const;
 
-    math::Geometry&
-    getVisibleGeometry() bitwise_const;
+    math::Sphere
+    getVisibleGeometry() logical_const;
 
     bool
     isHighlighted() logical_const;
@@ -143,6 +195,9 @@ private:
     createMesh(vec2f*  optTexCoords,               
                uint32  optNTexCoords);
 
+    const MeshCachedData&
+    getRenderData() logical_const;
+
 public: 
     // the prefix m_ in the public fields is intentionally not added
     // to enable faster field accessing and a struct like use    
@@ -152,17 +207,11 @@ private:
 
     stringID m_name;
     uint32   m_meshFlags;
-    uint32   m_indexCount;    
-    vec3f    m_dimensions;
     bool     m_highlighted;    
     bool     m_noLighting;
 
     Shader::VSCBuffer*       m_specialVCBuffer;
     Shader::PSCBuffer*       m_specialPCBuffer;
-    comptr<ID3D11Buffer>     m_vertexBuffer;
-    comptr<ID3D11Buffer>     m_indexBuffer;
-    std::shared_ptr<Texture> m_texture;
-    
-    mutable math::Sphere m_collSPhere;
-    mutable math::Sphere m_visiSphere;
+    std::shared_ptr<MeshCachedData> m_data;
+    std::shared_ptr<Texture>        m_texture;
 };
\ No newline at end of file
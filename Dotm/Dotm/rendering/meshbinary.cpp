@@ -0,0 +1,160 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshbinary.cpp
+
+   File description: Implementation of the binary
+   mesh format functions declared in meshbinary.h
+   ------------------------------------------------ */
+
+#include "meshbinary.h"
+#include <cstring>
+#include <fstream>
+
+/* ---------
+   Constants
+   --------- */
+#define MB_MAGIC              0x48534D44 // "DMSH"
+#define MB_VERSION            2
+#define MB_BLOB_ALIGNMENT     16
+#define MB_FLAG_SHORT_INDICES 0x01
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static inline uint32
+alignUp(const uint32 value);
+
+/* --------------
+   Public Methods
+   -------------- */
+bool
+meshbin::writeFile(const std::string&               path,
+                   const std::vector<Mesh::Vertex>& vertices,
+                   const std::vector<uint32>&       indices,
+                   const std::vector<LodRange>&     lods,
+                   const vec3f&                     dimensions,
+                   size_t*                          optBytesWritten /* nullptr */)
+{
+    if (vertices.empty() || indices.empty()) return false;
+
+    const bool   shortIndices = vertices.size() <= 0xFFFF;
+    const uint32 indexSize    = shortIndices ? sizeof(uint16) : sizeof(uint32);
+
+    std::vector<LodRange> lodTable(lods);
+    if (lodTable.empty())
+    {
+        LodRange fullRange = { 0U, static_cast<uint32>(indices.size()), 0.0f, 0U };
+        lodTable.push_back(fullRange);
+    }
+
+    FileHeader header = {};
+    header.fh_magic         = MB_MAGIC;
+    header.fh_version       = MB_VERSION;
+    header.fh_flags         = shortIndices ? MB_FLAG_SHORT_INDICES : 0U;
+    header.fh_vertexStride  = sizeof(Mesh::Vertex);
+    header.fh_nVertices     = vertices.size();
+    header.fh_nIndices      = indices.size();
+    header.fh_nLods         = lodTable.size();
+    header.fh_lodOffset     = alignUp(sizeof(FileHeader));
+    header.fh_vertexOffset  = alignUp(header.fh_lodOffset + sizeof(LodRange) * header.fh_nLods);
+    header.fh_indexOffset   = alignUp(header.fh_vertexOffset + header.fh_vertexStride * header.fh_nVertices);
+    header.fh_dimensions[0] = dimensions.x;
+    header.fh_dimensions[1] = dimensions.y;
+    header.fh_dimensions[2] = dimensions.z;
+
+    // Assemble the whole file in memory so that it is written in one go
+    std::vector<uint8> fileData(header.fh_indexOffset + indexSize * header.fh_nIndices, 0U);
+    memcpy(&fileData[0], &header, sizeof(FileHeader));
+    memcpy(&fileData[header.fh_lodOffset], &lodTable[0], sizeof(LodRange) * header.fh_nLods);
+    memcpy(&fileData[header.fh_vertexOffset], &vertices[0], header.fh_vertexStride * header.fh_nVertices);
+
+    if (shortIndices)
+    {
+        uint16* shortIndexData = reinterpret_cast<uint16*>(&fileData[header.fh_indexOffset]);
+        for (size_t i = 0;
+                    i < indices.size();
+                  ++i)
+        {
+            shortIndexData[i] = static_cast<uint16>(indices[i]);
+        }
+    }
+    else
+    {
+        memcpy(&fileData[header.fh_indexOffset], &indices[0], indexSize * header.fh_nIndices);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    if (!file.write(reinterpret_cast<const char*>(&fileData[0]), fileData.size())) return false;
+
+    if (optBytesWritten) *optBytesWritten = fileData.size();
+    return true;
+}
+
+bool
+meshbin::readView(const uint8* data,
+                  const size_t size,
+                  MeshView&    outView)
+{
+    if (!data || size < sizeof(FileHeader)) return false;
+
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+    if (header->fh_magic        != MB_MAGIC   ||
+        header->fh_version      != MB_VERSION ||
+        header->fh_vertexStride != sizeof(Mesh::Vertex)) return false;
+
+    if (!header->fh_nVertices || !header->fh_nIndices || !header->fh_nLods) return false;
+
+    const bool   shortIndices = (header->fh_flags & MB_FLAG_SHORT_INDICES) != 0;
+    const size_t indexSize    = shortIndices ? sizeof(uint16) : sizeof(uint32);
+    const size_t vertexBytes  = static_cast<size_t>(header->fh_vertexStride) * header->fh_nVertices;
+    const size_t indexBytes   = indexSize * header->fh_nIndices;
+    const size_t lodBytes     = sizeof(LodRange) * header->fh_nLods;
+
+    // Blobs must be aligned and lie entirely within the file
+    if (header->fh_lodOffset    % MB_BLOB_ALIGNMENT != 0 ||
+        header->fh_vertexOffset % MB_BLOB_ALIGNMENT != 0 ||
+        header->fh_indexOffset  % MB_BLOB_ALIGNMENT != 0) return false;
+
+    if (header->fh_lodOffset < sizeof(FileHeader)                    ||
+        header->fh_lodOffset > size                                  ||
+        lodBytes > size - header->fh_lodOffset                       ||
+        header->fh_vertexOffset < header->fh_lodOffset + lodBytes    ||
+        header->fh_vertexOffset > size                               ||
+        vertexBytes > size - header->fh_vertexOffset                 ||
+        header->fh_indexOffset < header->fh_vertexOffset + vertexBytes ||
+        header->fh_indexOffset > size                                ||
+        indexBytes > size - header->fh_indexOffset) return false;
+
+    const LodRange* lods = reinterpret_cast<const LodRange*>(data + header->fh_lodOffset);
+    for (uint32 i = 0;
+                i < header->fh_nLods;
+              ++i)
+    {
+        if (lods[i].lr_indexCount % 3 != 0                      ||
+            lods[i].lr_indexOffset > header->fh_nIndices        ||
+            lods[i].lr_indexCount > header->fh_nIndices - lods[i].lr_indexOffset) return false;
+    }
+
+    outView.mv_vertices     = reinterpret_cast<const Mesh::Vertex*>(data + header->fh_vertexOffset);
+    outView.mv_indices      = data + header->fh_indexOffset;
+    outView.mv_lods         = lods;
+    outView.mv_nVertices    = header->fh_nVertices;
+    outView.mv_nIndices     = header->fh_nIndices;
+    outView.mv_nLods        = header->fh_nLods;
+    outView.mv_shortIndices = shortIndices;
+    outView.mv_dimensions   = vec3f(header->fh_dimensions[0],
+                                    header->fh_dimensions[1],
+                                    header->fh_dimensions[2]);
+    return true;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static inline uint32
+alignUp(const uint32 value)
+{
+    return (value + MB_BLOB_ALIGNMENT - 1) & ~(MB_BLOB_ALIGNMENT - 1);
+}
@@ -0,0 +1,92 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshbinary.h
+
+   File description: The versioned binary mesh
+   format produced by the mesh cooker. A fixed
+   header holding the counts and bounding dimensions
+   is followed by the level of detail table and the
+   vertex and index blobs, each aligned so that a
+   memory mapped file can be handed to buffer
+   creation without any copy.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "mesh.h"
+#include "../dotmdef.h"
+#include <string>
+#include <vector>
+
+namespace meshbin
+{
+    struct FileHeader
+    {
+        uint32 fh_magic;
+        uint32 fh_version;
+        uint32 fh_flags;
+        uint32 fh_vertexStride;
+        uint32 fh_nVertices;
+        uint32 fh_nIndices;
+        uint32 fh_vertexOffset;
+        uint32 fh_indexOffset;
+        uint32 fh_nLods;
+        uint32 fh_lodOffset;
+        real32 fh_dimensions[3];
+    };
+
+    // A level of detail is a range of the shared index blob, drawn
+    // over the same vertices. lr_error is the largest deviation from
+    // the full detail surface, relative to the mesh extent
+    struct LodRange
+    {
+        uint32 lr_indexOffset;
+        uint32 lr_indexCount;
+        real32 lr_error;
+        uint32 lr_reserved;
+    };
+
+    // Pointers into the (mapped) file data
+    struct MeshView
+    {
+        const Mesh::Vertex* mv_vertices;
+        const void*         mv_indices;
+        const LodRange*     mv_lods;
+        uint32              mv_nVertices;
+        uint32              mv_nIndices;
+        uint32              mv_nLods;
+        bool                mv_shortIndices;
+        vec3f               mv_dimensions;
+    };
+
+    // <summary>
+    // <para>
+    // Writes the given mesh in the binary format. Indices are stored
+    // as 16 bit whenever the vertex count allows it. The levels of
+    // detail index into indices; an empty lods vector stores the
+    // whole index list as the only level. Returns false if the file
+    // could not be written.
+    // </para>
+    // </summary>
+    bool
+    writeFile(const std::string&               path,
+              const std::vector<Mesh::Vertex>& vertices,
+              const std::vector<uint32>&       indices,
+              const std::vector<LodRange>&     lods,
+              const vec3f&                     dimensions,
+              size_t*                          optBytesWritten = nullptr);
+
+    // <summary>
+    // <para>
+    // Validates the binary mesh in [data, data + size) and points
+    // outView into it. Returns false on a magic, version or layout
+    // mismatch (including any level of detail range outside of the
+    // index blob), in which case the source mesh should be used.
+    // </para>
+    // </summary>
+    bool
+    readView(const uint8* data,
+             const size_t size,
+             MeshView&    outView);
+}
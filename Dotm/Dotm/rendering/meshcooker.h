@@ -0,0 +1,58 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshcooker.h
+
+   File description: The offline mesh converter.
+   Every source mesh of a directory is imported,
+   optimized, simplified into its levels of detail
+   and written in the binary mesh format next to
+   its source, and the load time and bytes
+   read of both formats are measured so that the
+   gains can be reported. Invoked through the
+   -cookmeshes command line switch.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include <string>
+#include <vector>
+
+namespace meshcooker
+{
+    struct CookedMesh
+    {
+        std::string cm_name;
+        bool        cm_succeeded;
+        uint32      cm_sourceBytes;
+        uint32      cm_cookedBytes;
+        real64      cm_sourceLoadMS;
+        real64      cm_cookedLoadMS;
+    };
+
+    struct CookReport
+    {
+        std::vector<CookedMesh> cr_meshes;
+        uint32                  cr_nFailed;
+        ullong64                cr_totalSourceBytes;
+        ullong64                cr_totalCookedBytes;
+        real64                  cr_totalSourceLoadMS;
+        real64                  cr_totalCookedLoadMS;
+    };
+
+    // <summary>
+    // <para>
+    // Cooks every source mesh found in the models directory and
+    // fills outReport with the measurements. Returns false if any
+    // of the meshes failed to cook.
+    // </para>
+    // </summary>
+    bool
+    cookAll(CookReport& outReport);
+
+    // Writes the given report as a human readable table
+    bool
+    writeReport(const std::string& path,
+                const CookReport&  report);
+}
@@ -0,0 +1,327 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshoptimizer.cpp
+
+   File description: Implementation of the mesh
+   optimization functions declared in
+   meshoptimizer.h
+   ------------------------------------------------ */
+
+#include "meshoptimizer.h"
+#include <cmath>
+
+/* ---------
+   Constants
+   --------- */
+#define MO_CACHE_SIZE          32
+#define MO_MAX_VALENCE         32
+#define MO_CACHE_DECAY_POWER   1.5f
+#define MO_LAST_TRI_SCORE      0.75f
+#define MO_VALENCE_BOOST_SCALE 2.0f
+#define MO_VALENCE_BOOST_POWER 0.5f
+#define MO_NOT_IN_CACHE        -1
+
+/* ----------------
+   Internal Structs
+   ---------------- */
+struct OptVertex
+{
+    real32 ov_score;
+    int32  ov_cachePos;
+    uint32 ov_nActiveTris;
+    uint32 ov_firstTri;
+};
+
+struct ScoreTables
+{
+    real32 st_cacheScores[MO_CACHE_SIZE];
+    real32 st_valenceScores[MO_MAX_VALENCE];
+
+    ScoreTables();
+};
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static real32
+calculateVertexScore(const int32  cachePos,
+                     const uint32 nActiveTris);
+
+static const ScoreTables&
+getScoreTables();
+
+/* --------------
+   Public Methods
+   -------------- */
+void
+meshopt::optimizeVertexCache(std::vector<uint32>& indices,
+                             const size_t         nVertices)
+{
+    const size_t nTris = indices.size() / 3;
+    if (nTris < 2 || !nVertices) return;
+
+    const ScoreTables& tables = getScoreTables();
+    auto vertexScore = [&tables](const OptVertex& vertex)
+    {
+        if (!vertex.ov_nActiveTris) return -1.0f;
+        const uint32 valence = vertex.ov_nActiveTris < MO_MAX_VALENCE ? vertex.ov_nActiveTris : MO_MAX_VALENCE - 1;
+        return tables.st_valenceScores[valence] +
+               (vertex.ov_cachePos >= 0 ? tables.st_cacheScores[vertex.ov_cachePos] : 0.0f);
+    };
+
+    // Vertex to triangle adjacency, laid out as one flat array
+    std::vector<OptVertex> vertices(nVertices, OptVertex{0.0f, MO_NOT_IN_CACHE, 0U, 0U});
+    for (size_t i = 0;
+                i < indices.size();
+              ++i)
+    {
+        ++vertices[indices[i]].ov_nActiveTris;
+    }
+
+    uint32 offset = 0U;
+    for (auto iter = vertices.begin();
+              iter != vertices.end();
+            ++iter)
+    {
+        iter->ov_firstTri = offset;
+        offset += iter->ov_nActiveTris;
+        iter->ov_score = vertexScore(*iter);
+    }
+
+    std::vector<uint32> vertexTris(offset);
+    std::vector<uint32> vertexTriCounts(nVertices, 0U);
+    for (size_t tri = 0;
+                tri < nTris;
+              ++tri)
+    {
+        for (size_t corner = 0;
+                    corner < 3;
+                  ++corner)
+        {
+            const uint32 vertex = indices[tri * 3 + corner];
+            vertexTris[vertices[vertex].ov_firstTri + vertexTriCounts[vertex]++] = tri;
+        }
+    }
+
+    std::vector<real32> triScores(nTris);
+    std::vector<bool>   triAdded(nTris, false);
+    for (size_t tri = 0;
+                tri < nTris;
+              ++tri)
+    {
+        triScores[tri] = vertices[indices[tri * 3 + 0]].ov_score +
+                         vertices[indices[tri * 3 + 1]].ov_score +
+                         vertices[indices[tri * 3 + 2]].ov_score;
+    }
+
+    std::vector<uint32> optimized;
+    optimized.reserve(indices.size());
+
+    // The cache holds three extra slots for the vertices that were
+    // just pushed out by the emitted triangle
+    std::vector<uint32> cache, nextCache;
+    cache.reserve(MO_CACHE_SIZE + 3);
+    nextCache.reserve(MO_CACHE_SIZE + 3);
+
+    size_t scanCursor = 0U;
+    int64  bestTri    = -1;
+
+    for (size_t nEmitted = 0;
+                nEmitted < nTris;
+              ++nEmitted)
+    {
+        // Nothing in the cache touches a remaining triangle, so
+        // restart from the next unprocessed one
+        if (bestTri < 0)
+        {
+            while (triAdded[scanCursor]) ++scanCursor;
+            bestTri = scanCursor;
+        }
+
+        const uint32* triIndices = &indices[bestTri * 3];
+        optimized.insert(optimized.end(), triIndices, triIndices + 3);
+        triAdded[bestTri] = true;
+
+        // Remove the triangle from its vertices' active lists
+        nextCache.clear();
+        for (size_t corner = 0;
+                    corner < 3;
+                  ++corner)
+        {
+            OptVertex& vertex = vertices[triIndices[corner]];
+            uint32* tris      = &vertexTris[vertex.ov_firstTri];
+            for (uint32 i = 0;
+                        i < vertex.ov_nActiveTris;
+                      ++i)
+            {
+                if (tris[i] == static_cast<uint32>(bestTri))
+                {
+                    tris[i] = tris[vertex.ov_nActiveTris - 1];
+                    break;
+                }
+            }
+            --vertex.ov_nActiveTris;
+            nextCache.push_back(triIndices[corner]);
+        }
+
+        for (auto citer = cache.cbegin();
+                  citer != cache.cend();
+                ++citer)
+        {
+            if (*citer != triIndices[0] &&
+                *citer != triIndices[1] &&
+                *citer != triIndices[2])
+            {
+                nextCache.push_back(*citer);
+            }
+        }
+        cache.swap(nextCache);
+
+        // Rescore the cached vertices and the triangles around them
+        for (size_t i = 0;
+                    i < cache.size();
+                  ++i)
+        {
+            OptVertex& vertex  = vertices[cache[i]];
+            vertex.ov_cachePos = i < MO_CACHE_SIZE ? static_cast<int32>(i) : MO_NOT_IN_CACHE;
+            vertex.ov_score    = vertexScore(vertex);
+        }
+
+        bestTri = -1;
+        real32 bestScore = -1.0f;
+        for (size_t i = 0;
+                    i < cache.size();
+                  ++i)
+        {
+            const OptVertex& vertex = vertices[cache[i]];
+            for (uint32 j = 0;
+                        j < vertex.ov_nActiveTris;
+                      ++j)
+            {
+                const uint32 tri = vertexTris[vertex.ov_firstTri + j];
+                triScores[tri] = vertices[indices[tri * 3 + 0]].ov_score +
+                                 vertices[indices[tri * 3 + 1]].ov_score +
+                                 vertices[indices[tri * 3 + 2]].ov_score;
+
+                if (triScores[tri] > bestScore)
+                {
+                    bestScore = triScores[tri];
+                    bestTri   = tri;
+                }
+            }
+        }
+
+        if (cache.size() > MO_CACHE_SIZE) cache.resize(MO_CACHE_SIZE);
+    }
+
+    indices.swap(optimized);
+}
+
+void
+meshopt::optimizeVertexFetch(std::vector<Mesh::Vertex>& vertices,
+                             std::vector<uint32>&       indices)
+{
+    const uint32 unmapped = 0xFFFFFFFF;
+
+    std::vector<uint32>       remap(vertices.size(), unmapped);
+    std::vector<Mesh::Vertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (auto iter = indices.begin();
+              iter != indices.end();
+            ++iter)
+    {
+        if (remap[*iter] == unmapped)
+        {
+            remap[*iter] = reordered.size();
+            reordered.push_back(vertices[*iter]);
+        }
+        *iter = remap[*iter];
+    }
+
+    vertices.swap(reordered);
+}
+
+real32
+meshopt::calculateACMR(const std::vector<uint32>& indices,
+                       const size_t               nVertices,
+                       const uint32               cacheSize)
+{
+    const size_t nTris = indices.size() / 3;
+    if (!nTris || !cacheSize) return 0.0f;
+
+    // A vertex is in the FIFO if it entered less than
+    // cacheSize misses ago
+    std::vector<uint32> entryTimes(nVertices, 0U);
+    uint32 nMisses = 0U;
+
+    for (auto citer = indices.cbegin();
+              citer != indices.cend();
+            ++citer)
+    {
+        const uint32 entryTime = entryTimes[*citer];
+        if (!entryTime || nMisses + 1 - entryTime > cacheSize)
+        {
+            entryTimes[*citer] = ++nMisses;
+        }
+    }
+
+    return static_cast<real32>(nMisses) / nTris;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+ScoreTables::ScoreTables()
+{
+    for (int32 i = 0;
+               i < MO_CACHE_SIZE;
+             ++i)
+    {
+        st_cacheScores[i] = calculateVertexScore(i, 1U) - calculateVertexScore(MO_NOT_IN_CACHE, 1U);
+    }
+    for (uint32 i = 0;
+                i < MO_MAX_VALENCE;
+              ++i)
+    {
+        st_valenceScores[i] = calculateVertexScore(MO_NOT_IN_CACHE, i);
+    }
+}
+
+static const ScoreTables&
+getScoreTables()
+{
+    // Function local so that concurrent imports initialize it once
+    static const ScoreTables tables;
+    return tables;
+}
+
+static real32
+calculateVertexScore(const int32  cachePos,
+                     const uint32 nActiveTris)
+{
+    // No triangles left to use this vertex
+    if (!nActiveTris) return -1.0f;
+
+    real32 score = 0.0f;
+    if (cachePos >= 0)
+    {
+        // The vertices of the last triangle get a fixed score so that
+        // the algorithm does not favour strips over fans
+        if (cachePos < 3)
+        {
+            score = MO_LAST_TRI_SCORE;
+        }
+        else
+        {
+            const real32 scaler = 1.0f / (MO_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePos - 3) * scaler, MO_CACHE_DECAY_POWER);
+        }
+    }
+
+    // Vertices with few remaining triangles are boosted so that
+    // they are finished off quickly
+    score += MO_VALENCE_BOOST_SCALE * std::pow(static_cast<real32>(nActiveTris), -MO_VALENCE_BOOST_POWER);
+    return score;
+}
@@ -0,0 +1,58 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshoptimizer.h
+
+   File description: Import time optimizations of
+   indexed triangle lists. Triangles are reordered
+   for the post-transform vertex cache following
+   Tom Forsyth's linear-speed algorithm, vertices
+   are then reordered by first use, and the average
+   cache miss ratio (ACMR) of an index buffer can
+   be measured to report the gains.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "mesh.h"
+#include "../dotmdef.h"
+#include <vector>
+
+namespace meshopt
+{
+    // <summary>
+    // <para>
+    // Reorders the triangles of the given triangle list so that
+    // consecutive triangles reuse the vertices that are still in
+    // the post-transform cache. The vertices are not touched.
+    // </para>
+    // </summary>
+    void
+    optimizeVertexCache(std::vector<uint32>& indices,
+                        const size_t         nVertices);
+
+    // <summary>
+    // <para>
+    // Reorders the vertices in the order they are first referenced
+    // by the index buffer and remaps the indices accordingly, so that
+    // vertex fetches walk the vertex buffer mostly linearly.
+    // Unreferenced vertices are dropped.
+    // </para>
+    // </summary>
+    void
+    optimizeVertexFetch(std::vector<Mesh::Vertex>& vertices,
+                        std::vector<uint32>&       indices);
+
+    // <summary>
+    // <para>
+    // Simulates a FIFO post-transform cache of the given size and
+    // returns the average number of vertex shader invocations per
+    // triangle. 3.0 is the worst case, ~0.5 the best for large
+    // regular meshes.
+    // </para>
+    // </summary>
+    real32
+    calculateACMR(const std::vector<uint32>& indices,
+                  const size_t               nVertices,
+                  const uint32               cacheSize);
+}
@@ -0,0 +1,461 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshsimplifier.cpp
+
+   File description: Implementation of the mesh
+   simplification function declared in
+   meshsimplifier.h
+   ------------------------------------------------ */
+
+#include "meshsimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+/* ---------
+   Constants
+   --------- */
+#define MS_MIN_NORMAL_COSINE 0.25
+
+/* ----------------
+   Internal Structs
+   ---------------- */
+
+// Symmetric 4x4 matrix of the plane equations, along with the
+// total area the planes were weighted by
+struct Quadric
+{
+    double q_a2, q_ab, q_ac, q_ad;
+    double q_b2, q_bc, q_bd;
+    double q_c2, q_cd;
+    double q_d2;
+    double q_weight;
+};
+
+struct Collapse
+{
+    uint32 c_source;
+    uint32 c_target;
+    double c_error;
+};
+
+struct PositionKey
+{
+    uint32 pk_bits[3];
+
+    bool operator == (const PositionKey& rhs) const
+    {
+        return memcmp(pk_bits, rhs.pk_bits, sizeof(pk_bits)) == 0;
+    }
+};
+
+struct PositionKeyHash
+{
+    size_t operator () (const PositionKey& key) const
+    {
+        return (key.pk_bits[0] * 73856093U) ^ (key.pk_bits[1] * 19349663U) ^ (key.pk_bits[2] * 83492791U);
+    }
+};
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static void
+addPlane(Quadric&     quadric,
+         const double a,
+         const double b,
+         const double c,
+         const double d,
+         const double weight);
+
+static void
+addQuadric(Quadric& quadric, const Quadric& rhs);
+
+static double
+evaluate(const Quadric& quadric, const Mesh::Vertex& vertex);
+
+static void
+calculateNormal(const Mesh::Vertex& v0,
+                const Mesh::Vertex& v1,
+                const Mesh::Vertex& v2,
+                double              outNormal[3]);
+
+static bool
+flipsTriangles(const std::vector<Mesh::Vertex>& vertices,
+               const std::vector<uint32>&       indices,
+               const std::vector<uint32>&       triangleOffsets,
+               const std::vector<uint32>&       triangleList,
+               const uint32                     source,
+               const uint32                     target);
+
+/* --------------
+   Public Methods
+   -------------- */
+real32
+meshsimplify::simplify(const std::vector<Mesh::Vertex>& vertices,
+                       const std::vector<uint32>&       indices,
+                       const size_t                     targetIndexCount,
+                       const real32                     maxError,
+                       std::vector<uint32>&             outIndices)
+{
+    outIndices = indices;
+    const size_t nVertices = vertices.size();
+    if (!nVertices || indices.size() <= targetIndexCount) return 0.0f;
+
+    // Vertices sharing a position (attribute seams) are welded so
+    // that the topology and the quadrics are those of the surface
+    std::vector<uint32> welded(nVertices);
+    std::vector<uint8>  locked(nVertices, 0U);
+    {
+        std::unordered_map<PositionKey, uint32, PositionKeyHash> firstAtPosition;
+        firstAtPosition.reserve(nVertices);
+        for (uint32 i = 0;
+                    i < nVertices;
+                  ++i)
+        {
+            PositionKey key;
+            memcpy(&key.pk_bits[0], &vertices[i].v_x, sizeof(real32));
+            memcpy(&key.pk_bits[1], &vertices[i].v_y, sizeof(real32));
+            memcpy(&key.pk_bits[2], &vertices[i].v_z, sizeof(real32));
+
+            auto result = firstAtPosition.insert(std::make_pair(key, i));
+            welded[i] = result.first->second;
+            if (!result.second)
+            {
+                locked[i]         = 1U;
+                locked[welded[i]] = 1U;
+            }
+        }
+    }
+
+    // Border and non manifold edges are those not shared by
+    // exactly two triangles; their vertices stay in place
+    {
+        std::unordered_map<ullong64, uint32> edgeCounts;
+        edgeCounts.reserve(indices.size());
+        for (size_t i = 0;
+                    i < indices.size();
+                  ++i)
+        {
+            const uint32 a = welded[indices[i]];
+            const uint32 b = welded[indices[i - i % 3 + (i + 1) % 3]];
+            ++edgeCounts[(static_cast<ullong64>(std::min(a, b)) << 32) | std::max(a, b)];
+        }
+
+        std::vector<uint8> lockedPositions(nVertices, 0U);
+        for (auto citer = edgeCounts.cbegin();
+                  citer != edgeCounts.cend();
+                ++citer)
+        {
+            if (citer->second == 2U) continue;
+            lockedPositions[static_cast<uint32>(citer->first >> 32)]         = 1U;
+            lockedPositions[static_cast<uint32>(citer->first & 0xFFFFFFFF)] = 1U;
+        }
+
+        for (uint32 i = 0;
+                    i < nVertices;
+                  ++i)
+        {
+            if (lockedPositions[welded[i]]) locked[i] = 1U;
+        }
+    }
+
+    // Area weighted plane quadrics per welded position
+    std::vector<Quadric> quadrics(nVertices);
+    memset(&quadrics[0], 0, sizeof(Quadric) * nVertices);
+
+    real32 extent = 0.0f;
+    {
+        vec3f minBounds(vertices[0].v_x, vertices[0].v_y, vertices[0].v_z);
+        vec3f maxBounds(minBounds);
+        for (size_t i = 1;
+                    i < nVertices;
+                  ++i)
+        {
+            minBounds.x = math::min2f(minBounds.x, vertices[i].v_x);
+            minBounds.y = math::min2f(minBounds.y, vertices[i].v_y);
+            minBounds.z = math::min2f(minBounds.z, vertices[i].v_z);
+            maxBounds.x = math::max2f(maxBounds.x, vertices[i].v_x);
+            maxBounds.y = math::max2f(maxBounds.y, vertices[i].v_y);
+            maxBounds.z = math::max2f(maxBounds.z, vertices[i].v_z);
+        }
+        extent = math::max3f(maxBounds.x - minBounds.x,
+                             maxBounds.y - minBounds.y,
+                             maxBounds.z - minBounds.z);
+    }
+    if (extent <= 0.0f) return 0.0f;
+
+    for (size_t i = 0;
+                i + 2 < indices.size();
+                i += 3)
+    {
+        const Mesh::Vertex& v0 = vertices[indices[i]];
+
+        double normal[3];
+        calculateNormal(v0, vertices[indices[i + 1]], vertices[indices[i + 2]], normal);
+
+        const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length <= 0.0) continue;
+
+        const double a = normal[0] / length;
+        const double b = normal[1] / length;
+        const double c = normal[2] / length;
+        const double d = -(a * v0.v_x + b * v0.v_y + c * v0.v_z);
+
+        for (size_t corner = 0;
+                    corner < 3;
+                  ++corner)
+        {
+            addPlane(quadrics[welded[indices[i + corner]]], a, b, c, d, length * 0.5);
+        }
+    }
+
+    const double maxErrorSquared = static_cast<double>(maxError) * maxError * extent * extent;
+    double       resultError     = 0.0;
+
+    std::vector<uint32>   remap(nVertices);
+    std::vector<uint32>   triangleOffsets(nVertices + 1);
+    std::vector<uint32>   triangleList;
+    std::vector<ullong64> edges;
+    std::vector<Collapse> collapses;
+    std::vector<uint8>    touched(nVertices);
+
+    for (uint32 i = 0;
+                i < nVertices;
+              ++i)
+    {
+        remap[i] = i;
+    }
+
+    // Each pass collapses the cheapest edges that do not interfere
+    // with each other, then rebuilds the triangle list
+    while (outIndices.size() > targetIndexCount)
+    {
+        // Vertex to triangle adjacency
+        std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0U);
+        for (size_t i = 0;
+                    i < outIndices.size();
+                  ++i)
+        {
+            ++triangleOffsets[outIndices[i] + 1];
+        }
+        for (size_t i = 0;
+                    i < nVertices;
+                  ++i)
+        {
+            triangleOffsets[i + 1] += triangleOffsets[i];
+        }
+
+        triangleList.resize(outIndices.size());
+        std::vector<uint32> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (size_t i = 0;
+                    i < outIndices.size();
+                  ++i)
+        {
+            triangleList[cursor[outIndices[i]]++] = static_cast<uint32>(i / 3);
+        }
+
+        // Unique edges, each considered in both directions
+        edges.clear();
+        for (size_t i = 0;
+                    i < outIndices.size();
+                  ++i)
+        {
+            const uint32 a = outIndices[i];
+            const uint32 b = outIndices[i - i % 3 + (i + 1) % 3];
+            edges.push_back((static_cast<ullong64>(std::min(a, b)) << 32) | std::max(a, b));
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        collapses.clear();
+        for (auto citer = edges.cbegin();
+                  citer != edges.cend();
+                ++citer)
+        {
+            const uint32 endpoints[2] = { static_cast<uint32>(*citer >> 32),
+                                          static_cast<uint32>(*citer & 0xFFFFFFFF) };
+            for (size_t direction = 0;
+                        direction < 2;
+                      ++direction)
+            {
+                const uint32 source = endpoints[direction];
+                const uint32 target = endpoints[1 - direction];
+                if (locked[source]) continue;
+
+                Quadric combined = quadrics[welded[source]];
+                addQuadric(combined, quadrics[welded[target]]);
+
+                Collapse collapse = { source, target, evaluate(combined, vertices[target]) };
+                if (collapse.c_error <= maxErrorSquared) collapses.push_back(collapse);
+            }
+        }
+
+        std::sort(collapses.begin(), collapses.end(), [](const Collapse& lhs, const Collapse& rhs)
+        {
+            return lhs.c_error < rhs.c_error;
+        });
+
+        // An interior collapse removes two triangles
+        const size_t trianglesToRemove = (outIndices.size() - targetIndexCount) / 3;
+        const size_t maxCollapses      = std::max<size_t>(1U, trianglesToRemove / 2);
+        size_t       nCollapses        = 0U;
+
+        std::fill(touched.begin(), touched.end(), 0U);
+        for (auto citer = collapses.cbegin();
+                  citer != collapses.cend() && nCollapses < maxCollapses;
+                ++citer)
+        {
+            const uint32 source = citer->c_source;
+            const uint32 target = citer->c_target;
+            if (touched[source] || touched[target]) continue;
+            if (flipsTriangles(vertices, outIndices, triangleOffsets, triangleList, source, target)) continue;
+
+            remap[source] = target;
+            addQuadric(quadrics[welded[target]], quadrics[welded[source]]);
+            resultError = std::max(resultError, citer->c_error);
+            ++nCollapses;
+
+            // Freeze the neighbourhood for the rest of this pass, so
+            // that the flip test above stays valid
+            for (uint32 i = triangleOffsets[source];
+                        i < triangleOffsets[source + 1];
+                      ++i)
+            {
+                const uint32 triangle = triangleList[i];
+                touched[outIndices[triangle * 3 + 0]] = 1U;
+                touched[outIndices[triangle * 3 + 1]] = 1U;
+                touched[outIndices[triangle * 3 + 2]] = 1U;
+            }
+        }
+
+        if (!nCollapses) break;
+
+        // Rebuild the triangle list, dropping collapsed triangles
+        size_t writeIndex = 0U;
+        for (size_t i = 0;
+                    i + 2 < outIndices.size();
+                    i += 3)
+        {
+            const uint32 a = remap[outIndices[i]];
+            const uint32 b = remap[outIndices[i + 1]];
+            const uint32 c = remap[outIndices[i + 2]];
+            if (a == b || b == c || a == c) continue;
+
+            outIndices[writeIndex++] = a;
+            outIndices[writeIndex++] = b;
+            outIndices[writeIndex++] = c;
+        }
+        outIndices.resize(writeIndex);
+    }
+
+    return static_cast<real32>(std::sqrt(resultError)) / extent;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static void
+addPlane(Quadric&     quadric,
+         const double a,
+         const double b,
+         const double c,
+         const double d,
+         const double weight)
+{
+    quadric.q_a2 += weight * a * a;
+    quadric.q_ab += weight * a * b;
+    quadric.q_ac += weight * a * c;
+    quadric.q_ad += weight * a * d;
+    quadric.q_b2 += weight * b * b;
+    quadric.q_bc += weight * b * c;
+    quadric.q_bd += weight * b * d;
+    quadric.q_c2 += weight * c * c;
+    quadric.q_cd += weight * c * d;
+    quadric.q_d2 += weight * d * d;
+    quadric.q_weight += weight;
+}
+
+static void
+addQuadric(Quadric& quadric, const Quadric& rhs)
+{
+    quadric.q_a2 += rhs.q_a2;
+    quadric.q_ab += rhs.q_ab;
+    quadric.q_ac += rhs.q_ac;
+    quadric.q_ad += rhs.q_ad;
+    quadric.q_b2 += rhs.q_b2;
+    quadric.q_bc += rhs.q_bc;
+    quadric.q_bd += rhs.q_bd;
+    quadric.q_c2 += rhs.q_c2;
+    quadric.q_cd += rhs.q_cd;
+    quadric.q_d2 += rhs.q_d2;
+    quadric.q_weight += rhs.q_weight;
+}
+
+static double
+evaluate(const Quadric& quadric, const Mesh::Vertex& vertex)
+{
+    if (quadric.q_weight <= 0.0) return 0.0;
+
+    const double x = vertex.v_x, y = vertex.v_y, z = vertex.v_z;
+    const double error = quadric.q_a2 * x * x + 2.0 * quadric.q_ab * x * y + 2.0 * quadric.q_ac * x * z +
+                         quadric.q_b2 * y * y + 2.0 * quadric.q_bc * y * z + quadric.q_c2 * z * z     +
+                         2.0 * (quadric.q_ad * x + quadric.q_bd * y + quadric.q_cd * z) + quadric.q_d2;
+
+    // Mean squared distance to the accumulated planes
+    return std::max(error, 0.0) / quadric.q_weight;
+}
+
+static void
+calculateNormal(const Mesh::Vertex& v0,
+                const Mesh::Vertex& v1,
+                const Mesh::Vertex& v2,
+                double              outNormal[3])
+{
+    const double e1[3] = { v1.v_x - v0.v_x, v1.v_y - v0.v_y, v1.v_z - v0.v_z };
+    const double e2[3] = { v2.v_x - v0.v_x, v2.v_y - v0.v_y, v2.v_z - v0.v_z };
+    outNormal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    outNormal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    outNormal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+static bool
+flipsTriangles(const std::vector<Mesh::Vertex>& vertices,
+               const std::vector<uint32>&       indices,
+               const std::vector<uint32>&       triangleOffsets,
+               const std::vector<uint32>&       triangleList,
+               const uint32                     source,
+               const uint32                     target)
+{
+    for (uint32 i = triangleOffsets[source];
+                i < triangleOffsets[source + 1];
+              ++i)
+    {
+        const uint32* triangle = &indices[triangleList[i] * 3];
+
+        // Triangles on the collapsed edge disappear altogether
+        if (triangle[0] == target || triangle[1] == target || triangle[2] == target) continue;
+
+        const Mesh::Vertex& v0 = vertices[triangle[0]];
+        const Mesh::Vertex& v1 = vertices[triangle[1]];
+        const Mesh::Vertex& v2 = vertices[triangle[2]];
+        const Mesh::Vertex& moved = vertices[target];
+
+        double before[3], after[3];
+        calculateNormal(v0, v1, v2, before);
+        calculateNormal(triangle[0] == source ? moved : v0,
+                        triangle[1] == source ? moved : v1,
+                        triangle[2] == source ? moved : v2,
+                        after);
+
+        // Flipped, degenerate, or rotated by more than ~75 degrees
+        const double dot         = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+        const double lengthsProd = std::sqrt((before[0] * before[0] + before[1] * before[1] + before[2] * before[2]) *
+                                             (after[0]  * after[0]  + after[1]  * after[1]  + after[2]  * after[2]));
+        if (dot <= MS_MIN_NORMAL_COSINE * lengthsProd) return true;
+    }
+
+    return false;
+}
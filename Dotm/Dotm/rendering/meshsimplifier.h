@@ -0,0 +1,39 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshsimplifier.h
+
+   File description: Quadric error metric mesh
+   simplification (Garland & Heckbert) used to
+   generate the levels of detail of imported meshes.
+   Edges are collapsed onto one of their existing
+   endpoints, so every level of detail is only a new
+   index list over the shared vertex buffer.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "mesh.h"
+#include "../dotmdef.h"
+#include <vector>
+
+namespace meshsimplify
+{
+    // <summary>
+    // <para>
+    // Simplifies the triangle list in indices towards targetIndexCount
+    // indices, never collapsing an edge whose error exceeds maxError.
+    // Errors are distances relative to the mesh extent (i.e. 0.01 is
+    // 1% of the mesh's largest dimension). Vertices on open borders
+    // and attribute seams are never moved, which keeps UV and normal
+    // discontinuities and mesh outlines intact.
+    // Returns the largest error introduced.
+    // </para>
+    // </summary>
+    real32
+    simplify(const std::vector<Mesh::Vertex>& vertices,
+             const std::vector<uint32>&       indices,
+             const size_t                     targetIndexCount,
+             const real32                     maxError,
+             std::vector<uint32>&             outIndices);
+}
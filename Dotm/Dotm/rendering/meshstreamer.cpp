@@ -0,0 +1,717 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshstreamer.cpp
+
+   File description: Implementation of the
+   MeshStreamer class declared in meshstreamer.h
+   ------------------------------------------------ */
+
+#include "meshstreamer.h"
+#include "meshoptimizer.h"
+#include "meshsimplifier.h"
+#include "objparser.h"
+#include "renderer.h"
+#include "../config/configparser.h"
+#include "../util/assetpack.h"
+#include "../util/logging.h"
+#include "../util/memtracker.h"
+#include "../util/profiler.h"
+#include <chrono>
+#include <thread>
+
+/* ---------
+   Constants
+   --------- */
+#define MS_PLACEHOLDER_MESH  "sample_cube"
+#define MS_DEFAULT_BUDGET_MS 2.0f
+#define MS_ACMR_CACHE_SIZE   16
+#define MS_MODELS_DIRECTORY  "assets/models/"
+#define MS_SOURCE_EXTENSION  ".obj"
+#define MS_COOKED_EXTENSION  ".dmesh"
+
+// Each level of detail targets half the triangles of the previous
+// one, and generation stops early once a level barely simplifies
+#define MS_MAX_LODS            4
+#define MS_LOD_REDUCTION       0.5f
+#define MS_LOD_MIN_REDUCTION   0.9f
+#define MS_LOD_MAX_ERROR       0.05f
+#define MS_LOD_MIN_TRIANGLES   64
+
+//#define OBJ_PARSER_BENCHMARK
+#define OBJ_PARSER_BENCHMARK_MESH       "assets/models/sample_sphere.obj"
+#define OBJ_PARSER_BENCHMARK_ITERATIONS 20
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static ullong64
+getTimeUS();
+
+static real64
+getElapsedMS(const ullong64 startUS,
+             const ullong64 endUS);
+
+static bool
+loadPackedData(const std::string& meshName,
+               MeshSourceData&    outData);
+
+static bool
+setCookedView(const uint8*    data,
+              const size_t    size,
+              MeshSourceData& outData);
+
+static void
+finalizeImport(const objparser::ParseStats& stats,
+               MeshSourceData&              outData);
+
+static void
+generateLods(MeshSourceData& data);
+
+static void
+createVertexBuffer(const void*     vertices,
+                   const uint32    vertexStride,
+                   const uint32    nVertices,
+                   MeshCachedData& outData);
+
+static void
+createIndexBuffer(const meshbin::MeshView& view,
+                  MeshCachedData&          outData);
+
+/* --------------
+   Static Methods
+   -------------- */
+MeshStreamer*
+MeshStreamer::get()
+{
+    static MeshStreamer instance;
+    return &instance;
+}
+
+std::string
+MeshStreamer::getSourcePath(const std::string& meshName)
+{
+    return MS_MODELS_DIRECTORY + meshName + MS_SOURCE_EXTENSION;
+}
+
+std::string
+MeshStreamer::getCookedPath(const std::string& meshName)
+{
+    return MS_MODELS_DIRECTORY + meshName + MS_COOKED_EXTENSION;
+}
+
+bool
+MeshStreamer::loadSourceData(const std::string& meshName,
+                             MeshSourceData&    outData)
+{
+    if (loadPackedData(meshName, outData)) return true;
+    if (loadCookedFile(meshName, outData)) return true;
+    return importSourceData(meshName, outData);
+}
+
+bool
+MeshStreamer::loadCookedFile(const std::string& meshName,
+                             MeshSourceData&    outData)
+{
+    const std::string cookedPath = getCookedPath(meshName);
+
+    // A source file newer than the cooked one means the
+    // cooked file is stale
+    ullong64 cookedTime = 0ULL, sourceTime = 0ULL;
+    if (!MappedFile::getLastWriteTime(cookedPath, cookedTime)) return false;
+    if (MappedFile::getLastWriteTime(getSourcePath(meshName), sourceTime) &&
+        sourceTime > cookedTime) return false;
+
+    std::unique_ptr<MappedFile> cookedFile(new MappedFile);
+    if (!cookedFile->open(cookedPath)) return false;
+    if (!setCookedView(cookedFile->getData(), cookedFile->getSize(), outData)) return false;
+
+    outData.msd_cookedFile = std::move(cookedFile);
+    return true;
+}
+
+bool
+MeshStreamer::importSourceData(const std::string& meshName,
+                               MeshSourceData&    outData)
+{
+    objparser::ParseStats stats = {};
+    if (!objparser::parseFile(getSourcePath(meshName),
+                              outData.msd_vertices,
+                              outData.msd_indices,
+                              &stats)) return false;
+
+    // A truncated or empty file parses, but leaves nothing to draw
+    if (outData.msd_vertices.empty() || outData.msd_indices.empty())
+    {
+        logstring("Rejected mesh file with no geometry: ");
+        logline(meshName.c_str());
+        return false;
+    }
+
+    finalizeImport(stats, outData);
+    return true;
+}
+
+void
+MeshStreamer::calculateDimensions(MeshSourceData& data)
+{
+    real32 minWidth  = 0.0f, maxWidth  = 0.0f;
+    real32 minDepth  = 0.0f, maxDepth  = 0.0f;
+    real32 minHeight = 0.0f, maxHeight = 0.0f;
+
+    for (auto citer = data.msd_vertices.cbegin();
+              citer != data.msd_vertices.cend();
+            ++citer)
+    {
+        if (citer->v_x < minWidth)  minWidth  = citer->v_x;
+        if (citer->v_x > maxWidth)  maxWidth  = citer->v_x;
+        if (citer->v_y < minHeight) minHeight = citer->v_y;
+        if (citer->v_y > maxHeight) maxHeight = citer->v_y;
+        if (citer->v_z < minDepth)  minDepth  = citer->v_z;
+        if (citer->v_z > maxDepth)  maxDepth  = citer->v_z;
+    }
+    data.msd_dimensions.x = std::abs(minWidth)  + std::abs(maxWidth);
+    data.msd_dimensions.y = std::abs(minHeight) + std::abs(maxHeight);
+    data.msd_dimensions.z = std::abs(minDepth)  + std::abs(maxDepth);
+}
+
+void
+MeshStreamer::compactSourceData(MeshSourceData& data)
+{
+    const size_t nVertices = data.msd_cooked ? data.msd_cookedView.mv_nVertices : data.msd_vertices.size();
+    if (!nVertices) return;
+
+    const Mesh::Vertex* vertices = data.msd_cooked ? data.msd_cookedView.mv_vertices : &data.msd_vertices[0];
+
+    data.msd_quantParams = vertexquant::calculateParams(vertices, nVertices);
+    vertexquant::encode(vertices, nVertices, data.msd_quantParams, data.msd_compactVertices);
+
+#if defined(_DEBUG)
+    const vertexquant::ErrorReport report = vertexquant::measureError(vertices,
+                                                                      data.msd_compactVertices,
+                                                                      data.msd_quantParams);
+    if (!report.er_withinBounds)
+    {
+        logstring("Compact vertex error out of bounds, position: ");
+        logvar(report.er_maxPositionError);
+        logstring(" texcoord: ");
+        logvar(report.er_maxTexcoordError);
+        logstring(" normal degrees: ");
+        logline(report.er_maxNormalErrorDegrees);
+    }
+#endif
+}
+
+bool
+MeshStreamer::createBuffers(const MeshSourceData& source,
+                            MeshCachedData&       outData)
+{
+    const size_t nVertices = source.msd_cooked ? source.msd_cookedView.mv_nVertices : source.msd_vertices.size();
+    const size_t nIndices  = source.msd_cooked ? source.msd_cookedView.mv_nIndices  : source.msd_indices.size();
+    if (!nVertices || !nIndices) return false;
+
+    meshbin::MeshView view = {};
+    std::vector<uint16> shortIndexData;
+
+    if (source.msd_cooked)
+    {
+        view = source.msd_cookedView;
+    }
+    else
+    {
+        view.mv_vertices     = &source.msd_vertices[0];
+        view.mv_indices      = &source.msd_indices[0];
+        view.mv_nVertices    = source.msd_vertices.size();
+        view.mv_nIndices     = source.msd_indices.size();
+        view.mv_lods         = source.msd_lods.empty() ? nullptr : &source.msd_lods[0];
+        view.mv_nLods        = source.msd_lods.size();
+        view.mv_shortIndices = false;
+        view.mv_dimensions   = source.msd_dimensions;
+
+        // Narrow the indices whenever the vertex count allows it
+        if (view.mv_nVertices <= 0xFFFF)
+        {
+            shortIndexData.assign(source.msd_indices.cbegin(), source.msd_indices.cend());
+            view.mv_indices      = &shortIndexData[0];
+            view.mv_shortIndices = true;
+        }
+    }
+
+    outData.mcd_compact = !source.msd_compactVertices.empty();
+    if (outData.mcd_compact)
+    {
+        outData.mcd_vertexStride = sizeof(vertexquant::CompactVertex);
+        outData.mcd_quantParams  = source.msd_quantParams;
+        createVertexBuffer(&source.msd_compactVertices[0], outData.mcd_vertexStride, view.mv_nVertices, outData);
+    }
+    else
+    {
+        outData.mcd_vertexStride = sizeof(Mesh::Vertex);
+        createVertexBuffer(view.mv_vertices, outData.mcd_vertexStride, view.mv_nVertices, outData);
+    }
+
+    createIndexBuffer(view, outData);
+    return true;
+}
+
+/* --------------
+   Public Methods
+   -------------- */
+MeshStreamer::~MeshStreamer()
+{
+    JobSystem::get()->waitFor(&m_loadJobs);
+}
+
+std::shared_ptr<MeshCachedData>
+MeshStreamer::requestAsync(cstring meshName)
+{
+    stringID meshID = internString(meshName);
+
+    std::shared_ptr<MeshCachedData> target;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        auto citer = m_cachedMeshes.find(meshID);
+        if (citer != m_cachedMeshes.cend()) return citer->second;
+
+        target.reset(new MeshCachedData);
+        m_cachedMeshes[meshID] = target;
+    }
+
+    std::string    fileName(meshName);
+    const ullong64 requestTime   = getTimeUS();
+    const bool     compactVertices = m_compactVertices;
+
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        ++m_stats.ss_requested;
+        ++m_stats.ss_pendingUploads;
+    }
+
+    JobSystem::get()->run([=]()
+    {
+        MEM_TAG_SCOPE(memtracker::MEM_TAG_MESHES);
+
+        PendingUpload upload = {};
+        upload.pu_meshID        = meshID;
+        upload.pu_target        = target;
+        upload.pu_source.reset(new MeshSourceData());
+        upload.pu_requestTimeUS = requestTime;
+
+        const ullong64 parseStart = getTimeUS();
+        upload.pu_failed  = !loadSourceData(fileName, *upload.pu_source);
+        if (!upload.pu_failed && compactVertices) compactSourceData(*upload.pu_source);
+        upload.pu_parseMS = getElapsedMS(parseStart, getTimeUS());
+
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        m_pendingUploads.push_back(upload);
+    }, &m_loadJobs);
+
+    return target;
+}
+
+std::shared_ptr<MeshCachedData>
+MeshStreamer::findCached(const stringID meshID) logical_const
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto citer = m_cachedMeshes.find(meshID);
+    if (citer != m_cachedMeshes.cend()) return citer->second;
+    return nullptr;
+}
+
+void
+MeshStreamer::registerCached(const stringID                         meshID,
+                             const std::shared_ptr<MeshCachedData>& data)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (m_cachedMeshes.find(meshID) != m_cachedMeshes.cend()) return;
+    m_cachedMeshes[meshID] = data;
+}
+
+void
+MeshStreamer::processUploads()
+{
+    PROFILE_ZONE("MeshStreamer::processUploads");
+
+    if (config::getRevision() != m_configRevision)
+    {
+        m_configRevision = config::getRevision();
+        m_uploadBudgetMS = config::getFloat("rendconfig", "stream_budget_ms", m_uploadBudgetMS);
+    }
+
+    uploadPending(true);
+}
+
+void
+MeshStreamer::flushUploads()
+{
+    PROFILE_ZONE("MeshStreamer::flushUploads");
+    JobSystem::get()->waitFor(&m_loadJobs);
+    uploadPending(false);
+}
+
+bool
+MeshStreamer::waitUntilReady(const std::shared_ptr<MeshCachedData>& data)
+{
+    PROFILE_ZONE("MeshStreamer::waitUntilReady");
+
+    while (!data->mcd_ready && !data->mcd_failed)
+    {
+        // Take the upload over if it is already parsed and queued
+        PendingUpload upload = {};
+        {
+            std::lock_guard<std::mutex> lock(m_uploadMutex);
+            for (auto iter = m_pendingUploads.begin();
+                      iter != m_pendingUploads.end();
+                    ++iter)
+            {
+                if (iter->pu_target != data) continue;
+
+                upload = *iter;
+                m_pendingUploads.erase(iter);
+                --m_stats.ss_pendingUploads;
+                break;
+            }
+        }
+
+        if (upload.pu_target)
+        {
+            completeUpload(upload);
+            break;
+        }
+
+        // Otherwise help the load jobs along. Once they have all run,
+        // the upload can only be in progress on the main thread
+        JobSystem::get()->waitFor(&m_loadJobs);
+        std::this_thread::yield();
+    }
+
+    return data->mcd_ready;
+}
+
+const MeshCachedData&
+MeshStreamer::getPlaceholder() logical_const
+{
+    return m_placeholder;
+}
+
+MeshStreamer::StreamingStats
+MeshStreamer::getStats() logical_const
+{
+    std::lock_guard<std::mutex> lock(m_uploadMutex);
+    return m_stats;
+}
+
+/* ---------------
+   Private Methods
+   --------------- */
+MeshStreamer::MeshStreamer():
+
+    m_stats(),
+    m_uploadBudgetMS(MS_DEFAULT_BUDGET_MS),
+    m_configRevision(0U),
+    m_compactVertices(false)
+{
+    if (config::initConfigFile("rendconfig"))
+    {
+        m_configRevision = config::getRevision();
+        config::extractConfigFloat("rendconfig", "stream_budget_ms", &m_uploadBudgetMS);
+        config::extractConfigBool("rendconfig", "compact_vertices", &m_compactVertices);
+    }
+
+    // The placeholder is loaded synchronously so that it is
+    // always available to meshes whose data is in flight
+    MeshSourceData source = {};
+    if (loadSourceData(MS_PLACEHOLDER_MESH, source))
+    {
+        createBuffers(source, m_placeholder);
+    }
+    m_placeholder.mcd_ready = true;
+
+#ifdef OBJ_PARSER_BENCHMARK
+    objparser::BenchmarkResult result = objparser::benchmark(OBJ_PARSER_BENCHMARK_MESH,
+                                                             OBJ_PARSER_BENCHMARK_ITERATIONS);
+    logstring("OBJ parser benchmark, bytes: ");
+    logvar(result.br_bytes);
+    logstring(" triangles: ");
+    logvar(result.br_nTriangles);
+    logstring(" ms per parse: ");
+    logvar(result.br_parseMillis);
+    logstring(" MB/s: ");
+    logline(result.br_megabytesPerSec);
+#endif
+}
+
+void
+MeshStreamer::uploadPending(const bool withinBudget)
+{
+    const ullong64 frameStart = getTimeUS();
+
+    for (;;)
+    {
+        PendingUpload upload = {};
+        {
+            std::lock_guard<std::mutex> lock(m_uploadMutex);
+            if (m_pendingUploads.empty()) break;
+
+            upload = m_pendingUploads.front();
+            m_pendingUploads.pop_front();
+            --m_stats.ss_pendingUploads;
+        }
+
+        completeUpload(upload);
+        const ullong64 uploadEnd = getTimeUS();
+
+        // Always make some progress, then respect the budget
+        if (withinBudget && getElapsedMS(frameStart, uploadEnd) >= m_uploadBudgetMS) break;
+    }
+
+    const real64 frameUploadMS = getElapsedMS(frameStart, getTimeUS());
+
+    std::lock_guard<std::mutex> lock(m_uploadMutex);
+    m_stats.ss_maxFrameUploadMS = math::max2f(m_stats.ss_maxFrameUploadMS, frameUploadMS);
+}
+
+void
+MeshStreamer::completeUpload(const PendingUpload& upload)
+{
+    const ullong64 uploadStart = getTimeUS();
+    if (upload.pu_failed || !createBuffers(*upload.pu_source, *upload.pu_target))
+    {
+        upload.pu_target->mcd_failed = true;
+        {
+            std::lock_guard<std::mutex> lock(m_uploadMutex);
+            ++m_stats.ss_failed;
+        }
+        MessageBox(NULL,
+                   ("Missing mesh file: " + std::string(retrieveString(upload.pu_meshID))).c_str(),
+                   "Mesh Missing!",
+                   MB_ICONEXCLAMATION);
+        return;
+    }
+
+    upload.pu_target->mcd_ready = true;
+    const ullong64 uploadEnd = getTimeUS();
+
+    const uint32 nVertices = upload.pu_source->msd_cooked ?
+                             upload.pu_source->msd_cookedView.mv_nVertices :
+                             static_cast<uint32>(upload.pu_source->msd_vertices.size());
+    {
+        std::lock_guard<std::mutex> lock(m_uploadMutex);
+        ++m_stats.ss_completed;
+        m_stats.ss_bytesRead       += upload.pu_source->msd_bytesRead;
+        m_stats.ss_vertexBytes     += upload.pu_target->mcd_vertexStride * nVertices;
+        m_stats.ss_fullVertexBytes += sizeof(Mesh::Vertex) * nVertices;
+        m_stats.ss_totalParseMS    += upload.pu_parseMS;
+        m_stats.ss_totalUploadMS   += getElapsedMS(uploadStart, uploadEnd);
+        m_stats.ss_maxRequestToReadyMS = math::max2f(m_stats.ss_maxRequestToReadyMS,
+                                                     getElapsedMS(upload.pu_requestTimeUS, uploadEnd));
+    }
+
+    logstring("Streamed mesh: ");
+    logline(retrieveString(upload.pu_meshID));
+    logstring("  parse ms: ");
+    logline(upload.pu_parseMS);
+    logstring("  parse MB/s: ");
+    logline(upload.pu_parseMS > 0.0f ?
+            upload.pu_source->msd_bytesRead / (1024.0f * 1024.0f) / (upload.pu_parseMS / 1000.0f) :
+            0.0f);
+    logstring("  upload ms: ");
+    logline(getElapsedMS(uploadStart, uploadEnd));
+    logstring("  vertex bytes: ");
+    logline(upload.pu_target->mcd_vertexStride * nVertices);
+    logstring("  levels of detail: ");
+    logline(static_cast<uint32>(upload.pu_target->mcd_lods.size()));
+    if (upload.pu_source->msd_cooked)
+    {
+        logline("  loaded from the cooked mesh data");
+    }
+    else
+    {
+        logstring("  vertices: ");
+        logvar(upload.pu_source->msd_nRawVertices);
+        logstring(" -> ");
+        logline(static_cast<uint32>(upload.pu_source->msd_vertices.size()));
+        logstring("  ACMR: ");
+        logvar(upload.pu_source->msd_rawACMR);
+        logstring(" -> ");
+        logline(upload.pu_source->msd_optimizedACMR);
+    }
+}
+
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+// Microseconds since the first call. Differences are taken in
+// integers and only then narrowed, as a real64 holding the
+// absolute time would lose all sub-second precision
+static ullong64
+getTimeUS()
+{
+    typedef std::chrono::steady_clock clock;
+    static const clock::time_point start = clock::now();
+    return static_cast<ullong64>(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start).count());
+}
+
+static real64
+getElapsedMS(const ullong64 startUS,
+             const ullong64 endUS)
+{
+    return static_cast<real64>(endUS - startUS) / 1000.0f;
+}
+
+static bool
+loadPackedData(const std::string& meshName,
+               MeshSourceData&    outData)
+{
+    const AssetPack* pack = AssetPack::get();
+    if (!pack->isOpen()) return false;
+
+    // Cooked entries are either used in place or decompressed
+    // into the source data, which then owns them until the upload
+    AssetData asset = {};
+    if (pack->read(MeshStreamer::getCookedPath(meshName), asset))
+    {
+        outData.msd_cookedStorage.swap(asset.ad_storage);
+        if (setCookedView(asset.ad_data, asset.ad_size, outData)) return true;
+        outData.msd_cookedStorage.clear();
+    }
+
+    if (!pack->read(MeshStreamer::getSourcePath(meshName), asset)) return false;
+
+    objparser::ParseStats stats = {};
+    if (!objparser::parse(reinterpret_cast<const char*>(asset.ad_data),
+                          asset.ad_size,
+                          outData.msd_vertices,
+                          outData.msd_indices,
+                          &stats)) return false;
+
+    finalizeImport(stats, outData);
+    return true;
+}
+
+static bool
+setCookedView(const uint8*    data,
+              const size_t    size,
+              MeshSourceData& outData)
+{
+    meshbin::MeshView view = {};
+    if (!meshbin::readView(data, size, view)) return false;
+
+    outData.msd_cookedView   = view;
+    outData.msd_cooked       = true;
+    outData.msd_dimensions   = view.mv_dimensions;
+    outData.msd_bytesRead    = static_cast<uint32>(size);
+    outData.msd_nRawVertices = view.mv_nVertices;
+    return true;
+}
+
+static void
+finalizeImport(const objparser::ParseStats& stats,
+               MeshSourceData&              outData)
+{
+    // The raw figures are those of the parser's face order, before
+    // which every triangle corner used to be a vertex of its own
+    outData.msd_bytesRead    = static_cast<uint32>(stats.ps_bytes);
+    outData.msd_nRawVertices = stats.ps_nTriangles * 3;
+    outData.msd_rawACMR      = meshopt::calculateACMR(outData.msd_indices,
+                                                      outData.msd_vertices.size(),
+                                                      MS_ACMR_CACHE_SIZE);
+
+    meshopt::optimizeVertexCache(outData.msd_indices, outData.msd_vertices.size());
+    meshopt::optimizeVertexFetch(outData.msd_vertices, outData.msd_indices);
+    outData.msd_optimizedACMR = meshopt::calculateACMR(outData.msd_indices,
+                                                       outData.msd_vertices.size(),
+                                                       MS_ACMR_CACHE_SIZE);
+
+    MeshStreamer::calculateDimensions(outData);
+    generateLods(outData);
+}
+
+static void
+generateLods(MeshSourceData& data)
+{
+    data.msd_lods.clear();
+
+    meshbin::LodRange fullDetail = { 0U, static_cast<uint32>(data.msd_indices.size()), 0.0f, 0U };
+    data.msd_lods.push_back(fullDetail);
+
+    // Every level is simplified from the previous one, so that the
+    // errors accumulate monotonically
+    std::vector<uint32> previous(data.msd_indices);
+    std::vector<uint32> simplified;
+    for (uint32 lod = 1;
+                lod < MS_MAX_LODS;
+              ++lod)
+    {
+        if (previous.size() / 3 < MS_LOD_MIN_TRIANGLES) break;
+
+        const size_t targetIndexCount = static_cast<size_t>(previous.size() / 3 * MS_LOD_REDUCTION) * 3;
+        const real32 error = meshsimplify::simplify(data.msd_vertices,
+                                                    previous,
+                                                    targetIndexCount,
+                                                    MS_LOD_MAX_ERROR,
+                                                    simplified);
+
+        if (simplified.empty() || simplified.size() > previous.size() * MS_LOD_MIN_REDUCTION) break;
+
+        meshopt::optimizeVertexCache(simplified, data.msd_vertices.size());
+
+        meshbin::LodRange range = {};
+        range.lr_indexOffset = static_cast<uint32>(data.msd_indices.size());
+        range.lr_indexCount  = static_cast<uint32>(simplified.size());
+        range.lr_error       = math::max2f(error, data.msd_lods.back().lr_error);
+        data.msd_lods.push_back(range);
+
+        data.msd_indices.insert(data.msd_indices.end(), simplified.cbegin(), simplified.cend());
+        previous.swap(simplified);
+    }
+}
+
+static void
+createVertexBuffer(const void*     vertices,
+                   const uint32    vertexStride,
+                   const uint32    nVertices,
+                   MeshCachedData& outData)
+{
+    D3D11_BUFFER_DESC vertexBufferDesc = {};
+    vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    vertexBufferDesc.ByteWidth = vertexStride * nVertices;
+
+    D3D11_SUBRESOURCE_DATA vertexData = {};
+    vertexData.pSysMem = vertices;
+
+    HR(Renderer::get()->getDeviceHandle()->CreateBuffer(&vertexBufferDesc,
+                                                        &vertexData,
+                                                        &outData.mcd_vertexBuffer));
+}
+
+static void
+createIndexBuffer(const meshbin::MeshView& view,
+                  MeshCachedData&          outData)
+{
+    outData.mcd_indexFormat = view.mv_shortIndices ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    outData.mcd_dimensions  = view.mv_dimensions;
+
+    if (view.mv_nLods)
+    {
+        outData.mcd_lods.assign(view.mv_lods, view.mv_lods + view.mv_nLods);
+    }
+    else
+    {
+        meshbin::LodRange fullDetail = { 0U, view.mv_nIndices, 0.0f, 0U };
+        outData.mcd_lods.assign(1U, fullDetail);
+    }
+    outData.mcd_indexCount = outData.mcd_lods[0].lr_indexCount;
+
+    D3D11_BUFFER_DESC indexBufferDesc = {};
+    indexBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    indexBufferDesc.ByteWidth = (view.mv_shortIndices ? sizeof(uint16) : sizeof(uint32)) * view.mv_nIndices;
+
+    D3D11_SUBRESOURCE_DATA indexData = {};
+    indexData.pSysMem = view.mv_indices;
+
+    HR(Renderer::get()->getDeviceHandle()->CreateBuffer(&indexBufferDesc,
+                                                        &indexData,
+                                                        &outData.mcd_indexBuffer));
+}
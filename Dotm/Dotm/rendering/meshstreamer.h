@@ -0,0 +1,278 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        meshstreamer.h
+
+   File description: A singleton owning the mesh
+   cache and the asset streaming pipeline. Mesh
+   files are read and parsed into CPU side vertex
+   and index buffers on the job system, while the
+   GPU buffers are created on the main thread
+   within a per frame time budget. Meshes
+   referencing data that is still in flight
+   render the placeholder mesh instead.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "d3d11common.h"
+#include "mesh.h"
+#include "meshbinary.h"
+#include "vertexquant.h"
+#include "../util/jobsystem.h"
+#include "../util/mappedfile.h"
+#include "../util/math.h"
+#include "../util/strings.h"
+#include "../dotmdef.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// GPU side data shared by all the meshes of the same name.
+// Compact meshes hold vertexquant::CompactVertex vertices
+// along with their dequantization parameters. The index
+// buffer holds every level of detail back to back, as
+// described by mcd_lods (full detail first), and
+// mcd_indexCount is that of the full detail level.
+struct MeshCachedData
+{
+    comptr<ID3D11Buffer>           mcd_vertexBuffer;
+    comptr<ID3D11Buffer>           mcd_indexBuffer;
+    DXGI_FORMAT                    mcd_indexFormat;
+    uint32                         mcd_indexCount;
+    uint32                         mcd_vertexStride;
+    bool                           mcd_compact;
+    vertexquant::QuantParams       mcd_quantParams;
+    std::vector<meshbin::LodRange> mcd_lods;
+    vec3f                          mcd_dimensions;
+    std::atomic<bool>              mcd_ready;
+    std::atomic<bool>              mcd_failed;
+
+    MeshCachedData(): mcd_indexFormat(DXGI_FORMAT_R32_UINT), mcd_indexCount(0U), mcd_vertexStride(sizeof(Mesh::Vertex)),
+                      mcd_compact(false), mcd_quantParams(), mcd_dimensions(), mcd_ready(false), mcd_failed(false) {}
+};
+
+// CPU side data as produced by the mesh importer, along
+// with the import report of the vertex cache optimization.
+// Cooked meshes instead keep their file mapped (or their
+// pack entry decompressed) and point straight into it until
+// the upload. Compacted meshes upload msd_compactVertices in
+// place of the full vertices. Imported meshes carry their
+// levels of detail concatenated in msd_indices, as ranges in
+// msd_lods; an empty msd_lods means msd_indices is the only
+// level.
+struct MeshSourceData
+{
+    std::vector<Mesh::Vertex>                msd_vertices;
+    std::vector<uint32>                      msd_indices;
+    std::vector<meshbin::LodRange>           msd_lods;
+    std::unique_ptr<MappedFile>              msd_cookedFile;
+    std::vector<uint8>                       msd_cookedStorage;
+    meshbin::MeshView                        msd_cookedView;
+    bool                                     msd_cooked;
+    std::vector<vertexquant::CompactVertex>  msd_compactVertices;
+    vertexquant::QuantParams                 msd_quantParams;
+    vec3f                                    msd_dimensions;
+    uint32                                   msd_bytesRead;
+    uint32                                   msd_nRawVertices;
+    real32                                   msd_rawACMR;
+    real32                                   msd_optimizedACMR;
+};
+
+class MeshStreamer
+{
+public:
+
+    struct StreamingStats
+    {
+        uint32 ss_requested;
+        uint32 ss_completed;
+        uint32 ss_failed;
+        uint32 ss_pendingUploads;
+        uint64 ss_bytesRead;
+        uint64 ss_vertexBytes;
+        uint64 ss_fullVertexBytes;
+        real64 ss_totalParseMS;
+        real64 ss_totalUploadMS;
+        real64 ss_maxFrameUploadMS;
+        real64 ss_maxRequestToReadyMS;
+    };
+
+public:
+
+    static MeshStreamer*
+    get();
+
+    static std::string
+    getSourcePath(const std::string& meshName);
+
+    static std::string
+    getCookedPath(const std::string& meshName);
+
+    // <summary>
+    // <para>
+    // Loads the mesh of the given name into outData, preferring the
+    // asset pack over the loose files and cooked meshes over source
+    // ones. Loose cooked files that are outdated or older than their
+    // source mesh file are skipped. Returns false if no form of the
+    // mesh could be loaded. Safe to call from any thread.
+    // </para>
+    // </summary>
+    static bool
+    loadSourceData(const std::string& meshName,
+                   MeshSourceData&    outData);
+
+    // Maps the loose cooked mesh file of the given name into outData,
+    // unless it is missing or stale. Safe to call from any thread
+    static bool
+    loadCookedFile(const std::string& meshName,
+                   MeshSourceData&    outData);
+
+    // <summary>
+    // <para>
+    // Reads and parses the loose source mesh file of the given name
+    // into outData, then optimizes the resulting indexed mesh for the
+    // post-transform vertex cache and generates its levels of detail.
+    // Returns false if the file could not be opened or holds no
+    // vertices or indices. Safe to call from any thread.
+    // </para>
+    // </summary>
+    static bool
+    importSourceData(const std::string& meshName,
+                     MeshSourceData&    outData);
+
+    // Recalculates the bounding dimensions of the source data
+    static void
+    calculateDimensions(MeshSourceData& data);
+
+    // <summary>
+    // <para>
+    // Encodes the vertices of the given source data into the compact
+    // vertex layout. Debug builds verify the encoding error against
+    // the bounds guaranteed by vertexquant.
+    // </para>
+    // </summary>
+    static void
+    compactSourceData(MeshSourceData& data);
+
+    // Creates the GPU buffers for the given source data, with
+    // 16 bit indices whenever the vertex count allows it. Returns
+    // false, creating nothing, if the data has no vertices or indices
+    static bool
+    createBuffers(const MeshSourceData& source,
+                  MeshCachedData&       outData);
+
+public:
+
+    ~MeshStreamer();
+
+    // <summary>
+    // <para>
+    // Returns the cached data of the given mesh, queueing it for
+    // background loading first if it is not present. The returned
+    // data is not ready until a later processUploads.
+    // Safe to call from any thread.
+    // </para>
+    // </summary>
+    std::shared_ptr<MeshCachedData>
+    requestAsync(cstring meshName);
+
+    std::shared_ptr<MeshCachedData>
+    findCached(const stringID meshID) logical_const;
+
+    // Registers the given data unless the mesh is already cached
+    void
+    registerCached(const stringID                         meshID,
+                   const std::shared_ptr<MeshCachedData>& data);
+
+    // <summary>
+    // <para>
+    // Creates the GPU buffers of the meshes parsed so far, stopping
+    // once the per frame upload budget is exceeded. The budget is
+    // read again whenever a config file has been reloaded. Must be
+    // called once per frame from the main thread.
+    // </para>
+    // </summary>
+    void
+    processUploads();
+
+    // <summary>
+    // <para>
+    // Waits for every load in flight, then creates the GPU buffers
+    // of all the parsed meshes regardless of the upload budget. Used
+    // in place of processUploads when meshes must become ready on
+    // the frame after their request, independently of disk timings.
+    // Main thread only.
+    // </para>
+    // </summary>
+    void
+    flushUploads();
+
+    // <summary>
+    // <para>
+    // Blocks until the given data (as returned by requestAsync) is
+    // ready or has failed to load. The calling thread runs queued
+    // jobs while the data loads, then creates its GPU buffers itself
+    // unless processUploads already took them. Safe to call from
+    // any thread. Returns true if the data is ready.
+    // </para>
+    // </summary>
+    bool
+    waitUntilReady(const std::shared_ptr<MeshCachedData>& data);
+
+    // Mesh data rendered in place of data still in flight
+    const MeshCachedData&
+    getPlaceholder() logical_const;
+
+    StreamingStats
+    getStats() logical_const;
+
+private:
+
+    MeshStreamer();
+
+    MeshStreamer(const MeshStreamer& rhs) = delete;
+
+    MeshStreamer&
+    operator = (const MeshStreamer& rhs) = delete;
+
+    void
+    uploadPending(const bool withinBudget);
+
+private:
+
+    struct PendingUpload
+    {
+        stringID                        pu_meshID;
+        std::shared_ptr<MeshCachedData> pu_target;
+        std::shared_ptr<MeshSourceData> pu_source;
+        bool                            pu_failed;
+        real64                          pu_parseMS;
+        ullong64                        pu_requestTimeUS;
+    };
+
+private:
+
+    // Creates the GPU buffers of a parsed upload, or reports its
+    // failure, and records its stats. Safe to call from any thread
+    void
+    completeUpload(const PendingUpload& upload);
+
+private:
+
+    std::unordered_map<stringID, std::shared_ptr<MeshCachedData>> m_cachedMeshes;
+    mutable std::mutex                                           m_cacheMutex;
+    MeshCachedData                                               m_placeholder;
+    mutable std::mutex                                           m_uploadMutex;
+    std::deque<PendingUpload>                                    m_pendingUploads;
+    JobCounter                                                   m_loadJobs;
+    StreamingStats                                               m_stats;
+    real32                                                       m_uploadBudgetMS;
+    uint32                                                       m_configRevision;
+    bool                                                         m_compactVertices;
+
+};
@@ -0,0 +1,552 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        objparser.cpp
+
+   File description: Implementation of the OBJ
+   parsing functions declared in objparser.h
+   ------------------------------------------------ */
+
+#include "objparser.h"
+#include <chrono>
+#include <fstream>
+#include <unordered_map>
+
+/* ---------
+   Constants
+   --------- */
+#define OBJ_MISSING_INDEX     0xFFFFFFFF
+#define OBJ_MAX_MANTISSA_DIGS 19
+#define OBJ_MAX_POW10         22
+
+/* ----------------
+   Internal Structs
+   ---------------- */
+struct VertexPos      { real32 x, y, z;    };
+struct VertexTex      { real32 tu, tv;     };
+struct VertexNor      { real32 nx, ny, nz; };
+struct ObjIndex       { uint32 vertexIndex, texIndex, normIndex;  };
+
+struct ObjIndexHash
+{
+    inline size_t
+    operator () (const ObjIndex& index) logical_const
+    {
+        // Large primes spread the three indices over the whole word
+        return (index.vertexIndex * 73856093U) ^
+               (index.texIndex    * 19349663U) ^
+               (index.normIndex   * 83492791U);
+    }
+};
+
+static inline bool
+operator == (const ObjIndex& lhs, const ObjIndex& rhs)
+{
+    return lhs.vertexIndex == rhs.vertexIndex &&
+           lhs.texIndex    == rhs.texIndex    &&
+           lhs.normIndex   == rhs.normIndex;
+}
+
+/* -------------
+   Internal Vars
+   ------------- */
+static const double s_powersOf10[OBJ_MAX_POW10 + 1] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static inline bool
+isDigit(const char c);
+
+static inline bool
+isBlank(const char c);
+
+static inline const char*
+skipBlanks(const char* p, const char* end);
+
+static inline const char*
+skipLine(const char* p, const char* end);
+
+static bool
+parseFloat(const char*& p, const char* end, real32& outFloat);
+
+static bool
+parseInt(const char*& p, const char* end, int32& outInt);
+
+static bool
+resolveIndex(const int32 rawIndex, const size_t count, uint32& outIndex);
+
+static bool
+parseFaceCorner(const char*&    p,
+                const char*     end,
+                const size_t    nPositions,
+                const size_t    nTexcoords,
+                const size_t    nNormals,
+                ObjIndex&       outIndex);
+
+static bool
+readWholeFile(const std::string& path, std::vector<char>& outBuffer);
+
+/* --------------
+   Public Methods
+   -------------- */
+bool
+objparser::parse(const char*                data,
+                 const size_t               size,
+                 std::vector<Mesh::Vertex>& outVertices,
+                 std::vector<uint32>&       outIndices,
+                 ParseStats*                optStats /* nullptr */)
+{
+    // Disorganized data containers
+    std::vector<VertexPos> disorgPos;
+    std::vector<VertexTex> disorgTexcoords;
+    std::vector<VertexNor> disorgNormals;
+    std::vector<ObjIndex>  objIndices;
+    std::vector<uint32>    triangleCorners;
+
+    // Per face scratch containers
+    std::vector<ObjIndex>  faceIndices;
+    std::vector<uint32>    faceCorners;
+
+    std::unordered_map<ObjIndex, uint32, ObjIndexHash> uniqueCorners;
+
+    // A rough guess that avoids most of the early regrowth
+    disorgPos.reserve(size / 64);
+    disorgTexcoords.reserve(size / 64);
+    disorgNormals.reserve(size / 64);
+    objIndices.reserve(size / 64);
+    uniqueCorners.reserve(size / 64);
+
+    uint32 nFaces   = 0U;
+    uint32 nCorners = 0U;
+
+    const char* p   = data;
+    const char* end = data + size;
+
+    while (p < end)
+    {
+        p = skipBlanks(p, end);
+        if (p >= end) break;
+
+        // vertex
+        if (p[0] == 'v')
+        {
+            const char type = p + 1 < end ? p[1] : '\0';
+
+            // texcoord
+            if (type == 't')
+            {
+                p += 2;
+                VertexTex texcoord = {};
+                if (!parseFloat(p, end, texcoord.tu)) return false;
+
+                // The v coordinate is optional in the spec
+                real32 v = 0.0f;
+                p = skipBlanks(p, end);
+                if (p < end && *p != '\r' && *p != '\n' && !parseFloat(p, end, v)) return false;
+                texcoord.tv = 1 - v;
+
+                disorgTexcoords.push_back(texcoord);
+            }
+            // normal
+            else if (type == 'n')
+            {
+                p += 2;
+                VertexNor normal = {};
+                if (!parseFloat(p, end, normal.nx) ||
+                    !parseFloat(p, end, normal.ny) ||
+                    !parseFloat(p, end, normal.nz)) return false;
+                disorgNormals.push_back(normal);
+            }
+            // position
+            else if (isBlank(type))
+            {
+                p += 1;
+                VertexPos position = {};
+                if (!parseFloat(p, end, position.x) ||
+                    !parseFloat(p, end, position.y) ||
+                    !parseFloat(p, end, position.z)) return false;
+                disorgPos.push_back(position);
+            }
+        }
+        // face
+        else if (p[0] == 'f' && p + 1 < end && isBlank(p[1]))
+        {
+            p += 1;
+
+            faceIndices.clear();
+            for (;;)
+            {
+                p = skipBlanks(p, end);
+                if (p >= end || *p == '\r' || *p == '\n' || *p == '#') break;
+
+                ObjIndex objIndex = {};
+                if (!parseFaceCorner(p,
+                                     end,
+                                     disorgPos.size(),
+                                     disorgTexcoords.size(),
+                                     disorgNormals.size(),
+                                     objIndex)) return false;
+
+                faceIndices.push_back(objIndex);
+            }
+
+            // Degenerate faces are dropped
+            if (faceIndices.size() < 3)
+            {
+                p = skipLine(p, end);
+                continue;
+            }
+            ++nFaces;
+
+            // Corners sharing the same attribute triplet share a vertex
+            faceCorners.clear();
+            for (auto citer = faceIndices.cbegin();
+                      citer != faceIndices.cend();
+                    ++citer)
+            {
+                auto inserted = uniqueCorners.insert(std::make_pair(*citer, static_cast<uint32>(objIndices.size())));
+                if (inserted.second) objIndices.push_back(*citer);
+                faceCorners.push_back(inserted.first->second);
+            }
+
+            // Fan triangulation of the polygon: (0, i, i + 1)
+            for (size_t i = 2;
+                        i < faceCorners.size();
+                      ++i)
+            {
+                triangleCorners.push_back(faceCorners[0]);
+                triangleCorners.push_back(faceCorners[i - 1]);
+                triangleCorners.push_back(faceCorners[i]);
+            }
+            nCorners += faceCorners.size();
+        }
+
+        p = skipLine(p, end);
+    }
+
+    // Calculate the final data
+    const uint32 vertexOffset = outVertices.size();
+    outVertices.reserve(vertexOffset + objIndices.size());
+    for (size_t i = 0;
+                i < objIndices.size();
+              ++i)
+    {
+        Mesh::Vertex finalVertex = {};
+
+        // Position Extraction
+        const VertexPos& pos = disorgPos[objIndices[i].vertexIndex];
+        finalVertex.v_x = pos.x;
+        finalVertex.v_y = pos.y;
+        finalVertex.v_z = pos.z;
+
+        // Tex Coord Extraction
+        if (objIndices[i].texIndex != OBJ_MISSING_INDEX)
+        {
+            const VertexTex& tex = disorgTexcoords[objIndices[i].texIndex];
+            finalVertex.v_tu = tex.tu;
+            finalVertex.v_tv = tex.tv;
+        }
+
+        // Normal Extraction
+        if (objIndices[i].normIndex != OBJ_MISSING_INDEX)
+        {
+            const VertexNor& nor = disorgNormals[objIndices[i].normIndex];
+            finalVertex.v_nx = nor.nx;
+            finalVertex.v_ny = nor.ny;
+            finalVertex.v_nz = nor.nz;
+        }
+
+        outVertices.push_back(finalVertex);
+    }
+
+    outIndices.reserve(outIndices.size() + triangleCorners.size());
+    for (auto citer = triangleCorners.cbegin();
+              citer != triangleCorners.cend();
+            ++citer)
+    {
+        outIndices.push_back(vertexOffset + *citer);
+    }
+
+    if (optStats)
+    {
+        optStats->ps_bytes      = size;
+        optStats->ps_nPositions = disorgPos.size();
+        optStats->ps_nTexcoords = disorgTexcoords.size();
+        optStats->ps_nNormals   = disorgNormals.size();
+        optStats->ps_nFaces     = nFaces;
+        optStats->ps_nCorners   = nCorners;
+        optStats->ps_nVertices  = objIndices.size();
+        optStats->ps_nTriangles = triangleCorners.size() / 3;
+    }
+
+    return true;
+}
+
+bool
+objparser::parseFile(const std::string&         path,
+                     std::vector<Mesh::Vertex>& outVertices,
+                     std::vector<uint32>&       outIndices,
+                     ParseStats*                optStats /* nullptr */)
+{
+    std::vector<char> buffer;
+    if (!readWholeFile(path, buffer)) return false;
+
+    return parse(buffer.empty() ? nullptr : &buffer[0],
+                 buffer.size(),
+                 outVertices,
+                 outIndices,
+                 optStats);
+}
+
+objparser::BenchmarkResult
+objparser::benchmark(const std::string& path,
+                     const uint32       nIterations)
+{
+    typedef std::chrono::high_resolution_clock clock;
+
+    BenchmarkResult result = {};
+    if (!nIterations) return result;
+
+    // Only the parsing is timed, not the file read
+    std::vector<char> buffer;
+    if (!readWholeFile(path, buffer) || buffer.empty()) return result;
+
+    std::vector<Mesh::Vertex> vertices;
+    std::vector<uint32>       indices;
+    ParseStats                stats = {};
+
+    auto parseStart = clock::now();
+    for (uint32 iter = 0;
+                iter < nIterations;
+              ++iter)
+    {
+        vertices.clear();
+        indices.clear();
+        if (!parse(&buffer[0], buffer.size(), vertices, indices, &stats)) return result;
+    }
+    auto parseEnd = clock::now();
+
+    const double totalMillis = std::chrono::duration<double, std::milli>(parseEnd - parseStart).count();
+    const double totalBytes  = static_cast<double>(buffer.size()) * nIterations;
+
+    result.br_bytes       = buffer.size();
+    result.br_nTriangles  = stats.ps_nTriangles;
+    result.br_parseMillis = static_cast<real64>(totalMillis / nIterations);
+    if (totalMillis > 0.0)
+    {
+        result.br_megabytesPerSec = static_cast<real64>((totalBytes / (1024.0 * 1024.0)) /
+                                                        (totalMillis / 1000.0));
+    }
+
+    return result;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static inline bool
+isDigit(const char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static inline bool
+isBlank(const char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+static inline const char*
+skipBlanks(const char* p, const char* end)
+{
+    while (p < end && isBlank(*p)) ++p;
+    return p;
+}
+
+static inline const char*
+skipLine(const char* p, const char* end)
+{
+    while (p < end && *p != '\n') ++p;
+    return p < end ? p + 1 : end;
+}
+
+static bool
+parseFloat(const char*& p, const char* end, real32& outFloat)
+{
+    const char* c = skipBlanks(p, end);
+
+    bool negative = false;
+    if (c < end && (*c == '-' || *c == '+'))
+    {
+        negative = *c == '-';
+        ++c;
+    }
+
+    // Up to 19 significant digits fit in the mantissa, which
+    // is far more precision than a float can hold anyway
+    ullong64 mantissa  = 0ULL;
+    int32    exponent  = 0;
+    int32    nDigits   = 0;
+    bool     anyDigits = false;
+
+    for (; c < end && isDigit(*c); ++c)
+    {
+        anyDigits = true;
+        if (nDigits < OBJ_MAX_MANTISSA_DIGS)
+        {
+            mantissa = mantissa * 10 + (*c - '0');
+            if (mantissa) ++nDigits;
+        }
+        else
+        {
+            ++exponent;
+        }
+    }
+
+    if (c < end && *c == '.')
+    {
+        for (++c; c < end && isDigit(*c); ++c)
+        {
+            anyDigits = true;
+            if (nDigits < OBJ_MAX_MANTISSA_DIGS)
+            {
+                mantissa = mantissa * 10 + (*c - '0');
+                if (mantissa) ++nDigits;
+                --exponent;
+            }
+        }
+    }
+
+    if (!anyDigits) return false;
+
+    if (c < end && (*c == 'e' || *c == 'E'))
+    {
+        ++c;
+        bool negativeExp = false;
+        if (c < end && (*c == '-' || *c == '+'))
+        {
+            negativeExp = *c == '-';
+            ++c;
+        }
+
+        if (c >= end || !isDigit(*c)) return false;
+
+        int32 explicitExp = 0;
+        for (; c < end && isDigit(*c); ++c)
+        {
+            if (explicitExp < 10000) explicitExp = explicitExp * 10 + (*c - '0');
+        }
+        exponent += negativeExp ? -explicitExp : explicitExp;
+    }
+
+    double value = static_cast<double>(mantissa);
+    if (value != 0.0)
+    {
+        for (; exponent > OBJ_MAX_POW10; exponent -= OBJ_MAX_POW10)  value *= s_powersOf10[OBJ_MAX_POW10];
+        for (; exponent < -OBJ_MAX_POW10; exponent += OBJ_MAX_POW10) value /= s_powersOf10[OBJ_MAX_POW10];
+        value = exponent < 0 ? value / s_powersOf10[-exponent] : value * s_powersOf10[exponent];
+    }
+
+    outFloat = static_cast<real32>(negative ? -value : value);
+    p = c;
+    return true;
+}
+
+static bool
+parseInt(const char*& p, const char* end, int32& outInt)
+{
+    const char* c = p;
+
+    bool negative = false;
+    if (c < end && (*c == '-' || *c == '+'))
+    {
+        negative = *c == '-';
+        ++c;
+    }
+
+    if (c >= end || !isDigit(*c)) return false;
+
+    int32 value = 0;
+    for (; c < end && isDigit(*c); ++c)
+    {
+        value = value * 10 + (*c - '0');
+    }
+
+    outInt = negative ? -value : value;
+    p = c;
+    return true;
+}
+
+static bool
+resolveIndex(const int32 rawIndex, const size_t count, uint32& outIndex)
+{
+    // OBJ indices are 1 based, and negative indices are
+    // relative to the attributes declared so far
+    if (rawIndex > 0 && static_cast<size_t>(rawIndex) <= count)
+    {
+        outIndex = rawIndex - 1;
+        return true;
+    }
+    if (rawIndex < 0 && static_cast<size_t>(-rawIndex) <= count)
+    {
+        outIndex = count + rawIndex;
+        return true;
+    }
+    return false;
+}
+
+static bool
+parseFaceCorner(const char*&    p,
+                const char*     end,
+                const size_t    nPositions,
+                const size_t    nTexcoords,
+                const size_t    nNormals,
+                ObjIndex&       outIndex)
+{
+    // Accepted forms: v, v/vt, v//vn, v/vt/vn
+    int32 rawIndex = 0;
+    if (!parseInt(p, end, rawIndex) ||
+        !resolveIndex(rawIndex, nPositions, outIndex.vertexIndex)) return false;
+
+    outIndex.texIndex  = OBJ_MISSING_INDEX;
+    outIndex.normIndex = OBJ_MISSING_INDEX;
+
+    if (p >= end || *p != '/') return true;
+    ++p;
+
+    if (p < end && *p != '/')
+    {
+        if (!parseInt(p, end, rawIndex) ||
+            !resolveIndex(rawIndex, nTexcoords, outIndex.texIndex)) return false;
+    }
+
+    if (p >= end || *p != '/') return true;
+    ++p;
+
+    if (!parseInt(p, end, rawIndex) ||
+        !resolveIndex(rawIndex, nNormals, outIndex.normIndex)) return false;
+
+    return true;
+}
+
+static bool
+readWholeFile(const std::string& path, std::vector<char>& outBuffer)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+
+    const std::streamoff fileSize = file.tellg();
+    if (fileSize < 0) return false;
+
+    outBuffer.resize(static_cast<size_t>(fileSize));
+    file.seekg(0, std::ios::beg);
+    if (fileSize > 0 && !file.read(&outBuffer[0], fileSize)) return false;
+
+    return true;
+}
@@ -0,0 +1,79 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        objparser.h
+
+   File description: A single pass Wavefront OBJ
+   parser. The whole file is read into one buffer
+   which is then scanned in place, without any per
+   line string allocation. Polygonal faces are
+   triangulated as fans, negative (relative) indices
+   are resolved and missing texcoord or normal
+   indices produce zeroed attributes. Face corners
+   sharing the same position/texcoord/normal triplet
+   are merged into a single indexed vertex.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "mesh.h"
+#include "../dotmdef.h"
+#include <string>
+#include <vector>
+
+namespace objparser
+{
+    struct ParseStats
+    {
+        uint64 ps_bytes;
+        uint32 ps_nPositions;
+        uint32 ps_nTexcoords;
+        uint32 ps_nNormals;
+        uint32 ps_nFaces;
+        uint32 ps_nCorners;
+        uint32 ps_nVertices;
+        uint32 ps_nTriangles;
+    };
+
+    struct BenchmarkResult
+    {
+        uint64 br_bytes;
+        uint32 br_nTriangles;
+        real64 br_parseMillis;
+        real64 br_megabytesPerSec;
+    };
+
+    // <summary>
+    // <para>
+    // Parses the OBJ data in [data, data + size) and appends one
+    // vertex per unique face corner to outVertices, with the
+    // triangle list indices appended to outIndices. Returns false
+    // if the data is malformed or references missing attributes.
+    // </para>
+    // </summary>
+    bool
+    parse(const char*                data,
+          const size_t               size,
+          std::vector<Mesh::Vertex>& outVertices,
+          std::vector<uint32>&       outIndices,
+          ParseStats*                optStats = nullptr);
+
+    // <summary>
+    // <para>
+    // Reads the whole file at the given path into memory and
+    // parses it. Returns false if the file could not be opened
+    // or parsed.
+    // </para>
+    // </summary>
+    bool
+    parseFile(const std::string&         path,
+              std::vector<Mesh::Vertex>& outVertices,
+              std::vector<uint32>&       outIndices,
+              ParseStats*                optStats = nullptr);
+
+    // Parses the given file nIterations times from memory and
+    // reports the parser's throughput
+    BenchmarkResult
+    benchmark(const std::string& path,
+              const uint32       nIterations);
+}
@@ -8,22 +8,60 @@
    --------------------------------------------- */
 
 #include "renderer.h"
+#include "d3d11executor.h"
 #include "mesh.h"
 #include "texture.h"
 #include "font.h"
 #include "lights.h"
+#include "../config/configparser.h"
 #include "../game/camera.h"
 #include "../game/scene.h"
 #include "../game/entity.h"
+#include "../game/healthbar.h"
+#include "../handlers/inputhandler.h"
 #include "../window.h"
 #include "../util/logging.h"
 #include "../util/physics.h"
+#include "../util/profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+// Uncomment to periodically log the batched culling
+// timings against the per mesh intersection path
+//#define CULLING_BENCHMARK
+
+// Uncomment to periodically log the clustered light
+// assignment timings
+//#define LIGHT_CLUSTER_BENCHMARK
+
+/* ---------
+   Constants
+   --------- */
+#define CULLING_BENCHMARK_INTERVAL   600
+#define CULLING_BENCHMARK_ITERATIONS 100
+#define DEFAULT_LOD_PIXEL_ERROR      1.0f
+#define MAX_INSTANCES_PER_DRAW       4096
+#define MIN_STRUCTURED_CAPACITY      64
+#define CLUSTER_LIGHTS_SLOT          1
+#define CLUSTER_RANGES_SLOT          2
+#define CLUSTER_INDICES_SLOT         3
+#define CLUSTER_PARAMS_SLOT          1
 
 /* -------------
    External Vars
    ------------- */
 extern Window* g_window;
 
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static uint32
+getSortID(std::unordered_map<const void*, uint32>& sortIDs,
+          const void*                              object,
+          const uint32                             bits);
+
 /* --------------
    Public Methods
    -------------- */
@@ -36,12 +74,19 @@ Renderer::get()
 
 Renderer::~Renderer()
 {
-    if (m_d3dState)           delete m_d3dState;
-    if (m_stdShader)          delete m_stdShader;
-    if (m_hudShader)          delete m_hudShader;
-    if (m_bilShader)          delete m_bilShader;
-    if (m_font)               delete m_font;
-    if (m_currentLightBuffer) delete m_currentLightBuffer;
+    if (m_d3dState)                  delete m_d3dState;
+    if (m_stdShader)                 delete m_stdShader;
+    if (m_hudShader)                 delete m_hudShader;
+    if (m_bilShader)                 delete m_bilShader;
+    if (m_stdCompactShader)          delete m_stdCompactShader;
+    if (m_bilCompactShader)          delete m_bilCompactShader;
+    if (m_stdInstancedShader)        delete m_stdInstancedShader;
+    if (m_bilInstancedShader)        delete m_bilInstancedShader;
+    if (m_stdCompactInstancedShader) delete m_stdCompactInstancedShader;
+    if (m_bilCompactInstancedShader) delete m_bilCompactInstancedShader;
+    if (m_font)                      delete m_font;
+    if (m_currentLightBuffer)        delete m_currentLightBuffer;
+    if (m_executor)                  delete m_executor;
     
     for (auto iter = m_primitiveModels.begin();
               iter != m_primitiveModels.end();
@@ -54,6 +99,12 @@ Renderer::~Renderer()
 void
 Renderer::beginFrame()
 {
+    m_lastFrameStats = m_frameStats;
+    m_frameStats     = FrameStats();
+    m_boundState     = BoundState();
+    m_commandList.clear();
+    m_textVertices.clear();
+
     FLOAT clearColor[4] = {1.0f, 0.0f, 0.6f, 1.0f};
     m_d3dState->m_devcon->ClearRenderTargetView(m_d3dState->m_backBuffer.Get(),
                                                 clearColor);
@@ -66,48 +117,97 @@ Renderer::beginFrame()
 
 void
 Renderer::endFrame()
-{        
-    uint32 syncInterval = m_d3dState->m_vsync ? 1 : 0;
+{
+    PROFILE_ZONE("Renderer::endFrame");
+
+    renderText();
+
+    m_frameStats.fs_constantBytes = static_cast<uint32>(m_commandList.getConstantBytes());
+    m_executor->execute(m_commandList);
+
+    // Replays run unthrottled
+    uint32 syncInterval = m_d3dState->m_vsync && !InputHandler::get()->isReplaying() ? 1 : 0;
     m_d3dState->m_swapChain->Present(syncInterval, 0);    
 }
 
 void
 Renderer::renderScene(const Scene* scene)
-{   
+{
+    PROFILE_ZONE("Renderer::renderScene");
+
+    if (!m_currentCam)
+    {
+        logline("Camera has not been set");
+        return;
+    }
+
+    math::Frustum camFrustum;
+    m_currentCam->calculateFrustum(&camFrustum);
+
     // Light accumulation
     m_currentLightBuffer->clear();
+    m_clusterLights.clear();
+
+    const std::vector<const DirectionalLight*>& directionalLights = scene->getDirectionalLights();
+    const size_t nDirectionalLights = std::min<size_t>(directionalLights.size(),
+                                                       Shader::SHADER_MAX_DIRECTIONAL_LIGHTS);
+    for (size_t i = 0;
+                i < nDirectionalLights;
+              ++i)
+    {
+        const DirectionalLight* dl = directionalLights[i];
+        m_currentLightBuffer->pcb_directionalLights[i].dl_ambientColor = dl->getAmbientColor();
+        m_currentLightBuffer->pcb_directionalLights[i].dl_diffuseColor = dl->getDiffuseColor();
+        m_currentLightBuffer->pcb_directionalLights[i].dl_direction    = dl->getDirection();
+    }
+
+    // Point lights whose range sphere is outside the frustum light
+    // nothing on screen, so the limited slots go to visible ones
+    const std::vector<const PointLight*>& pointLights = scene->getPointLights();
+    m_lightSpheres.clear();
+    for (auto citer = pointLights.cbegin();
+              citer != pointLights.cend();
+            ++citer)
+    {
+        m_lightSpheres.push((*citer)->getPosition(), (*citer)->getRange());
+    }
+
+    culling::cullSpheres(camFrustum, m_lightSpheres, m_visibleLights);
 
-    size_t dlIndex = 0U;
     size_t plIndex = 0U;
-    
-    auto lightVec = scene->getLights();
-    for (auto lbegin = lightVec.cbegin();
-              lbegin != lightVec.cend();
-            ++lbegin)
+    for (auto citer = m_visibleLights.cbegin();
+              citer != m_visibleLights.cend();
+            ++citer)
     {
-        switch ((*lbegin)->getType())
+        const PointLight* pl = pointLights[*citer];
+
+        // The clustered shaders see every visible point light,
+        // the rest only the first few
+        if (m_clusteredLighting)
         {
-            case Light::LIGHT_DIRECTIONAL:
-            {
-                if (dlIndex >= Shader::SHADER_MAX_DIRECTIONAL_LIGHTS) continue;
-                const DirectionalLight* dl = dynamic_cast<const DirectionalLight*>(*lbegin);
-                m_currentLightBuffer->pcb_directionalLights[dlIndex].dl_ambientColor = dl->getAmbientColor();
-                m_currentLightBuffer->pcb_directionalLights[dlIndex].dl_diffuseColor = dl->getDiffuseColor();
-                m_currentLightBuffer->pcb_directionalLights[dlIndex].dl_direction    = dl->getDirection();                
-                ++dlIndex;
-            } break;
-
-            case Light::LIGHT_POINT:
-            {
-                if (plIndex >= Shader::SHADER_MAX_POINT_LIGHTS) continue;
-                const PointLight* pl = dynamic_cast<const PointLight*>(*lbegin);
-                m_currentLightBuffer->pcb_pointLights[plIndex].pl_ambientColor = pl->getAmbientColor();
-                m_currentLightBuffer->pcb_pointLights[plIndex].pl_diffuseColor = pl->getDiffuseColor();
-                m_currentLightBuffer->pcb_pointLights[plIndex].pl_position     = pl->getPosition();
-                m_currentLightBuffer->pcb_pointLights[plIndex].pl_range        = pl->getRange();
-                ++plIndex;
-            } break;
+            lightcluster::ClusterLight light = {};
+            light.cl_ambientColor = pl->getAmbientColor();
+            light.cl_diffuseColor = pl->getDiffuseColor();
+            light.cl_position     = pl->getPosition();
+            light.cl_range        = pl->getRange();
+            m_clusterLights.push_back(light);
         }
+
+        if (plIndex >= Shader::SHADER_MAX_POINT_LIGHTS) continue;
+        m_currentLightBuffer->pcb_pointLights[plIndex].pl_ambientColor = pl->getAmbientColor();
+        m_currentLightBuffer->pcb_pointLights[plIndex].pl_diffuseColor = pl->getDiffuseColor();
+        m_currentLightBuffer->pcb_pointLights[plIndex].pl_position     = pl->getPosition();
+        m_currentLightBuffer->pcb_pointLights[plIndex].pl_range        = pl->getRange();
+        ++plIndex;
+    }
+
+    // The new lights are bound with the next draw
+    m_boundState.bs_lightsBound = false;
+
+    if (m_clusteredLighting)
+    {
+        bindClusteredLights(m_currentCam->calculateViewMatrix(),
+                            m_currentCam->calculateProjectionMatrix());
     }
 
     // Aggregate mesh list
@@ -135,16 +235,59 @@ Renderer::renderScene(const Scene* scene)
             }
         }
     }
-    
-    // Normal mesh rendering
+
+    // Batched visibility test over the whole mesh list
+    m_cullSpheres.clear();
     for (auto citer = meshList.cbegin();
               citer != meshList.cend();
             ++citer)
-    {       
-        renderMesh(*citer,
-                   0,
-                   (*citer)->getSpecialVCBuffer(),
-                   (*citer)->getSpecialPCBuffer());
+    {
+        vec3f meshDimensions = (*citer)->calculateDimensions();
+        m_cullSpheres.push((*citer)->position,
+                           math::max3f(meshDimensions.x,
+                                       meshDimensions.y,
+                                       meshDimensions.z));
+    }
+
+    culling::cullSpheres(camFrustum, m_cullSpheres, m_visibleIndices);
+
+#ifdef CULLING_BENCHMARK
+    static uint32 benchFrameCounter = 0U;
+    if (++benchFrameCounter == CULLING_BENCHMARK_INTERVAL)
+    {
+        benchFrameCounter = 0U;
+        culling::BenchmarkResult bench = culling::benchmark(camFrustum,
+                                                            m_cullSpheres,
+                                                            CULLING_BENCHMARK_ITERATIONS);
+        logstring("Culling spheres: ");
+        logline(bench.br_nSpheres);
+        logstring("Culling visible: ");
+        logline(bench.br_nVisible);
+        logstring("Batched culling (us): ");
+        logline(bench.br_batchedMicros);
+        logstring("Per mesh culling (us): ");
+        logline(bench.br_perMeshMicros);
+    }
+#endif
+
+    // Normal mesh rendering, in sort key order
+    buildDrawQueue(meshList);
+    if (m_stdInstancedShader)
+    {
+        renderDrawQueueInstanced(meshList);
+    }
+    else
+    {
+        for (auto citer = m_drawItems.cbegin();
+                  citer != m_drawItems.cend();
+                ++citer)
+        {
+            const Mesh* mesh = meshList[citer->di_index];
+            submitMesh(mesh,
+                       0,
+                       mesh->getSpecialVCBuffer(),
+                       mesh->getSpecialPCBuffer());
+        }
     }
 
     // Highlighted mesh rendering 
@@ -158,7 +301,7 @@ Renderer::renderScene(const Scene* scene)
             // Insidious Highlighting hack
             Mesh* mesh = const_cast<Mesh*>(*bodyBegin);
             mesh->scale = vec3f(1.08f, 1.08f, 1.08f);
-            m_d3dState->m_devcon->OMSetDepthStencilState(m_d3dState->m_disabledDepth.Get(), 1);
+            setDepthState(CommandList::DEPTH_DISABLED);
             if(highlightedEntity->isEnemy()) 
             {
                 renderMesh(mesh, 2);
@@ -167,23 +310,20 @@ Renderer::renderScene(const Scene* scene)
             {
                 renderMesh(mesh, 1);
             }
-            m_d3dState->m_devcon->OMSetDepthStencilState(m_d3dState->m_enabledDepth.Get(), 1);
-            m_d3dState->m_devcon->ClearDepthStencilView(m_d3dState->m_depthStencilView.Get(),
-                                                        D3D11_CLEAR_DEPTH,
-                                                        1.0f,
-                                                        0);
+            setDepthState(CommandList::DEPTH_ENABLED);
+            m_commandList.clearDepth();
             mesh->setHighlighted(false);
             mesh->scale = vec3f(1.0f, 1.0f, 1.0f);
             renderMesh(mesh);
         }
     }
     
-    // Finally render healthbars
-    for (auto iter = scene->getEnemies().begin();
-              iter != scene->getEnemies().end();
-            ++iter)
+    // Finally render healthbars, one instanced draw per bar mesh
+    for (auto citer = scene->getHealthbarSystems().cbegin();
+              citer != scene->getHealthbarSystems().cend();
+            ++citer)
     {
-        (*iter)->renderInternalComponents();
+        (*citer)->render();
     }
 }
 
@@ -193,7 +333,7 @@ Renderer::renderPrimitive(const Primitive       primitive,
                           const DebugColor      debugColor,
                           const bool            wireframe)
 {
-    if (wireframe) m_d3dState->m_devcon->RSSetState(m_d3dState->m_wireFrameRastState.Get());
+    if (wireframe) m_commandList.setRasterState(CommandList::RASTER_WIREFRAME);
     
     Mesh* mesh = m_primitiveModels[primitive];
     if (!mesh) return;
@@ -261,7 +401,7 @@ Renderer::renderPrimitive(const Primitive       primitive,
     mesh->loadNewTexture(texName);
     renderMesh(mesh);
     
-    if (wireframe) m_d3dState->m_devcon->RSSetState(m_d3dState->m_solidRastState.Get());
+    if (wireframe) m_commandList.setRasterState(CommandList::RASTER_SOLID);
 }
 
 void
@@ -269,20 +409,13 @@ Renderer::renderString(const cstring str,
                        const real32  x,
                        const real32  y)
 {
-    real32 xCounter = x;
-    for (size_t i = 0;
-                i < strlen(str);
-              ++i, xCounter += m_font->getSize() / 1.5f)
-    {
-        uint8 currChar = str[i];
-        if (currChar == ' ') continue;
-
-        std::shared_ptr<Mesh> currGlyph = m_font->getGlyph(currChar);
-        
-        currGlyph->position.x = xCounter;
-        currGlyph->position.y = y;
-        renderMesh(currGlyph.get());        
-    }
+    textbatch::appendString(m_font->getGlyphTable(),
+                            str,
+                            x,
+                            y,
+                            m_font->getSize(),
+                            g_window->getAspect(),
+                            m_textVertices);
 }
 
 void
@@ -292,56 +425,94 @@ Renderer::renderMesh(const Mesh* mesh,
                      Shader::PSCBuffer* externPixelBuffer /* nullptr */)
 {
     if (!mesh) return;
+    if (!m_currentCam)
+    {
+        logline("Camera has not been set");
+        return;
+    }
     if (!mesh->isHUDElement() && !testVisible(mesh)) return;    
+
+    submitMesh(mesh, highlightOption, externVertexBuffer, externPixelBuffer);
+}
+
+void
+Renderer::renderMeshInstances(const Mesh*                                  mesh,
+                              const std::vector<instancing::InstanceData>& instances)
+{
+    if (!mesh || instances.empty()) return;
     if (!m_currentCam)
     {
         logline("Camera has not been set");
         return;
     }
-        
-    uint32 stride = sizeof(Mesh::Vertex);
-    uint32 offset = 0U;
 
-    mat4x4 projMatrix = m_currentCam->calculateProjectionMatrix();
-    mat4x4 viewMatrix = m_currentCam->calculateViewMatrix();    
-    mat4x4 worldMat = mesh->getWorldMatrix();    
-    mat4x4 finalMat = worldMat * viewMatrix * projMatrix;  
-    mat4x4 rotMat = mesh->getRotationMatrix();
+    const mat4x4 projMatrix = m_currentCam->calculateProjectionMatrix();
+    const mat4x4 viewMatrix = m_currentCam->calculateViewMatrix();
 
-    Shader::VSCBuffer vcbuffer = {};
-    vcbuffer.vcb_mvpMatrix         = finalMat;
-    vcbuffer.vcb_rotationMatrix    = rotMat;
-    vcbuffer.vcb_worldMatrix       = worldMat;
-    vcbuffer.vcb_eyePosition       = math::getVec4f(m_currentCam->getPosition());
-    vcbuffer.vcb_highlight         = highlightOption;    
+    Shader* shader = selectInstancedShader(mesh);
+    if (!shader)
+    {
+        // Per instance draws with the instance's matrix, whose
+        // rotation part is not known separately
+        Shader::VSCBuffer vcbuffer = {};
+        D3DXMatrixIdentity(&vcbuffer.vcb_rotationMatrix);
+        vcbuffer.vcb_eyePosition       = math::getVec4f(m_currentCam->getPosition());
+        for (auto citer = instances.cbegin();
+                  citer != instances.cend();
+                ++citer)
+        {
+            vcbuffer.vcb_worldMatrix = mesh->hasCompactVertices() ?
+                                       mesh->getDequantizationMatrix() * citer->id_worldMatrix :
+                                       citer->id_worldMatrix;
+            vcbuffer.vcb_mvpMatrix   = vcbuffer.vcb_worldMatrix * viewMatrix * projMatrix;
+            vcbuffer.vcb_highlight   = citer->id_highlight;
+            submitMesh(mesh, citer->id_highlight, &vcbuffer, nullptr);
+        }
+        return;
+    }
 
-    Shader* currentShader = nullptr;
-    if (mesh->isHUDElement())   currentShader   = m_hudShader;
-    else if (mesh->isBillboard() ||
-             mesh->noLighting()) currentShader  = m_bilShader;
-    else currentShader                          = m_stdShader;
-        
-    Shader::VSCBuffer* finalVCBuffer = externVertexBuffer ? externVertexBuffer : &vcbuffer;
-    Shader::PSCBuffer* finalPCBuffer = externPixelBuffer  ? externPixelBuffer  : m_currentLightBuffer;
+    // The dequantization of compact meshes is folded into each
+    // instance's world matrix, as in the scene's instanced path
+    const std::vector<instancing::InstanceData>* finalInstances = &instances;
+    if (mesh->hasCompactVertices())
+    {
+        m_instances = instances;
+        for (auto iter = m_instances.begin();
+                  iter != m_instances.end();
+                ++iter)
+        {
+            iter->id_worldMatrix = mesh->getDequantizationMatrix() * iter->id_worldMatrix;
+        }
+        finalInstances = &m_instances;
+    }
 
-    m_d3dState->m_devcon->UpdateSubresource(currentShader->getVSCBuffer().Get(), NULL, NULL, finalVCBuffer, NULL, NULL);
-    m_d3dState->m_devcon->UpdateSubresource(currentShader->getPSCBuffer().Get(), NULL, NULL, finalPCBuffer, NULL, NULL);
+    const uint32 nInstances    = static_cast<uint32>(finalInstances->size());
+    const uint32 firstInstance = m_commandList.appendInstances(&(*finalInstances)[0],
+                                                               nInstances,
+                                                               sizeof(instancing::InstanceData));
 
-    m_d3dState->m_devcon->IASetVertexBuffers(0, 1, mesh->getVertexBuffer().GetAddressOf(), &stride, &offset);
-    m_d3dState->m_devcon->IASetIndexBuffer(mesh->getIndexBuffer().Get(), DXGI_FORMAT_R32_UINT, 0U);
-    m_d3dState->m_devcon->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    
-    m_d3dState->m_devcon->VSSetShader(currentShader->getVertexShader().Get(), NULL, NULL);
-    m_d3dState->m_devcon->VSSetConstantBuffers(0, 1, currentShader->getVSCBuffer().GetAddressOf());
+    bindInstancedConstants(viewMatrix, projMatrix);
+    bindDrawState(shader, mesh);
 
-    m_d3dState->m_devcon->PSSetShader(currentShader->getPixelShader().Get(), NULL, NULL);
-    m_d3dState->m_devcon->PSSetConstantBuffers(0, 1, currentShader->getPSCBuffer().GetAddressOf());
-    m_d3dState->m_devcon->PSSetShaderResources(0, 1, mesh->getTexture()->getTexturePointer().GetAddressOf());
-    
-    if  (mesh->isHUDElement()) m_d3dState->m_devcon->OMSetDepthStencilState(m_d3dState->m_disabledDepth.Get(), 1);
-    if (!mesh->isHUDElement()) m_d3dState->m_devcon->OMSetDepthStencilState(m_d3dState->m_enabledDepth.Get(), 1);
-    
-    m_d3dState->m_devcon->DrawIndexed(mesh->getIndexCount(), 0, 0);    
+    uint32 indexOffset = 0U, indexCount = 0U;
+    mesh->getLodIndices(0U, indexOffset, indexCount);
+
+    for (uint32 drawn = 0U;
+                drawn < nInstances;
+                drawn += MAX_INSTANCES_PER_DRAW)
+    {
+        const uint32 nDrawInstances = std::min<uint32>(nInstances - drawn, MAX_INSTANCES_PER_DRAW);
+
+        ++m_frameStats.fs_drawCalls;
+        m_frameStats.fs_instancedMeshes     += nDrawInstances;
+        m_frameStats.fs_triangles           += indexCount / 3 * nDrawInstances;
+        m_frameStats.fs_fullDetailTriangles += mesh->getIndexCount() / 3 * nDrawInstances;
+
+        m_commandList.drawIndexedInstanced(indexCount,
+                                           nDrawInstances,
+                                           indexOffset,
+                                           firstInstance + drawn);
+    }
 }
 
 void
@@ -362,26 +533,615 @@ Renderer::getDevconHandle() bitwise_const
     return m_d3dState->m_devcon;
 }
 
+const Renderer::FrameStats&
+Renderer::getFrameStats() logical_const
+{
+    return m_lastFrameStats;
+}
+
+const CommandList&
+Renderer::getFrameCommands() logical_const
+{
+    return m_commandList;
+}
+
 /* ---------------
    Private Methods
    --------------- */
+void
+Renderer::submitMesh(const Mesh*        mesh,
+                     const int          highlightOption,
+                     Shader::VSCBuffer* externVertexBuffer,
+                     Shader::PSCBuffer* externPixelBuffer)
+{
+    // Compact vertices arrive normalized to the mesh bounds, so
+    // the dequantization is folded into the world matrix. Normals
+    // only go through the rotation matrix and are unaffected
+    const bool compact = mesh->hasCompactVertices();
+
+    mat4x4 projMatrix = m_currentCam->calculateProjectionMatrix();
+    mat4x4 viewMatrix = m_currentCam->calculateViewMatrix();    
+    mat4x4 worldMat = compact ? mesh->getDequantizationMatrix() * mesh->getWorldMatrix() :
+                                mesh->getWorldMatrix();
+    mat4x4 finalMat = worldMat * viewMatrix * projMatrix;  
+    mat4x4 rotMat = mesh->getRotationMatrix();
+
+    Shader::VSCBuffer vcbuffer = {};
+    vcbuffer.vcb_mvpMatrix         = finalMat;
+    vcbuffer.vcb_rotationMatrix    = rotMat;
+    vcbuffer.vcb_worldMatrix       = worldMat;
+    vcbuffer.vcb_eyePosition       = math::getVec4f(m_currentCam->getPosition());
+    vcbuffer.vcb_highlight         = highlightOption;    
+
+    Shader* currentShader = selectShader(mesh);
+    if (!currentShader) return;
+        
+    Shader::VSCBuffer* finalVCBuffer = externVertexBuffer ? externVertexBuffer : &vcbuffer;
+    Shader::PSCBuffer* finalPCBuffer = externPixelBuffer  ? externPixelBuffer  : m_currentLightBuffer;
+
+    m_commandList.bindConstants(CommandList::STAGE_VERTEX, 0U, finalVCBuffer, sizeof(Shader::VSCBuffer));
+    bindPixelConstants(finalPCBuffer);
+
+    bindDrawState(currentShader, mesh);
+
+    uint32 indexOffset = 0U, indexCount = 0U;
+    mesh->getLodIndices(selectMeshLod(mesh, projMatrix), indexOffset, indexCount);
+
+    ++m_frameStats.fs_drawCalls;
+    m_frameStats.fs_triangles           += indexCount / 3;
+    m_frameStats.fs_fullDetailTriangles += mesh->getIndexCount() / 3;
+
+    m_commandList.drawIndexed(indexCount, indexOffset);
+}
+
 Renderer::Renderer():
 
     m_d3dState(new D3D11State()),        
-    m_stdShader(new Shader("std")),
+    m_executor(new D3D11Executor(m_d3dState)),
+    m_stdShader(nullptr),
     m_hudShader(new Shader("hud")),
     m_bilShader(new Shader("bil")),
+    m_stdCompactShader(nullptr),
+    m_bilCompactShader(nullptr),
+    m_stdInstancedShader(nullptr),
+    m_bilInstancedShader(nullptr),
+    m_stdCompactInstancedShader(nullptr),
+    m_bilCompactInstancedShader(nullptr),
     m_font(new Font("font_1", 0.1f)),
-    m_currentLightBuffer(new Shader::PSCBuffer)
+    m_currentLightBuffer(new Shader::PSCBuffer),
+    m_lodPixelError(DEFAULT_LOD_PIXEL_ERROR),
+    m_frameStats(),
+    m_lastFrameStats(),
+    m_boundState(),
+    m_clusteredLighting(false),
+    m_clusterLightBuffer(),
+    m_clusterRangeBuffer(),
+    m_clusterIndexBuffer()
 {   
+    // Variants decoding the compact vertex layout, for meshes
+    // streamed in with compact_vertices enabled
+    bool compactVertices = false;
+    bool instancing      = false;
+    if (config::initConfigFile("rendconfig"))
+    {
+        config::extractConfigBool("rendconfig", "compact_vertices", &compactVertices);
+        config::extractConfigBool("rendconfig", "instancing", &instancing);
+        config::extractConfigFloat("rendconfig", "lod_pixel_error", &m_lodPixelError);
+        config::extractConfigBool("rendconfig", "clustered_lighting", &m_clusteredLighting);
+    }
+
+    // The lit shaders have variants reading their point lights
+    // from the light clusters instead of the pixel constants
+    const std::string litSuffix = m_clusteredLighting ? "_clustered" : "";
+
+    m_stdShader = new Shader(("std" + litSuffix).c_str());
+    if (compactVertices)
+    {
+        m_stdCompactShader = new Shader(("std_compact" + litSuffix).c_str(), true);
+        m_bilCompactShader = new Shader("bil_compact", true);
+    }
+
+    // Variants taking the world matrix from the instance buffer,
+    // for the instanced scene rendering path
+    if (instancing)
+    {
+        m_stdInstancedShader = new Shader(("std_inst" + litSuffix).c_str(), false, true);
+        m_bilInstancedShader = new Shader("bil_inst", false, true);
+        if (compactVertices)
+        {
+            m_stdCompactInstancedShader = new Shader(("std_compact_inst" + litSuffix).c_str(), true, true);
+            m_bilCompactInstancedShader = new Shader("bil_compact_inst", true, true);
+        }
+    }
+
     // Preload debug textures
     Texture red("debug_red");
     Texture cyan("debug_cyan");
     Texture yellow("debug_yellow");
 
-    m_primitiveModels[Primitive::CUBE]   = new Mesh("sample_cube",   Mesh::MESH_TYPE_NORMAL);
-    m_primitiveModels[Primitive::PLANE]  = new Mesh("sample_plane",  Mesh::MESH_TYPE_NORMAL);
-    m_primitiveModels[Primitive::SPHERE] = new Mesh("sample_sphere", Mesh::MESH_TYPE_NORMAL);
+    m_primitiveModels[Primitive::CUBE]   = new Mesh("sample_cube",   Mesh::MESH_TYPE_NORMAL | Mesh::MESH_LOAD_ASYNC);
+    m_primitiveModels[Primitive::PLANE]  = new Mesh("sample_plane",  Mesh::MESH_TYPE_NORMAL | Mesh::MESH_LOAD_ASYNC);
+    m_primitiveModels[Primitive::SPHERE] = new Mesh("sample_sphere", Mesh::MESH_TYPE_NORMAL | Mesh::MESH_LOAD_ASYNC);
+}
+
+Shader*
+Renderer::selectShader(const Mesh* mesh) bitwise_const
+{
+    const bool compact = mesh->hasCompactVertices();
+
+    if (mesh->isHUDElement())    return m_hudShader;
+    if (mesh->isBillboard() ||
+        mesh->noLighting())      return compact ? m_bilCompactShader : m_bilShader;
+    return compact ? m_stdCompactShader : m_stdShader;
+}
+
+Shader*
+Renderer::selectInstancedShader(const Mesh* mesh) bitwise_const
+{
+    // Meshes with their own constant buffers keep the per mesh path
+    if (mesh->isHUDElement()        ||
+        mesh->getSpecialVCBuffer()  ||
+        mesh->getSpecialPCBuffer()) return nullptr;
+
+    const bool compact = mesh->hasCompactVertices();
+
+    if (mesh->isBillboard() ||
+        mesh->noLighting())      return compact ? m_bilCompactInstancedShader : m_bilInstancedShader;
+    return compact ? m_stdCompactInstancedShader : m_stdInstancedShader;
+}
+
+uint32
+Renderer::selectMeshLod(const Mesh*   mesh,
+                        const mat4x4& projMatrix) logical_const
+{
+    if (mesh->isHUDElement() || mesh->getLodCount() < 2U) return 0U;
+
+    // Level of detail by the projected size of the mesh's largest
+    // dimension: proj._22 maps view space height at unit distance
+    // to half the viewport height
+    const vec3f  dimensions = mesh->calculateDimensions();
+    const real32 extent     = math::max3f(dimensions.x, dimensions.y, dimensions.z);
+    const vec3f  toCamera   = mesh->position - m_currentCam->getPosition();
+    const real32 distance   = D3DXVec3Length(&toCamera);
+    if (distance <= extent) return 0U;
+
+    const real32 projectedPixels = extent / distance * projMatrix._22 * g_window->getHeight() * 0.5f;
+    return mesh->selectLod(projectedPixels, m_lodPixelError);
+}
+
+void
+Renderer::buildDrawQueue(const std::vector<const Mesh*>& meshList)
+{
+    const vec3f& eyePosition = m_currentCam->getPosition();
+
+    m_drawDepths.clear();
+    real32 maxDepth = 0.0f;
+    for (auto citer = m_visibleIndices.cbegin();
+              citer != m_visibleIndices.cend();
+            ++citer)
+    {
+        const vec3f toMesh = meshList[*citer]->position - eyePosition;
+        m_drawDepths.push_back(D3DXVec3Length(&toMesh));
+        maxDepth = math::max2f(maxDepth, m_drawDepths.back());
+    }
+
+    // Sort IDs are numbered afresh for every queue, so an ID only
+    // ever stands for one object among the items being sorted
+    m_shaderSortIDs.clear();
+    m_textureSortIDs.clear();
+    m_meshSortIDs.clear();
+
+    m_drawItems.clear();
+    for (size_t i = 0;
+                i < m_visibleIndices.size();
+              ++i)
+    {
+        const Mesh*   mesh   = meshList[m_visibleIndices[i]];
+        const Shader* shader = selectShader(mesh);
+        if (!shader) continue;
+
+        const renderqueue::Pass pass = mesh->isBillboard() ? renderqueue::PASS_BILLBOARD :
+                                                             renderqueue::PASS_OPAQUE;
+
+        renderqueue::DrawItem item = {};
+        item.di_index = m_visibleIndices[i];
+        item.di_key   = renderqueue::makeKey(pass,
+                                             getSortID(m_shaderSortIDs, shader, renderqueue::KEY_SHADER_BITS),
+                                             getSortID(m_textureSortIDs,
+                                                       mesh->getTexture()->getTexturePointer().Get(),
+                                                       renderqueue::KEY_TEXTURE_BITS),
+                                             getSortID(m_meshSortIDs,
+                                                       mesh->getVertexBuffer().Get(),
+                                                       renderqueue::KEY_MESH_BITS),
+                                             renderqueue::quantizeDepth(m_drawDepths[i],
+                                                                        maxDepth,
+                                                                        pass == renderqueue::PASS_BILLBOARD));
+        m_drawItems.push_back(item);
+    }
+
+    renderqueue::sortItems(m_drawItems, m_drawItemsScratch);
+}
+
+void
+Renderer::renderDrawQueueInstanced(const std::vector<const Mesh*>& meshList)
+{
+    const mat4x4 projMatrix = m_currentCam->calculateProjectionMatrix();
+    const mat4x4 viewMatrix = m_currentCam->calculateViewMatrix();
+
+    m_instanceInputs.clear();
+    for (auto citer = m_drawItems.cbegin();
+              citer != m_drawItems.cend();
+            ++citer)
+    {
+        const Mesh* mesh   = meshList[citer->di_index];
+        Shader*     shader = selectInstancedShader(mesh);
+        if (!shader)
+        {
+            // Everything queued before this item draws first, so
+            // that the pass and depth order of the keys holds
+            flushInstanceInputs(meshList, viewMatrix, projMatrix);
+            submitMesh(mesh,
+                       0,
+                       mesh->getSpecialVCBuffer(),
+                       mesh->getSpecialPCBuffer());
+            continue;
+        }
+
+        // The dequantization of compact meshes is folded into
+        // each instance's world matrix
+        instancing::InstanceInput input = {};
+        input.ii_groupKey                  = instancing::makeGroupKey(citer->di_key, selectMeshLod(mesh, projMatrix));
+        input.ii_mesh                      = mesh->getVertexBuffer().Get();
+        input.ii_texture                   = mesh->getTexture()->getTexturePointer().Get();
+        input.ii_shader                    = shader;
+        input.ii_itemIndex                 = citer->di_index;
+        input.ii_data.id_worldMatrix       = mesh->hasCompactVertices() ?
+                                             mesh->getDequantizationMatrix() * mesh->getWorldMatrix() :
+                                             mesh->getWorldMatrix();
+        input.ii_data.id_highlight         = 0;
+        m_instanceInputs.push_back(input);
+    }
+
+    flushInstanceInputs(meshList, viewMatrix, projMatrix);
+}
+
+void
+Renderer::flushInstanceInputs(const std::vector<const Mesh*>& meshList,
+                              const mat4x4&                   viewMatrix,
+                              const mat4x4&                   projMatrix)
+{
+    instancing::buildGroups(m_instanceInputs, MAX_INSTANCES_PER_DRAW, m_instances, m_instanceGroups);
+    m_instanceInputs.clear();
+    if (m_instances.empty()) return;
+
+    const uint32 firstInstance = m_commandList.appendInstances(&m_instances[0],
+                                                               static_cast<uint32>(m_instances.size()),
+                                                               sizeof(instancing::InstanceData));
+
+    // Constant bindings persist across shader changes, so every
+    // group of the flush shares the same two blocks. Meshes drawn
+    // without instancing in between bind their own
+    bindInstancedConstants(viewMatrix, projMatrix);
+
+    for (auto citer = m_instanceGroups.cbegin();
+              citer != m_instanceGroups.cend();
+            ++citer)
+    {
+        const Mesh* mesh   = meshList[citer->ig_itemIndex];
+        Shader*     shader = selectInstancedShader(mesh);
+
+        bindDrawState(shader, mesh);
+
+        uint32 indexOffset = 0U, indexCount = 0U;
+        mesh->getLodIndices(selectMeshLod(mesh, projMatrix), indexOffset, indexCount);
+
+        ++m_frameStats.fs_drawCalls;
+        m_frameStats.fs_instancedMeshes     += citer->ig_nInstances;
+        m_frameStats.fs_triangles           += indexCount / 3 * citer->ig_nInstances;
+        m_frameStats.fs_fullDetailTriangles += mesh->getIndexCount() / 3 * citer->ig_nInstances;
+
+        m_commandList.drawIndexedInstanced(indexCount,
+                                           citer->ig_nInstances,
+                                           indexOffset,
+                                           firstInstance + citer->ig_firstInstance);
+    }
+}
+
+void
+Renderer::bindInstancedConstants(const mat4x4& viewMatrix,
+                                 const mat4x4& projMatrix)
+{
+    // The instanced shaders take the world matrix from the instance
+    // data, so their constants only carry the view projection
+    Shader::VSCBuffer vcbuffer = {};
+    vcbuffer.vcb_mvpMatrix         = viewMatrix * projMatrix;
+    D3DXMatrixIdentity(&vcbuffer.vcb_rotationMatrix);
+    D3DXMatrixIdentity(&vcbuffer.vcb_worldMatrix);
+    vcbuffer.vcb_eyePosition       = math::getVec4f(m_currentCam->getPosition());
+    vcbuffer.vcb_highlight         = 0;
+
+    m_commandList.setInstanceStream(sizeof(instancing::InstanceData));
+    ++m_frameStats.fs_stateChanges;
+
+    m_commandList.bindConstants(CommandList::STAGE_VERTEX, 0U, &vcbuffer, sizeof(Shader::VSCBuffer));
+    bindPixelConstants(m_currentLightBuffer);
+}
+
+void
+Renderer::renderText()
+{
+    textbatch::buildBatches(static_cast<uint32>(m_textVertices.size() / 4U),
+                            textbatch::MAX_BATCH_GLYPHS,
+                            m_textBatches);
+    if (m_textBatches.empty()) return;
+
+    // Glyph quads are already in normalized screen coordinates
+    Shader::VSCBuffer vcbuffer = {};
+    D3DXMatrixIdentity(&vcbuffer.vcb_mvpMatrix);
+    D3DXMatrixIdentity(&vcbuffer.vcb_rotationMatrix);
+    D3DXMatrixIdentity(&vcbuffer.vcb_worldMatrix);
+    vcbuffer.vcb_highlight = 0;
+
+    m_commandList.bindConstants(CommandList::STAGE_VERTEX, 0U, &vcbuffer, sizeof(Shader::VSCBuffer));
+    bindPixelConstants(m_currentLightBuffer);
+
+    for (size_t i = 0;
+                i < m_textBatches.size();
+              ++i)
+    {
+        const textbatch::TextBatch& batch = m_textBatches[i];
+        if (!uploadText(i, batch)) return;
+
+        bindDrawState(m_hudShader,
+                      m_textVertexBuffers[i].Get(),
+                      sizeof(textbatch::GlyphVertex),
+                      m_textIndexBuffer.Get(),
+                      sizeof(uint16),
+                      m_font->getTexture()->getTexturePointer().Get(),
+                      CommandList::DEPTH_DISABLED);
+
+        ++m_frameStats.fs_drawCalls;
+        m_frameStats.fs_triangles           += batch.tb_nGlyphs * 2U;
+        m_frameStats.fs_fullDetailTriangles += batch.tb_nGlyphs * 2U;
+
+        m_commandList.drawIndexed(batch.tb_nGlyphs * 6U, 0U);
+    }
+}
+
+bool
+Renderer::uploadText(const size_t                batchIndex,
+                     const textbatch::TextBatch& batch)
+{
+    // All buffers are sized for the largest batch up front, as
+    // the text of a frame is small either way
+    if (!m_textIndexBuffer)
+    {
+        std::vector<uint16> quadIndices;
+        textbatch::buildQuadIndices(textbatch::MAX_BATCH_GLYPHS, quadIndices);
+
+        D3D11_BUFFER_DESC indexBufferDesc = {};
+        indexBufferDesc.Usage             = D3D11_USAGE_IMMUTABLE;
+        indexBufferDesc.BindFlags         = D3D11_BIND_INDEX_BUFFER;
+        indexBufferDesc.ByteWidth         = static_cast<uint32>(quadIndices.size() * sizeof(uint16));
+
+        D3D11_SUBRESOURCE_DATA indexData = {};
+        indexData.pSysMem                = &quadIndices[0];
+
+        HR(m_d3dState->m_device->CreateBuffer(&indexBufferDesc, &indexData, &m_textIndexBuffer));
+        if (!m_textIndexBuffer) return false;
+    }
+
+    if (m_textVertexBuffers.size() <= batchIndex) m_textVertexBuffers.resize(batchIndex + 1U);
+
+    comptr<ID3D11Buffer>& vertexBuffer = m_textVertexBuffers[batchIndex];
+    if (!vertexBuffer)
+    {
+        D3D11_BUFFER_DESC vertexBufferDesc = {};
+        vertexBufferDesc.Usage             = D3D11_USAGE_DYNAMIC;
+        vertexBufferDesc.BindFlags         = D3D11_BIND_VERTEX_BUFFER;
+        vertexBufferDesc.CPUAccessFlags    = D3D11_CPU_ACCESS_WRITE;
+        vertexBufferDesc.ByteWidth         = textbatch::MAX_BATCH_GLYPHS * 4U * sizeof(textbatch::GlyphVertex);
+
+        HR(m_d3dState->m_device->CreateBuffer(&vertexBufferDesc, nullptr, &vertexBuffer));
+        if (!vertexBuffer) return false;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mappedVertices = {};
+    if (FAILED(m_d3dState->m_devcon->Map(vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedVertices))) return false;
+    memcpy(mappedVertices.pData,
+           &m_textVertices[batch.tb_firstGlyph * 4U],
+           batch.tb_nGlyphs * 4U * sizeof(textbatch::GlyphVertex));
+    m_d3dState->m_devcon->Unmap(vertexBuffer.Get(), 0);
+    return true;
+}
+
+void
+Renderer::bindDrawState(const Shader* shader, const Mesh* mesh)
+{
+    bindDrawState(shader,
+                  mesh->getVertexBuffer().Get(),
+                  mesh->getVertexStride(),
+                  mesh->getIndexBuffer().Get(),
+                  mesh->getIndexFormat() == DXGI_FORMAT_R16_UINT ? sizeof(uint16) : sizeof(uint32),
+                  mesh->getTexture()->getTexturePointer().Get(),
+                  mesh->isHUDElement() ? CommandList::DEPTH_DISABLED :
+                                         CommandList::DEPTH_ENABLED);
+}
+
+void
+Renderer::bindDrawState(const Shader*                 shader,
+                        ID3D11Buffer*                 vertexBuffer,
+                        const uint32                  vertexStride,
+                        ID3D11Buffer*                 indexBuffer,
+                        const uint32                  indexSize,
+                        ID3D11ShaderResourceView*     texture,
+                        const CommandList::DepthState depthState)
+{
+    if (m_boundState.bs_shader != shader)
+    {
+        m_commandList.setShader(shader);
+        m_boundState.bs_shader = shader;
+        ++m_frameStats.fs_stateChanges;
+    }
+
+    if (m_boundState.bs_vertexBuffer != vertexBuffer ||
+        m_boundState.bs_vertexStride != vertexStride)
+    {
+        m_commandList.setVertexBuffer(vertexBuffer, 0U, vertexStride);
+        m_boundState.bs_vertexBuffer = vertexBuffer;
+        m_boundState.bs_vertexStride = vertexStride;
+        ++m_frameStats.fs_stateChanges;
+    }
+
+    if (m_boundState.bs_indexBuffer != indexBuffer ||
+        m_boundState.bs_indexSize   != indexSize)
+    {
+        m_commandList.setIndexBuffer(indexBuffer, indexSize);
+        m_boundState.bs_indexBuffer = indexBuffer;
+        m_boundState.bs_indexSize   = indexSize;
+        ++m_frameStats.fs_stateChanges;
+    }
+
+    if (m_boundState.bs_texture != texture)
+    {
+        m_commandList.setTexture(texture);
+        m_boundState.bs_texture = texture;
+        ++m_frameStats.fs_stateChanges;
+    }
+
+    setDepthState(depthState);
+}
+
+void
+Renderer::setDepthState(const CommandList::DepthState depthState)
+{
+    if (m_boundState.bs_depthStateSet &&
+        m_boundState.bs_depthState == depthState) return;
+
+    m_commandList.setDepthState(depthState);
+    m_boundState.bs_depthState    = depthState;
+    m_boundState.bs_depthStateSet = true;
+    ++m_frameStats.fs_stateChanges;
+}
+
+void
+Renderer::bindClusteredLights(const mat4x4& viewMatrix,
+                              const mat4x4& projMatrix)
+{
+    // The perspective projection's depth terms give back the
+    // camera's clip planes
+    const real32 zNear = -projMatrix._43 / projMatrix._33;
+    const real32 zFar  =  projMatrix._43 / (1.0f - projMatrix._33);
+
+    const lightcluster::ClusterParams params = lightcluster::makeParams(static_cast<real32>(g_window->getWidth()),
+                                                                        static_cast<real32>(g_window->getHeight()),
+                                                                        zNear,
+                                                                        zFar);
+
+    lightcluster::assignLights(params, viewMatrix, projMatrix, m_clusterLights, m_clusterGrid);
+
+#ifdef LIGHT_CLUSTER_BENCHMARK
+    static uint32 benchFrameCounter = 0U;
+    if (++benchFrameCounter == CULLING_BENCHMARK_INTERVAL)
+    {
+        benchFrameCounter = 0U;
+        lightcluster::BenchmarkResult bench = lightcluster::benchmark(params,
+                                                                      viewMatrix,
+                                                                      projMatrix,
+                                                                      m_clusterLights,
+                                                                      CULLING_BENCHMARK_ITERATIONS);
+        logstring("Clustered lights: ");
+        logline(bench.br_nLights);
+        logstring("Cluster assignments: ");
+        logline(bench.br_nAssignments);
+        logstring("Dropped assignments: ");
+        logline(bench.br_nDroppedAssignments);
+        logstring("Light assignment (us): ");
+        logline(bench.br_assignMicros);
+    }
+#endif
+
+    // Written at record time: the buffers are only read by this
+    // frame's draws, all of which see the same assignment
+    const lightcluster::ClusterLight* lights  = m_clusterLights.empty() ? nullptr : &m_clusterLights[0];
+    const uint32*                     indices = m_clusterGrid.cg_lightIndices.empty() ? nullptr : &m_clusterGrid.cg_lightIndices[0];
+
+    if (!uploadStructured(lights,
+                          static_cast<uint32>(m_clusterLights.size()),
+                          sizeof(lightcluster::ClusterLight),
+                          m_clusterLightBuffer) ||
+        !uploadStructured(&m_clusterGrid.cg_clusterRanges[0],
+                          lightcluster::CLUSTER_COUNT,
+                          2U * sizeof(uint32),
+                          m_clusterRangeBuffer) ||
+        !uploadStructured(indices,
+                          m_clusterGrid.cg_nAssignments,
+                          sizeof(uint32),
+                          m_clusterIndexBuffer)) return;
+
+    m_commandList.setShaderResource(m_clusterLightBuffer.sb_view.Get(), CLUSTER_LIGHTS_SLOT);
+    m_commandList.setShaderResource(m_clusterRangeBuffer.sb_view.Get(), CLUSTER_RANGES_SLOT);
+    m_commandList.setShaderResource(m_clusterIndexBuffer.sb_view.Get(), CLUSTER_INDICES_SLOT);
+    m_commandList.bindConstants(CommandList::STAGE_PIXEL, CLUSTER_PARAMS_SLOT, &params, sizeof(params));
+    m_frameStats.fs_stateChanges += 3U;
+}
+
+bool
+Renderer::uploadStructured(const void*       data,
+                           const uint32      nElements,
+                           const uint32      stride,
+                           StructuredBuffer& buffer)
+{
+    if (!buffer.sb_buffer || nElements > buffer.sb_capacity)
+    {
+        // Grow geometrically so that the buffer is only
+        // recreated a handful of times
+        const uint32 newCapacity = std::max<uint32>(std::max<uint32>(buffer.sb_capacity * 2U, MIN_STRUCTURED_CAPACITY),
+                                                    nElements);
+
+        D3D11_BUFFER_DESC structuredBufferDesc   = {};
+        structuredBufferDesc.Usage               = D3D11_USAGE_DYNAMIC;
+        structuredBufferDesc.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
+        structuredBufferDesc.CPUAccessFlags      = D3D11_CPU_ACCESS_WRITE;
+        structuredBufferDesc.MiscFlags           = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+        structuredBufferDesc.StructureByteStride = stride;
+        structuredBufferDesc.ByteWidth           = newCapacity * stride;
+
+        D3D11_SHADER_RESOURCE_VIEW_DESC structuredViewDesc = {};
+        structuredViewDesc.Format                          = DXGI_FORMAT_UNKNOWN;
+        structuredViewDesc.ViewDimension                   = D3D11_SRV_DIMENSION_BUFFER;
+        structuredViewDesc.Buffer.FirstElement             = 0;
+        structuredViewDesc.Buffer.NumElements              = newCapacity;
+
+        buffer.sb_view.Reset();
+        buffer.sb_buffer.Reset();
+        buffer.sb_capacity = 0U;
+        HR(m_d3dState->m_device->CreateBuffer(&structuredBufferDesc, nullptr, &buffer.sb_buffer));
+        if (!buffer.sb_buffer) return false;
+        HR(m_d3dState->m_device->CreateShaderResourceView(buffer.sb_buffer.Get(), &structuredViewDesc, &buffer.sb_view));
+        if (!buffer.sb_view) return false;
+        buffer.sb_capacity = newCapacity;
+    }
+
+    if (!nElements) return true;
+
+    D3D11_MAPPED_SUBRESOURCE mappedElements = {};
+    if (FAILED(m_d3dState->m_devcon->Map(buffer.sb_buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedElements))) return false;
+    memcpy(mappedElements.pData, data, nElements * stride);
+    m_d3dState->m_devcon->Unmap(buffer.sb_buffer.Get(), 0);
+    return true;
+}
+
+void
+Renderer::bindPixelConstants(const Shader::PSCBuffer* pixelBuffer)
+{
+    // Meshes with their own pixel constants may change them between
+    // draws, so only the light buffer is treated as already bound
+    const bool lights = pixelBuffer == m_currentLightBuffer;
+    if (lights && m_boundState.bs_lightsBound) return;
+
+    m_commandList.bindConstants(CommandList::STAGE_PIXEL, 0U, pixelBuffer, sizeof(Shader::PSCBuffer));
+    m_boundState.bs_lightsBound = lights;
 }
 
 bool
@@ -389,9 +1149,35 @@ Renderer::testVisible(const Mesh* mesh)
 {
     math::Frustum camFrustum;
     m_currentCam->calculateFrustum(&camFrustum);
-    
+    const math::Sphere meshSphere = mesh->getVisibleGeometry();
+
     return !physics::intersectionTest(physics::PHYSICS_INTERSECTION_TYPE_FRUSTUMSPHERE,
                                       &camFrustum,
-                                      &mesh->getVisibleGeometry());
+                                      &meshSphere);
 }
 
+/* ------------------
+   Internal Functions
+   ------------------ */
+static uint32
+getSortID(std::unordered_map<const void*, uint32>& sortIDs,
+          const void*                              object,
+          const uint32                             bits)
+{
+    auto citer = sortIDs.find(object);
+    if (citer != sortIDs.cend()) return citer->second;
+
+    // More distinct objects in one queue than the key field can
+    // number. The excess share the last ID, which only costs sort
+    // quality since instancing compares the objects themselves
+    if (sortIDs.size() >= (1U << bits))
+    {
+        assert(false && "Sort key field exhausted");
+        logline("Sort key field exhausted, sharing the last ID");
+        return (1U << bits) - 1U;
+    }
+
+    const uint32 sortID = static_cast<uint32>(sortIDs.size());
+    sortIDs[object] = sortID;
+    return sortID;
+}
@@ -14,10 +14,17 @@
 
 #include "d3d11state.h"
 #include "shader.h"
+#include "commandlist.h"
+#include "culling.h"
+#include "instancing.h"
+#include "lightcluster.h"
+#include "renderqueue.h"
+#include "textbatch.h"
 #include "../dotmdef.h"
 #include "../util/strings.h"
 #include "../util/math.h"
 #include <map>
+#include <unordered_map>
 
 class  D3D11State;
 class  Mesh;
@@ -38,6 +45,45 @@ public:
         YELLOW, CYAN, RED
     };
 
+    // fs_fullDetailTriangles is what fs_triangles would have been
+    // had every mesh been drawn at its full level of detail, and
+    // fs_constantBytes is the constant data uploaded for the frame
+    struct FrameStats
+    {
+        uint32 fs_drawCalls;
+        uint32 fs_instancedMeshes;
+        uint32 fs_stateChanges;
+        uint32 fs_triangles;
+        uint32 fs_fullDetailTriangles;
+        uint32 fs_constantBytes;
+    };
+
+private:
+
+    // The pipeline state last recorded through bindDrawState, so
+    // that only the state that differs between draws is set again
+    struct BoundState
+    {
+        const Shader*             bs_shader;
+        ID3D11Buffer*             bs_vertexBuffer;
+        uint32                    bs_vertexStride;
+        ID3D11Buffer*             bs_indexBuffer;
+        uint32                    bs_indexSize;
+        ID3D11ShaderResourceView* bs_texture;
+        CommandList::DepthState   bs_depthState;
+        bool                      bs_depthStateSet;
+        bool                      bs_lightsBound;
+    };
+
+    // A dynamic structured buffer read by the clustered shaders,
+    // rewritten once per frame
+    struct StructuredBuffer
+    {
+        comptr<ID3D11Buffer>             sb_buffer;
+        comptr<ID3D11ShaderResourceView> sb_view;
+        uint32                           sb_capacity;
+    };
+
 public:
 
     static Renderer*
@@ -60,6 +106,8 @@ public:
                     const DebugColor      debugColor,
                     const bool            wireframe);
 
+    // Text is batched: the string's glyph quads are queued
+    // and all the frame's text is drawn at once by endFrame
     void
     renderString(const cstring str,
                  const real32  x,
@@ -71,6 +119,18 @@ public:
                Shader::VSCBuffer* externVertexBuffer = nullptr,
                Shader::PSCBuffer* externPixelBuffer = nullptr);
 
+    // <summary>
+    // <para>
+    // Draws the mesh once per instance, each with its own world
+    // matrix and highlight option, in as few instanced draw calls
+    // as possible. Without instanced shaders every instance falls
+    // back to a regular draw. Instances are not culled.
+    // </para>
+    // </summary>
+    void
+    renderMeshInstances(const Mesh*                                  mesh,
+                        const std::vector<instancing::InstanceData>& instances);
+
     void
     setCamera(const Camera* camera);
 
@@ -80,6 +140,22 @@ public:
     comptr<ID3D11DeviceContext>
     getDevconHandle() bitwise_const;
 
+    // Statistics of the last completed frame
+    const FrameStats&
+    getFrameStats() logical_const;
+
+    // <summary>
+    // <para>
+    // The commands recorded so far this frame. Everything drawn
+    // between beginFrame and endFrame is recorded here first and
+    // only replayed against the device context by endFrame, so
+    // the recorded resources must stay alive until then (all the
+    // cached mesh and texture data does).
+    // </para>
+    // </summary>
+    const CommandList&
+    getFrameCommands() logical_const;
+
 private:
 
     Renderer();
@@ -92,16 +168,140 @@ private:
     bool
     testVisible(const Mesh* mesh);
 
+    void
+    submitMesh(const Mesh*        mesh,
+               const int          highlightOption,
+               Shader::VSCBuffer* externVertexBuffer,
+               Shader::PSCBuffer* externPixelBuffer);
+
+    Shader*
+    selectShader(const Mesh* mesh) bitwise_const;
+
+    // Returns nullptr if the mesh cannot be drawn instanced
+    Shader*
+    selectInstancedShader(const Mesh* mesh) bitwise_const;
+
+    uint32
+    selectMeshLod(const Mesh*   mesh,
+                  const mat4x4& projMatrix) logical_const;
+
+    // Queues the visible meshes of the scene by their sort keys
+    void
+    buildDrawQueue(const std::vector<const Mesh*>& meshList);
+
+    // Draws the queued meshes grouped into instanced draw calls,
+    // in the order of their sort keys
+    void
+    renderDrawQueueInstanced(const std::vector<const Mesh*>& meshList);
+
+    // Groups and draws the instance inputs gathered so far, then
+    // clears them
+    void
+    flushInstanceInputs(const std::vector<const Mesh*>& meshList,
+                        const mat4x4&                   viewMatrix,
+                        const mat4x4&                   projMatrix);
+
+    // The constants of the instanced shaders, which take the
+    // world matrix from the instance data
+    void
+    bindInstancedConstants(const mat4x4& viewMatrix,
+                           const mat4x4& projMatrix);
+
+    // Draws the queued glyph quads, with one draw call per
+    // batch of at most textbatch::MAX_BATCH_GLYPHS glyphs
+    void
+    renderText();
+
+    // Writes the batch's glyph quads into the batch's dynamic text
+    // vertex buffer. Each batch has a buffer of its own, as the
+    // draws are only replayed once all of them are written. The
+    // buffers and the quad index buffer are created on first use
+    bool
+    uploadText(const size_t               batchIndex,
+               const textbatch::TextBatch& batch);
+
+    void
+    bindDrawState(const Shader* shader, const Mesh* mesh);
+
+    void
+    bindDrawState(const Shader*                 shader,
+                  ID3D11Buffer*                 vertexBuffer,
+                  const uint32                  vertexStride,
+                  ID3D11Buffer*                 indexBuffer,
+                  const uint32                  indexSize,
+                  ID3D11ShaderResourceView*     texture,
+                  const CommandList::DepthState depthState);
+
+    void
+    setDepthState(const CommandList::DepthState depthState);
+
+    // Assigns the gathered point lights to the view's clusters,
+    // uploads the result and binds it for the clustered shaders
+    void
+    bindClusteredLights(const mat4x4& viewMatrix,
+                        const mat4x4& projMatrix);
+
+    // Grows the buffer (and recreates its view) as needed
+    bool
+    uploadStructured(const void*       data,
+                     const uint32      nElements,
+                     const uint32      stride,
+                     StructuredBuffer& buffer);
+
+    // The frame's lights stay bound across draws and are only
+    // bound again after a mesh with its own pixel constants
+    void
+    bindPixelConstants(const Shader::PSCBuffer* pixelBuffer);
+
 private:
 
-    D3D11State*   m_d3dState;
-    Shader*       m_stdShader;
-    Shader*       m_hudShader;
-    Shader*       m_bilShader;
-    const Camera* m_currentCam;    
-    Font*         m_font;
+    D3D11State*      m_d3dState;
+    CommandExecutor* m_executor;
+    Shader*          m_stdShader;
+    Shader*          m_hudShader;
+    Shader*          m_bilShader;
+    Shader*          m_stdCompactShader;
+    Shader*          m_bilCompactShader;
+    Shader*          m_stdInstancedShader;
+    Shader*          m_bilInstancedShader;
+    Shader*          m_stdCompactInstancedShader;
+    Shader*          m_bilCompactInstancedShader;
+    const Camera*    m_currentCam;
+    Font*            m_font;
     
     std::map<Primitive, Mesh*> m_primitiveModels;
     Shader::PSCBuffer*         m_currentLightBuffer;
+    culling::SphereSet         m_cullSpheres;
+    std::vector<uint32>        m_visibleIndices;
+    culling::SphereSet         m_lightSpheres;
+    std::vector<uint32>        m_visibleLights;
+    real32                     m_lodPixelError;
+    FrameStats                 m_frameStats;
+    FrameStats                 m_lastFrameStats;
+
+    std::vector<real32>                     m_drawDepths;
+    std::vector<renderqueue::DrawItem>      m_drawItems;
+    std::vector<renderqueue::DrawItem>      m_drawItemsScratch;
+    std::unordered_map<const void*, uint32> m_shaderSortIDs;
+    std::unordered_map<const void*, uint32> m_textureSortIDs;
+    std::unordered_map<const void*, uint32> m_meshSortIDs;
+    BoundState                              m_boundState;
+    CommandList                             m_commandList;
+
+    std::vector<instancing::InstanceInput>  m_instanceInputs;
+    std::vector<instancing::InstanceData>   m_instances;
+    std::vector<instancing::InstanceGroup>  m_instanceGroups;
+
+    std::vector<textbatch::GlyphVertex>     m_textVertices;
+    std::vector<textbatch::TextBatch>       m_textBatches;
+    std::vector<comptr<ID3D11Buffer>>       m_textVertexBuffers;
+    comptr<ID3D11Buffer>                    m_textIndexBuffer;
+
+    bool                                    m_clusteredLighting;
+    std::vector<lightcluster::ClusterLight> m_clusterLights;
+    lightcluster::ClusterGrid               m_clusterGrid;
+    StructuredBuffer                        m_clusterLightBuffer;
+    StructuredBuffer                        m_clusterRangeBuffer;
+    StructuredBuffer                        m_clusterIndexBuffer;
 
 };
\ No newline at end of file
@@ -0,0 +1,133 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        renderqueue.cpp
+
+   File description: Implementation of the sort key
+   functions declared in renderqueue.h
+   ------------------------------------------------ */
+
+#include "renderqueue.h"
+#include <cstring>
+
+/* ---------
+   Constants
+   --------- */
+#define RQ_RADIX_BITS    8
+#define RQ_RADIX_BUCKETS (1 << RQ_RADIX_BITS)
+#define RQ_KEY_BYTES     8
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static inline ullong64
+maskField(const uint32 value, const uint32 bits);
+
+/* ----------------
+   Public Functions
+   ---------------- */
+ullong64
+renderqueue::makeKey(const Pass   pass,
+                     const uint32 shaderID,
+                     const uint32 textureID,
+                     const uint32 meshID,
+                     const uint32 depth)
+{
+    ullong64 key = maskField(pass, KEY_PASS_BITS);
+    key = (key << KEY_SHADER_BITS)  | maskField(shaderID,  KEY_SHADER_BITS);
+    key = (key << KEY_TEXTURE_BITS) | maskField(textureID, KEY_TEXTURE_BITS);
+    key = (key << KEY_MESH_BITS)    | maskField(meshID,    KEY_MESH_BITS);
+    key = (key << KEY_DEPTH_BITS)   | maskField(depth,     KEY_DEPTH_BITS);
+    return key;
+}
+
+uint32
+renderqueue::quantizeDepth(const real32 depth,
+                           const real32 maxDepth,
+                           const bool   backToFront)
+{
+    const uint32 maxValue = (1U << KEY_DEPTH_BITS) - 1U;
+
+    real32 normalized = maxDepth > 0.0f ? depth / maxDepth : 0.0f;
+    if (normalized < 0.0f) normalized = 0.0f;
+    if (normalized > 1.0f) normalized = 1.0f;
+
+    const uint32 quantized = static_cast<uint32>(normalized * maxValue);
+    return backToFront ? maxValue - quantized : quantized;
+}
+
+void
+renderqueue::sortItems(std::vector<DrawItem>& items,
+                       std::vector<DrawItem>& scratch)
+{
+    const size_t nItems = items.size();
+    if (nItems < 2) return;
+
+    scratch.resize(nItems);
+
+    // All the histograms are gathered in a single read pass
+    uint32 histograms[RQ_KEY_BYTES][RQ_RADIX_BUCKETS];
+    memset(histograms, 0, sizeof(histograms));
+
+    for (size_t i = 0;
+                i < nItems;
+              ++i)
+    {
+        const ullong64 key = items[i].di_key;
+        for (size_t digit = 0;
+                    digit < RQ_KEY_BYTES;
+                  ++digit)
+        {
+            ++histograms[digit][(key >> (digit * RQ_RADIX_BITS)) & (RQ_RADIX_BUCKETS - 1)];
+        }
+    }
+
+    DrawItem* source      = &items[0];
+    DrawItem* destination = &scratch[0];
+
+    for (size_t digit = 0;
+                digit < RQ_KEY_BYTES;
+              ++digit)
+    {
+        uint32* histogram = histograms[digit];
+
+        // Every key has the same digit here, the pass would
+        // leave the order untouched
+        const uint32 firstDigit = (source[0].di_key >> (digit * RQ_RADIX_BITS)) & (RQ_RADIX_BUCKETS - 1);
+        if (histogram[firstDigit] == nItems) continue;
+
+        uint32 offset = 0U;
+        for (size_t bucket = 0;
+                    bucket < RQ_RADIX_BUCKETS;
+                  ++bucket)
+        {
+            const uint32 count = histogram[bucket];
+            histogram[bucket]  = offset;
+            offset            += count;
+        }
+
+        for (size_t i = 0;
+                    i < nItems;
+                  ++i)
+        {
+            const uint32 bucket = (source[i].di_key >> (digit * RQ_RADIX_BITS)) & (RQ_RADIX_BUCKETS - 1);
+            destination[histogram[bucket]++] = source[i];
+        }
+
+        DrawItem* swapTemp = source;
+        source             = destination;
+        destination        = swapTemp;
+    }
+
+    // An odd number of scatter passes leaves the result in scratch
+    if (source != &items[0]) items.swap(scratch);
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static inline ullong64
+maskField(const uint32 value, const uint32 bits)
+{
+    return static_cast<ullong64>(value) & ((1ULL << bits) - 1ULL);
+}
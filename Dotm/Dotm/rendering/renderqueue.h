@@ -0,0 +1,70 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        renderqueue.h
+
+   File description: Draw call sort keys. Every
+   queued draw is packed into a 64 bit key ordered
+   by pass, shader, texture, mesh and depth, so that
+   a single radix sort groups the draws sharing GPU
+   state while keeping each group front to back.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include <vector>
+
+namespace renderqueue
+{
+    // Passes are submitted in this order. Billboards are sorted
+    // back to front, everything else front to back
+    enum Pass
+    {
+        PASS_OPAQUE    = 0,
+        PASS_BILLBOARD = 1
+    };
+
+    // Key layout, most significant bits first:
+    // pass (4) | shader (8) | texture (14) | mesh (14) | depth (24)
+    static const uint32 KEY_PASS_BITS    = 4U;
+    static const uint32 KEY_SHADER_BITS  = 8U;
+    static const uint32 KEY_TEXTURE_BITS = 14U;
+    static const uint32 KEY_MESH_BITS    = 14U;
+    static const uint32 KEY_DEPTH_BITS   = 24U;
+
+    struct DrawItem
+    {
+        ullong64 di_key;
+        uint32   di_index;
+    };
+
+    // IDs wider than their fields are truncated, which only
+    // costs some state grouping, never correctness
+    ullong64
+    makeKey(const Pass   pass,
+            const uint32 shaderID,
+            const uint32 textureID,
+            const uint32 meshID,
+            const uint32 depth);
+
+    // Maps depth in [0, maxDepth] to the key's depth field,
+    // reversed for back to front ordering
+    uint32
+    quantizeDepth(const real32 depth,
+                  const real32 maxDepth,
+                  const bool   backToFront);
+
+    // <summary>
+    // <para>
+    // Stable LSD radix sort of the items by key, eight bits per
+    // pass. Passes where every key shares the same digit are
+    // skipped, so keys with unused high fields sort in fewer
+    // passes. scratch is resized as needed and can be reused
+    // across frames to avoid reallocation.
+    // </para>
+    // </summary>
+    void
+    sortItems(std::vector<DrawItem>& items,
+              std::vector<DrawItem>& scratch);
+}
@@ -8,21 +8,35 @@
    ------------------------------------------------ */
 
 #include "shader.h"
+#include "instancing.h"
 #include "renderer.h"
+#include "../util/assetpack.h"
 #include "../util/stringutils.h"
+#include <cstddef>
 #include <string>
+#include <vector>
 #include <d3dcompiler.h>
 
 #pragma comment(lib, "d3dcompiler.lib")
 
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static HRESULT
+compileShader(const std::string&  path,
+              cstring             target,
+              comptr<ID3D10Blob>& outBuffer,
+              comptr<ID3D10Blob>& outErrorMessage);
+
 /* --------------
    Public Methods
    -------------- */
-Shader::Shader(cstring shaderName)
+Shader::Shader(cstring    shaderName,
+               const bool compactVertices /* false */,
+               const bool instanced /* false */)
 {
                createVertexPixelShaders(shaderName);
-               createConstantBuffers();
-               createShaderLayout();
+               createShaderLayout(compactVertices, instanced);
 }
 
 Shader::~Shader()
@@ -48,18 +62,6 @@ Shader::getPixelShader() bitwise_const
     return m_pixelShader;
 }
 
-comptr<ID3D11Buffer>
-Shader::getVSCBuffer() bitwise_const
-{
-    return m_vertexShaderCBuffer;
-}
-
-comptr<ID3D11Buffer>
-Shader::getPSCBuffer() bitwise_const
-{
-    return m_pixelShaderCBuffer;
-}
-
 /* ---------------
    Private Methods
    --------------- */
@@ -74,15 +76,7 @@ Shader::createVertexPixelShaders(cstring shaderName)
 
     // Shader Compilation
     HRESULT result; 
-    result = D3DCompileFromFile(string_utils::getwstring(vertexPath).c_str(),
-                                nullptr,
-                                D3D_COMPILE_STANDARD_FILE_INCLUDE,
-                                "main",
-                                "vs_5_0",
-                                D3D10_SHADER_ENABLE_STRICTNESS,                                
-                                NULL,
-                                &m_vsbuffer,
-                                &errorMessage);
+    result = compileShader(vertexPath, "vs_5_0", m_vsbuffer, errorMessage);
     if (FAILED(result))
     {
         // If file was found then there should be a compilation
@@ -113,15 +107,7 @@ Shader::createVertexPixelShaders(cstring shaderName)
     pixelPath = "assets/shaders/p_" + pixelPath + ".hlsl";
     
     // Shader Compilation
-    result = D3DCompileFromFile(string_utils::getwstring(pixelPath).c_str(),
-                                nullptr,
-                                D3D_COMPILE_STANDARD_FILE_INCLUDE,
-                                "main",
-                                "ps_5_0",
-                                D3D10_SHADER_ENABLE_STRICTNESS,
-                                NULL,
-                                &m_psbuffer,
-                                &errorMessage);
+    result = compileShader(pixelPath, "ps_5_0", m_psbuffer, errorMessage);
     if (FAILED(result))
     {
         // If file was found then there should be a compilation
@@ -149,33 +135,8 @@ Shader::createVertexPixelShaders(cstring shaderName)
 }
 
 void
-Shader::createConstantBuffers()
-{
-    // Vertex Shader Constant Buffer description
-    D3D11_BUFFER_DESC vsCBufferDesc = {};
-    vsCBufferDesc.Usage             = D3D11_USAGE_DEFAULT;
-    vsCBufferDesc.BindFlags         = D3D11_BIND_CONSTANT_BUFFER;
-    vsCBufferDesc.ByteWidth         = sizeof(VSCBuffer);
-    
-    // Vertex Shader Constant Buffer creation
-    HR(Renderer::get()->getDeviceHandle()->CreateBuffer(&vsCBufferDesc,
-                                                        nullptr,
-                                                        &m_vertexShaderCBuffer));
-
-    // Pixel Shader Constant Buffer description
-    D3D11_BUFFER_DESC psCBufferDesc = {};
-    psCBufferDesc.Usage             = D3D11_USAGE_DEFAULT;
-    psCBufferDesc.BindFlags         = D3D11_BIND_CONSTANT_BUFFER;
-    psCBufferDesc.ByteWidth         = sizeof(PSCBuffer);
-
-    // Pixel Shader Constant Buffer creation
-    HR(Renderer::get()->getDeviceHandle()->CreateBuffer(&psCBufferDesc, 
-                                                        nullptr,
-                                                        &m_pixelShaderCBuffer));    
-}
-
-void
-Shader::createShaderLayout()
+Shader::createShaderLayout(const bool compactVertices,
+                           const bool instanced)
 {
     // Position Input Layout description
     D3D11_INPUT_ELEMENT_DESC inputPositionDesc = {};    
@@ -198,17 +159,95 @@ Shader::createShaderLayout()
     inputNormalDesc.InputSlotClass             = D3D11_INPUT_PER_VERTEX_DATA;
     inputNormalDesc.AlignedByteOffset          = D3D11_APPEND_ALIGNED_ELEMENT;
 
+    // Compact vertices: bounds relative positions, half float
+    // texcoords and octahedral normals (see vertexquant.h)
+    if (compactVertices)
+    {
+        inputPositionDesc.Format = DXGI_FORMAT_R16G16B16A16_UNORM;
+        inputTexcoordDesc.Format = DXGI_FORMAT_R16G16_FLOAT;
+        inputNormalDesc.Format   = DXGI_FORMAT_R16G16_SNORM;
+    }
+
     // Combined Input Layout Array
-    D3D11_INPUT_ELEMENT_DESC combinedLayout[]  = {inputPositionDesc,
-                                                  inputTexcoordDesc,
-                                                  inputNormalDesc};
+    std::vector<D3D11_INPUT_ELEMENT_DESC> combinedLayout;
+    combinedLayout.push_back(inputPositionDesc);
+    combinedLayout.push_back(inputTexcoordDesc);
+    combinedLayout.push_back(inputNormalDesc);
+
+    // Instanced variants: the world matrix rows followed by the
+    // highlight option, from the per instance buffer in slot 1
+    if (instanced)
+    {
+        for (uint32 row = 0;
+                    row < 4;
+                  ++row)
+        {
+            D3D11_INPUT_ELEMENT_DESC inputWorldDesc = {};
+            inputWorldDesc.Format                   = DXGI_FORMAT_R32G32B32A32_FLOAT;
+            inputWorldDesc.SemanticName             = "WORLD";
+            inputWorldDesc.SemanticIndex            = row;
+            inputWorldDesc.InputSlot                = 1U;
+            inputWorldDesc.InputSlotClass           = D3D11_INPUT_PER_INSTANCE_DATA;
+            inputWorldDesc.InstanceDataStepRate     = 1U;
+            inputWorldDesc.AlignedByteOffset        = row * sizeof(vec4f);
+            combinedLayout.push_back(inputWorldDesc);
+        }
+
+        D3D11_INPUT_ELEMENT_DESC inputHighlightDesc = {};
+        inputHighlightDesc.Format                   = DXGI_FORMAT_R32_SINT;
+        inputHighlightDesc.SemanticName             = "HIGHLIGHT";
+        inputHighlightDesc.InputSlot                = 1U;
+        inputHighlightDesc.InputSlotClass           = D3D11_INPUT_PER_INSTANCE_DATA;
+        inputHighlightDesc.InstanceDataStepRate     = 1U;
+        inputHighlightDesc.AlignedByteOffset        = offsetof(instancing::InstanceData, id_highlight);
+        combinedLayout.push_back(inputHighlightDesc);
+    }
+
     // Create Shader Input Layout
-    HR(Renderer::get()->getDeviceHandle()->CreateInputLayout(combinedLayout,
-                                                             ARRAYSIZE(combinedLayout),
+    HR(Renderer::get()->getDeviceHandle()->CreateInputLayout(&combinedLayout[0],
+                                                             combinedLayout.size(),
                                                              m_vsbuffer->GetBufferPointer(),
                                                              m_vsbuffer->GetBufferSize(),
                                                              &m_shaderInputLayout));
     
     // Set the global input layout
     Renderer::get()->getDevconHandle()->IASetInputLayout(m_shaderInputLayout.Get());
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static HRESULT
+compileShader(const std::string&  path,
+              cstring             target,
+              comptr<ID3D10Blob>& outBuffer,
+              comptr<ID3D10Blob>& outErrorMessage)
+{
+    // Packed shaders are compiled from the pack's memory. Their
+    // #includes still resolve against the loose shader directory
+    AssetData asset = {};
+    if (AssetPack::get()->read(path, asset))
+    {
+        return D3DCompile(asset.ad_data,
+                          asset.ad_size,
+                          path.c_str(),
+                          nullptr,
+                          D3D_COMPILE_STANDARD_FILE_INCLUDE,
+                          "main",
+                          target,
+                          D3D10_SHADER_ENABLE_STRICTNESS,
+                          NULL,
+                          &outBuffer,
+                          &outErrorMessage);
+    }
+
+    return D3DCompileFromFile(string_utils::getwstring(path).c_str(),
+                              nullptr,
+                              D3D_COMPILE_STANDARD_FILE_INCLUDE,
+                              "main",
+                              target,
+                              D3D10_SHADER_ENABLE_STRICTNESS,
+                              NULL,
+                              &outBuffer,
+                              &outErrorMessage);
 }
\ No newline at end of file
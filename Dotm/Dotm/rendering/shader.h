@@ -4,7 +4,10 @@
    File name:        shader.h
 
    File description: An class encapsulating the base
-   functionality of a shader.
+   functionality of a shader. The constant buffer
+   structs below are not owned per shader: the
+   renderer binds them from the frame's constant
+   ring (see commandlist.h).
    ------------------------------------------------- */
 
 #pragma once
@@ -74,7 +77,13 @@ public:
 
 public:
 
-    Shader(cstring shaderName);
+    // If compactVertices is set the shader's input layout expects
+    // vertexquant::CompactVertex vertices instead of Mesh::Vertex.
+    // If instanced is set it also expects instancing::InstanceData
+    // in the second input slot, stepping once per instance
+    Shader(cstring    shaderName,
+           const bool compactVertices = false,
+           const bool instanced       = false);
 
     ~Shader();
 
@@ -92,22 +101,14 @@ public:
     comptr<ID3D11PixelShader>
     getPixelShader() bitwise_const;
 
-    comptr<ID3D11Buffer>
-    getVSCBuffer() bitwise_const;
-
-    comptr<ID3D11Buffer>
-    getPSCBuffer() bitwise_const;
-
 private:
 
     void
     createVertexPixelShaders(cstring shaderName);
 
-    void 
-    createConstantBuffers();
-
     void
-    createShaderLayout();
+    createShaderLayout(const bool compactVertices,
+                       const bool instanced);
 
 protected:
 
@@ -116,7 +117,5 @@ protected:
     comptr<ID3D11VertexShader> m_vertexShader;
     comptr<ID3D11PixelShader>  m_pixelShader;
     comptr<ID3D11InputLayout>  m_shaderInputLayout;
-    comptr<ID3D11Buffer>       m_vertexShaderCBuffer;
-    comptr<ID3D11Buffer>       m_pixelShaderCBuffer;
 
 };
\ No newline at end of file
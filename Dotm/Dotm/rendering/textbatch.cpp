@@ -0,0 +1,107 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        textbatch.cpp
+
+   File description: Implementation of the glyph
+   quad functions declared in textbatch.h
+   ------------------------------------------------ */
+
+#include "textbatch.h"
+#include <algorithm>
+
+/* ---------
+   Constants
+   --------- */
+#define TEXT_ADVANCE_DIVISOR 1.5f
+
+/* ----------------
+   Public Functions
+   ---------------- */
+uint32
+textbatch::appendString(const GlyphTable&         glyphTable,
+                        cstring                   str,
+                        const real32              x,
+                        const real32              y,
+                        const real32              size,
+                        const real32              aspect,
+                        std::vector<GlyphVertex>& outVertices)
+{
+    if (!str) return 0U;
+
+    // The corners of the unit HUD quad, in the order of the
+    // atlas texture coordinates: top left, top right, bottom
+    // right and bottom left
+    static const real32 s_cornerX[4] = { -0.5f,  0.5f,  0.5f, -0.5f };
+    static const real32 s_cornerY[4] = {  0.5f,  0.5f, -0.5f, -0.5f };
+
+    const real32 glyphWidth = size / aspect;
+    const real32 advance    = size / TEXT_ADVANCE_DIVISOR;
+
+    uint32 nQuads = 0U;
+    real32 penX   = x;
+    for (cstring chr = str;
+                *chr;
+              ++chr, penX += advance)
+    {
+        const uint8 currChar = static_cast<uint8>(*chr);
+        if (currChar == ' ') continue;
+
+        const GlyphRect& rect = glyphTable.gt_glyphs[currChar];
+        if (!rect.gr_valid) continue;
+
+        for (size_t i = 0;
+                    i < 4;
+                  ++i)
+        {
+            GlyphVertex vertex = {};
+            vertex.gv_x  = penX + s_cornerX[i] * glyphWidth;
+            vertex.gv_y  = y    + s_cornerY[i] * size;
+            vertex.gv_tu = s_cornerX[i] < 0.0f ? rect.gr_minTexCoord.x : rect.gr_maxTexCoord.x;
+            vertex.gv_tv = s_cornerY[i] > 0.0f ? rect.gr_minTexCoord.y : rect.gr_maxTexCoord.y;
+            vertex.gv_nz = 1.0f;
+            outVertices.push_back(vertex);
+        }
+        ++nQuads;
+    }
+
+    return nQuads;
+}
+
+void
+textbatch::buildQuadIndices(const uint32         nQuads,
+                            std::vector<uint16>& outIndices)
+{
+    outIndices.resize(nQuads * 6U);
+    for (uint32 i = 0;
+                i < nQuads;
+              ++i)
+    {
+        const uint16 base = static_cast<uint16>(i * 4U);
+        outIndices[i * 6U + 0U] = base + 0U;
+        outIndices[i * 6U + 1U] = base + 1U;
+        outIndices[i * 6U + 2U] = base + 2U;
+        outIndices[i * 6U + 3U] = base + 2U;
+        outIndices[i * 6U + 4U] = base + 3U;
+        outIndices[i * 6U + 5U] = base + 0U;
+    }
+}
+
+void
+textbatch::buildBatches(const uint32            nGlyphs,
+                        const uint32            maxBatchGlyphs,
+                        std::vector<TextBatch>& outBatches)
+{
+    outBatches.clear();
+    if (!maxBatchGlyphs) return;
+
+    for (uint32 firstGlyph = 0U;
+                firstGlyph < nGlyphs;
+                firstGlyph += maxBatchGlyphs)
+    {
+        TextBatch batch = {};
+        batch.tb_firstGlyph = firstGlyph;
+        batch.tb_nGlyphs    = std::min(nGlyphs - firstGlyph, maxBatchGlyphs);
+        outBatches.push_back(batch);
+    }
+}
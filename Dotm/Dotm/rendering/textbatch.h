@@ -0,0 +1,91 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        textbatch.h
+
+   File description: CPU side glyph quad generation
+   for batched text rendering. Strings are turned
+   into screen space quads textured from the font
+   atlas, already transformed, so that all the text
+   of a frame can be drawn with one draw call per
+   batch of MAX_BATCH_GLYPHS glyphs. Nothing here
+   touches the GPU.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../util/math.h"
+#include "../util/strings.h"
+#include "../dotmdef.h"
+#include <vector>
+
+namespace textbatch
+{
+    static const uint32 GLYPH_TABLE_SIZE = 256U;
+
+    // Quads are 4 vertices and 6 indices each. With 16 bit
+    // indices a batch holds at most this many glyphs
+    static const uint32 MAX_BATCH_GLYPHS = 16384U;
+
+    // Same layout as Mesh::Vertex, so that glyph quads go
+    // through the regular HUD shader
+    struct GlyphVertex
+    {
+        real32 gv_x, gv_y, gv_z;
+        real32 gv_tu, gv_tv;
+        real32 gv_nx, gv_ny, gv_nz;
+    };
+
+    // The atlas texture coordinates of a glyph's box
+    struct GlyphRect
+    {
+        vec2f gr_minTexCoord;
+        vec2f gr_maxTexCoord;
+        bool  gr_valid;
+    };
+
+    struct GlyphTable
+    {
+        GlyphRect gt_glyphs[GLYPH_TABLE_SIZE];
+    };
+
+    // A run of consecutive glyph quads drawn with one call
+    struct TextBatch
+    {
+        uint32 tb_firstGlyph;
+        uint32 tb_nGlyphs;
+    };
+
+    // <summary>
+    // <para>
+    // Appends the quads of the string's glyphs in normalized
+    // screen coordinates. Glyphs are size high and size / aspect
+    // wide, centered at their pen position, which starts at
+    // (x, y) and advances by size / 1.5 per character. Spaces and
+    // characters missing from the table advance the pen but emit
+    // no quad. Returns the number of quads appended.
+    // </para>
+    // </summary>
+    uint32
+    appendString(const GlyphTable&         glyphTable,
+                 cstring                   str,
+                 const real32              x,
+                 const real32              y,
+                 const real32              size,
+                 const real32              aspect,
+                 std::vector<GlyphVertex>& outVertices);
+
+    // Fills the indices of nQuads consecutive quads, as two
+    // clockwise triangles each
+    void
+    buildQuadIndices(const uint32          nQuads,
+                     std::vector<uint16>&  outIndices);
+
+    // Splits nGlyphs queued glyphs into batches in queue order,
+    // flushing a batch whenever it holds maxBatchGlyphs glyphs.
+    // outBatches is cleared first
+    void
+    buildBatches(const uint32            nGlyphs,
+                 const uint32            maxBatchGlyphs,
+                 std::vector<TextBatch>& outBatches);
+}
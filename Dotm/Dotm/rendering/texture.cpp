@@ -9,6 +9,8 @@
 
 #include "texture.h"
 #include "ddsloader.h"
+#include "../util/assetpack.h"
+#include "../util/memtracker.h"
 #include "../util/stringutils.h"
 #include "renderer.h"
 #include <string>
@@ -38,7 +40,13 @@ retrieveTexture(const stringID textureID);
 
 Texture::Texture(cstring textureName):
 
-                 m_name(internString(textureName))
+                 Texture(HashedString(textureName))
+{
+}
+
+Texture::Texture(const HashedString& textureName):
+
+                 m_name(textureName.hs_id)
 {
     if (isPresent(m_name))
     {
@@ -46,16 +54,37 @@ Texture::Texture(cstring textureName):
         return;
     }
 
-    std::wstring widePath = L"assets/textures/" + 
-                            string_utils::getwstring(retrieveString(m_name)) +
-                            L".png";
+    MEM_TAG_SCOPE(memtracker::MEM_TAG_TEXTURES);
+
+    // Interned once per texture, for getTextureName
+    internString(textureName.hs_str);
+
+    std::string  assetPath = "assets/textures/" + std::string(textureName.hs_str) + ".png";
+    std::wstring widePath  = string_utils::getwstring(assetPath);
 
-    HRESULT result = DirectX::CreateWICTextureFromFile(Renderer::get()->getDeviceHandle().Get(),
-                                                       Renderer::get()->getDevconHandle().Get(),
-                                                       widePath.c_str(),
-                                                       NULL,
-                                                       &m_texture,
-                                                       0);
+    // Packed textures are decoded straight from the pack's memory
+    HRESULT   result = E_FAIL;
+    AssetData asset  = {};
+    if (AssetPack::get()->read(assetPath, asset))
+    {
+        result = DirectX::CreateWICTextureFromMemory(Renderer::get()->getDeviceHandle().Get(),
+                                                     Renderer::get()->getDevconHandle().Get(),
+                                                     asset.ad_data,
+                                                     asset.ad_size,
+                                                     NULL,
+                                                     &m_texture,
+                                                     0);
+    }
+
+    if (FAILED(result))
+    {
+        result = DirectX::CreateWICTextureFromFile(Renderer::get()->getDeviceHandle().Get(),
+                                                   Renderer::get()->getDevconHandle().Get(),
+                                                   widePath.c_str(),
+                                                   NULL,
+                                                   &m_texture,
+                                                   0);
+    }
     
     if (FAILED(result))
     {        
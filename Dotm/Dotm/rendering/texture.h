@@ -21,6 +21,9 @@ public:
 
     Texture(cstring textureName);
 
+    // Cached textures are found by the precomputed ID alone
+    Texture(const HashedString& textureName);
+
     ~Texture();
     
     comptr<ID3D11ShaderResourceView>
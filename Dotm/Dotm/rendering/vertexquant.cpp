@@ -0,0 +1,343 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        vertexquant.cpp
+
+   File description: Implementation of the vertex
+   quantization functions declared in vertexquant.h
+   ------------------------------------------------ */
+
+#include "vertexquant.h"
+#include <cfloat>
+#include <cstring>
+
+/* ---------
+   Constants
+   --------- */
+#define VQ_UNORM16_MAX           65535.0f
+#define VQ_SNORM16_MAX           32767.0f
+#define VQ_HALF_RELATIVE_ERROR   (1.0f / 2048.0f)
+#define VQ_HALF_ABSOLUTE_ERROR   (1.0f / 33554432.0f)
+#define VQ_MAX_NORMAL_ERROR_DEG  0.01f
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static inline real32
+signNotZero(const real32 value);
+
+static inline uint16
+quantizeUnorm16(const real32 value);
+
+static inline int16
+quantizeSnorm16(const real32 value);
+
+/* --------------
+   Public Methods
+   -------------- */
+uint16
+vertexquant::floatToHalf(const real32 value)
+{
+    uint32 bits;
+    memcpy(&bits, &value, sizeof(uint32));
+
+    const uint32 sign        = (bits >> 16) & 0x8000;
+    const uint32 floatExp    = (bits >> 23) & 0xFF;
+    uint32       mantissa    = bits & 0x7FFFFF;
+    const int32  halfExp     = static_cast<int32>(floatExp) - 127 + 15;
+
+    // Infinity and NaN (NaNs stay quiet NaNs)
+    if (floatExp == 0xFF) return static_cast<uint16>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+    // Overflow to infinity
+    if (halfExp >= 31) return static_cast<uint16>(sign | 0x7C00);
+
+    // Subnormal halves, or underflow to signed zero
+    if (halfExp <= 0)
+    {
+        if (halfExp < -10) return static_cast<uint16>(sign);
+
+        mantissa |= 0x800000;
+        const uint32 shift    = static_cast<uint32>(14 - halfExp);
+        const uint32 halfway  = 1U << (shift - 1);
+        const uint32 rest     = mantissa & ((1U << shift) - 1);
+        uint32       half     = mantissa >> shift;
+
+        // Round to nearest even
+        if (rest > halfway || (rest == halfway && (half & 1))) ++half;
+        return static_cast<uint16>(sign | half);
+    }
+
+    uint32       half = (static_cast<uint32>(halfExp) << 10) | (mantissa >> 13);
+    const uint32 rest = mantissa & 0x1FFF;
+
+    // Round to nearest even. A carry out of the mantissa correctly
+    // bumps the exponent, up to infinity
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) ++half;
+    return static_cast<uint16>(sign | half);
+}
+
+real32
+vertexquant::halfToFloat(const uint16 value)
+{
+    const uint32 sign     = (value & 0x8000U) << 16;
+    const uint32 exponent = (value >> 10) & 0x1F;
+    const uint32 mantissa = value & 0x3FF;
+
+    uint32 bits;
+    if (exponent == 0)
+    {
+        // Zero and subnormals are exactly representable as floats
+        const real32 magnitude = mantissa * (1.0f / 16777216.0f);
+        return sign ? -magnitude : magnitude;
+    }
+    else if (exponent == 31)
+    {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    real32 result;
+    memcpy(&result, &bits, sizeof(real32));
+    return result;
+}
+
+void
+vertexquant::encodeOctahedral(const vec3f& normal, int16 outEncoded[2])
+{
+    // Project onto the octahedron, then fold the lower
+    // hemisphere over the upper one
+    const real32 l1Norm = math::absf(normal.x) + math::absf(normal.y) + math::absf(normal.z);
+    real32 x = l1Norm > 0.0f ? normal.x / l1Norm : 0.0f;
+    real32 y = l1Norm > 0.0f ? normal.y / l1Norm : 0.0f;
+
+    if (normal.z < 0.0f)
+    {
+        const real32 foldedX = (1.0f - math::absf(y)) * signNotZero(x);
+        const real32 foldedY = (1.0f - math::absf(x)) * signNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    outEncoded[0] = quantizeSnorm16(x);
+    outEncoded[1] = quantizeSnorm16(y);
+}
+
+vec3f
+vertexquant::decodeOctahedral(const int16 encoded[2])
+{
+    vec3f normal(math::max2f(encoded[0] / VQ_SNORM16_MAX, -1.0f),
+                 math::max2f(encoded[1] / VQ_SNORM16_MAX, -1.0f),
+                 0.0f);
+    normal.z = 1.0f - math::absf(normal.x) - math::absf(normal.y);
+
+    // Unfold the lower hemisphere
+    const real32 fold = math::max2f(-normal.z, 0.0f);
+    normal.x += normal.x >= 0.0f ? -fold : fold;
+    normal.y += normal.y >= 0.0f ? -fold : fold;
+
+    D3DXVec3Normalize(&normal, &normal);
+    return normal;
+}
+
+vertexquant::QuantParams
+vertexquant::calculateParams(const Mesh::Vertex* vertices,
+                             const size_t        nVertices)
+{
+    vec3f minBounds( FLT_MAX,  FLT_MAX,  FLT_MAX);
+    vec3f maxBounds(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    for (size_t i = 0;
+                i < nVertices;
+              ++i)
+    {
+        minBounds.x = math::min2f(minBounds.x, vertices[i].v_x);
+        minBounds.y = math::min2f(minBounds.y, vertices[i].v_y);
+        minBounds.z = math::min2f(minBounds.z, vertices[i].v_z);
+        maxBounds.x = math::max2f(maxBounds.x, vertices[i].v_x);
+        maxBounds.y = math::max2f(maxBounds.y, vertices[i].v_y);
+        maxBounds.z = math::max2f(maxBounds.z, vertices[i].v_z);
+    }
+
+    QuantParams params = {};
+    if (!nVertices) return params;
+
+    // Flat axes still need a non zero scale to divide by
+    params.qp_offset = minBounds;
+    params.qp_scale  = maxBounds - minBounds;
+    if (params.qp_scale.x <= 0.0f) params.qp_scale.x = 1.0f;
+    if (params.qp_scale.y <= 0.0f) params.qp_scale.y = 1.0f;
+    if (params.qp_scale.z <= 0.0f) params.qp_scale.z = 1.0f;
+
+    return params;
+}
+
+void
+vertexquant::encode(const Mesh::Vertex*         vertices,
+                    const size_t                nVertices,
+                    const QuantParams&          params,
+                    std::vector<CompactVertex>& outCompact)
+{
+    outCompact.resize(nVertices);
+
+    const vec3f invScale(1.0f / params.qp_scale.x,
+                         1.0f / params.qp_scale.y,
+                         1.0f / params.qp_scale.z);
+
+    for (size_t i = 0;
+                i < nVertices;
+              ++i)
+    {
+        const Mesh::Vertex& vertex  = vertices[i];
+        CompactVertex&      compact = outCompact[i];
+
+        compact.cv_position[0] = quantizeUnorm16((vertex.v_x - params.qp_offset.x) * invScale.x);
+        compact.cv_position[1] = quantizeUnorm16((vertex.v_y - params.qp_offset.y) * invScale.y);
+        compact.cv_position[2] = quantizeUnorm16((vertex.v_z - params.qp_offset.z) * invScale.z);
+        compact.cv_position[3] = 0xFFFF;
+
+        compact.cv_texcoord[0] = floatToHalf(vertex.v_tu);
+        compact.cv_texcoord[1] = floatToHalf(vertex.v_tv);
+
+        vec3f normal(vertex.v_nx, vertex.v_ny, vertex.v_nz);
+        if (D3DXVec3Length(&normal) > 0.0f) D3DXVec3Normalize(&normal, &normal);
+        encodeOctahedral(normal, compact.cv_normal);
+    }
+}
+
+void
+vertexquant::decode(const std::vector<CompactVertex>& compact,
+                    const QuantParams&                params,
+                    std::vector<Mesh::Vertex>&        outVertices)
+{
+    outVertices.resize(compact.size());
+
+    for (size_t i = 0;
+                i < compact.size();
+              ++i)
+    {
+        const CompactVertex& source = compact[i];
+        Mesh::Vertex&        vertex = outVertices[i];
+
+        vertex.v_x  = params.qp_offset.x + source.cv_position[0] / VQ_UNORM16_MAX * params.qp_scale.x;
+        vertex.v_y  = params.qp_offset.y + source.cv_position[1] / VQ_UNORM16_MAX * params.qp_scale.y;
+        vertex.v_z  = params.qp_offset.z + source.cv_position[2] / VQ_UNORM16_MAX * params.qp_scale.z;
+        vertex.v_tu = halfToFloat(source.cv_texcoord[0]);
+        vertex.v_tv = halfToFloat(source.cv_texcoord[1]);
+
+        const vec3f normal = decodeOctahedral(source.cv_normal);
+        vertex.v_nx = normal.x;
+        vertex.v_ny = normal.y;
+        vertex.v_nz = normal.z;
+    }
+}
+
+mat4x4
+vertexquant::getDequantizationMatrix(const QuantParams& params)
+{
+    mat4x4 scaleMatrix, translationMatrix;
+    D3DXMatrixScaling(&scaleMatrix, params.qp_scale.x, params.qp_scale.y, params.qp_scale.z);
+    D3DXMatrixTranslation(&translationMatrix, params.qp_offset.x, params.qp_offset.y, params.qp_offset.z);
+    return scaleMatrix * translationMatrix;
+}
+
+vertexquant::ErrorReport
+vertexquant::measureError(const Mesh::Vertex*               vertices,
+                          const std::vector<CompactVertex>& compact,
+                          const QuantParams&                params)
+{
+    ErrorReport report = {};
+    report.er_withinBounds = true;
+
+    std::vector<Mesh::Vertex> decoded;
+    decode(compact, params, decoded);
+
+    // Half a grid step, plus float rounding relative to the
+    // magnitude of the values involved
+    const vec3f positionBound(0.5f * params.qp_scale.x / VQ_UNORM16_MAX,
+                              0.5f * params.qp_scale.y / VQ_UNORM16_MAX,
+                              0.5f * params.qp_scale.z / VQ_UNORM16_MAX);
+
+    for (size_t i = 0;
+                i < decoded.size();
+              ++i)
+    {
+        const Mesh::Vertex& original = vertices[i];
+        const Mesh::Vertex& result   = decoded[i];
+
+        const real32 positionError[3] = { math::absf(result.v_x - original.v_x),
+                                          math::absf(result.v_y - original.v_y),
+                                          math::absf(result.v_z - original.v_z) };
+        const real32 bounds[3]        = { positionBound.x, positionBound.y, positionBound.z };
+        const real32 magnitudes[3]    = { math::absf(params.qp_offset.x) + params.qp_scale.x,
+                                          math::absf(params.qp_offset.y) + params.qp_scale.y,
+                                          math::absf(params.qp_offset.z) + params.qp_scale.z };
+        for (size_t axis = 0;
+                    axis < 3;
+                  ++axis)
+        {
+            report.er_maxPositionError = math::max2f(report.er_maxPositionError, positionError[axis]);
+            if (positionError[axis] > bounds[axis] + 4.0f * FLT_EPSILON * magnitudes[axis])
+            {
+                report.er_withinBounds = false;
+            }
+        }
+
+        const real32 originalTexcoords[2] = { original.v_tu, original.v_tv };
+        const real32 resultTexcoords[2]   = { result.v_tu, result.v_tv };
+        for (size_t axis = 0;
+                    axis < 2;
+                  ++axis)
+        {
+            const real32 error = math::absf(resultTexcoords[axis] - originalTexcoords[axis]);
+            const real32 bound = math::max2f(math::absf(originalTexcoords[axis]) * VQ_HALF_RELATIVE_ERROR,
+                                             VQ_HALF_ABSOLUTE_ERROR);
+            report.er_maxTexcoordError = math::max2f(report.er_maxTexcoordError, error);
+            if (error > bound) report.er_withinBounds = false;
+        }
+
+        // Degenerate normals carry no direction to preserve
+        vec3f originalNormal(original.v_nx, original.v_ny, original.v_nz);
+        if (D3DXVec3Length(&originalNormal) <= 0.0f) continue;
+        D3DXVec3Normalize(&originalNormal, &originalNormal);
+
+        // The chord between the unit normals keeps its precision for
+        // small angles, unlike the arc cosine of their dot product
+        const vec3f  chord(result.v_nx - originalNormal.x,
+                           result.v_ny - originalNormal.y,
+                           result.v_nz - originalNormal.z);
+        const real32 halfChord = math::min2f(0.5f * D3DXVec3Length(&chord), 1.0f);
+        const real32 angle     = math::toDegrees(2.0f * std::asin(halfChord));
+        report.er_maxNormalErrorDegrees = math::max2f(report.er_maxNormalErrorDegrees, angle);
+        if (angle > VQ_MAX_NORMAL_ERROR_DEG) report.er_withinBounds = false;
+    }
+
+    return report;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static inline real32
+signNotZero(const real32 value)
+{
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+static inline uint16
+quantizeUnorm16(const real32 value)
+{
+    const real32 clamped = math::min2f(math::max2f(value, 0.0f), 1.0f);
+    return static_cast<uint16>(clamped * VQ_UNORM16_MAX + 0.5f);
+}
+
+static inline int16
+quantizeSnorm16(const real32 value)
+{
+    const real32 clamped = math::min2f(math::max2f(value, -1.0f), 1.0f);
+    const real32 scaled  = clamped * VQ_SNORM16_MAX;
+    return static_cast<int16>(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
@@ -0,0 +1,96 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        vertexquant.h
+
+   File description: A compact 16 byte vertex
+   layout and the functions converting between it
+   and the 32 byte Mesh::Vertex. Positions are
+   stored as 16 bit normalized values relative to
+   the mesh bounds, texture coordinates as half
+   floats and normals octahedral encoded into two
+   16 bit normalized values.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "mesh.h"
+#include "../util/math.h"
+#include "../dotmdef.h"
+#include <vector>
+
+namespace vertexquant
+{
+    // Maps to R16G16B16A16_UNORM, R16G16_FLOAT and R16G16_SNORM. The
+    // fourth position component is always 1.0 so that the position
+    // arrives in the shader ready for the matrix transforms
+    struct CompactVertex
+    {
+        uint16 cv_position[4];
+        uint16 cv_texcoord[2];
+        int16  cv_normal[2];
+    };
+
+    // Dequantization: position = qp_offset + normalized * qp_scale
+    struct QuantParams
+    {
+        vec3f qp_offset;
+        vec3f qp_scale;
+    };
+
+    struct ErrorReport
+    {
+        real32 er_maxPositionError;
+        real32 er_maxTexcoordError;
+        real32 er_maxNormalErrorDegrees;
+        bool   er_withinBounds;
+    };
+
+    uint16
+    floatToHalf(const real32 value);
+
+    real32
+    halfToFloat(const uint16 value);
+
+    // Expects a unit length normal
+    void
+    encodeOctahedral(const vec3f& normal, int16 outEncoded[2]);
+
+    vec3f
+    decodeOctahedral(const int16 encoded[2]);
+
+    // Calculates the quantization grid spanning the vertices' bounds
+    QuantParams
+    calculateParams(const Mesh::Vertex* vertices,
+                    const size_t        nVertices);
+
+    void
+    encode(const Mesh::Vertex*         vertices,
+           const size_t                nVertices,
+           const QuantParams&          params,
+           std::vector<CompactVertex>& outCompact);
+
+    void
+    decode(const std::vector<CompactVertex>& compact,
+           const QuantParams&                params,
+           std::vector<Mesh::Vertex>&        outVertices);
+
+    // Dequantization folded into a matrix to be applied before
+    // the world matrix
+    mat4x4
+    getDequantizationMatrix(const QuantParams& params);
+
+    // <summary>
+    // <para>
+    // Decodes the compact vertices and compares them against the
+    // originals, reporting the largest error of each attribute and
+    // whether each stayed within the bounds the encoding guarantees
+    // (half a grid step per position axis, half a half-float ulp per
+    // texture coordinate and a hundredth of a degree per normal).
+    // </para>
+    // </summary>
+    ErrorReport
+    measureError(const Mesh::Vertex*               vertices,
+                 const std::vector<CompactVertex>& compact,
+                 const QuantParams&                params);
+}
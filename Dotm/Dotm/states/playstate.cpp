@@ -19,15 +19,16 @@
 #include "../game/basemanager.h"
 #include "../systemmonitor.h"
 #include "../util/logging.h"
+#include "../util/memtracker.h"
+#include "../util/profiler.h"
 #include "../handlers/inputhandler.h"
-#include <ctime>
-#include <random>
-#include <string>
+#include <cstdio>
 
-static uint64 frameCounter   = 0;
-static uint64 lastUpdateTick = 0;
-static uint64 lastRenderTick = 0;
-static bool   updateTicks    = false;
+/* ---------
+   Constants
+   --------- */
+#define PROFILE_CAPTURE_PATH  "profile_capture.json"
+#define MEMORY_SNAPSHOT_PATH  "memory_snapshot.json"
 
 /* --------------
    Public Methods
@@ -49,7 +50,8 @@ PlayState::PlayState():
                        m_scene,
                        Entity::ENTITY_PROPERTY_STATIC,
                        {0.0f, -0.6f, 0.0f},
-                       "dessert"))
+                       "dessert")),
+    m_random(InputHandler::get()->getSessionSeed())
 
 { 
     m_baseManager = new BaseManager(m_scene, m_levelGrid, m_camera);
@@ -81,6 +83,16 @@ PlayState::PlayState():
 
 PlayState::~PlayState()
 { 
+    if (m_sysmonitor && !m_sysmonitor->writeReport())
+    {
+        logline("Could not write the performance report");
+    }
+
+    if (!memtracker::writeSnapshot(MEMORY_SNAPSHOT_PATH))
+    {
+        logline("Could not write the memory snapshot");
+    }
+
     if (m_camera)      delete m_camera;
     if (m_sysmonitor)  delete m_sysmonitor;
     if (m_sun)         delete m_sun;      
@@ -97,14 +109,16 @@ PlayState::~PlayState()
 
 void
 PlayState::update()
-{      
-    uint64 updateStart = m_sysmonitor->getTimeMS();
+{
+    PROFILE_ZONE("PlayState::update");
+
+    // Closes the previous frame's measurements
+    m_sysmonitor->update();
+    const ullong64 updateStart = SystemMonitor::getTimeUS();
 
     if (InputHandler::get()->isTapped(InputHandler::KEY_E))
     {
-        
-        std::srand((uint32)std::time(NULL));
-        int minionType = std::rand() % 3;
+        const uint32 minionType = m_random() % 3;
         EAIMinion* newEnemy = nullptr;
 
         if(minionType == 0)
@@ -147,57 +161,71 @@ PlayState::update()
         newEnemy->getBody()->rotation.y = PI_FL;
         newEnemy->findPathTo(m_levelGrid->getTilePos3f(5, 10), true);
     }
-    
-    m_scene->update();    
-    m_camera->update();        
-    m_baseManager->update();
-    m_sysmonitor->update(); 
-
-    /* Profiling */
-    frameCounter++;
-    updateTicks = false;
 
-    if(frameCounter == 20)
+    // Dumps the zones of the last frames for chrome://tracing
+    if (InputHandler::get()->isTapped(InputHandler::KEY_P))
     {
-        updateTicks = true;
-        frameCounter = 0;
+        if (!profiler::exportChromeTrace(PROFILE_CAPTURE_PATH))
+        {
+            logline("Could not write the profile capture");
+        }
     }
 
-    if(updateTicks)
+    // Dumps the live, peak and per frame allocations of every tag
+    if (InputHandler::get()->isTapped(InputHandler::KEY_M))
     {
-        lastUpdateTick = m_sysmonitor->getTimeMS() - updateStart;
+        if (!memtracker::writeSnapshot(MEMORY_SNAPSHOT_PATH))
+        {
+            logline("Could not write the memory snapshot");
+        }
     }
+    
+    m_scene->update();    
+    m_camera->update();        
+    m_baseManager->update();
+
+    m_sysmonitor->recordUpdateTime(SystemMonitor::getTimeUS() - updateStart);
 }
 
 void
 PlayState::render()
 {
+    PROFILE_ZONE("PlayState::render");
+
     Renderer::get()->beginFrame();
     Renderer::get()->renderMesh(m_sky);
 
     //m_levelGrid->renderDebug(1, true);
     //m_scene->renderDebug();
-    static int frameCounter = 0;
-    frameCounter++;
-    
-    uint64 renderStart = m_sysmonitor->getTimeMS();
-    Renderer::get()->renderScene(m_scene);    
-    
-
-    if(updateTicks)
-    {
-        lastRenderTick = m_sysmonitor->getTimeMS() - renderStart;
-        updateTicks = false;
-    }
 
-    // Profiling
-    Renderer::get()->renderString("Fps: ", -0.95f, 0.95f); 
-    Renderer::get()->renderString(std::to_string(m_sysmonitor->getFPS()).c_str(), -0.7f, 0.95f);
-    Renderer::get()->renderString("Cpu: ", -0.95f, 0.80f);
-    Renderer::get()->renderString(std::string(std::to_string(m_sysmonitor->getCpuUsagePerc()) + "%").c_str(), -0.70f, 0.80f);
-    Renderer::get()->renderString("Mem: ", -0.95f, 0.65f);
-    Renderer::get()->renderString(std::string(std::to_string(m_sysmonitor->getMemUsage()) + "mb").c_str(), -0.70f, 0.65f);            
-    Renderer::get()->renderString(("Update: " + std::to_string(lastUpdateTick)).c_str(), -0.95f, 0.5f);
-    Renderer::get()->renderString(("Render: " + std::to_string(lastRenderTick)).c_str(), -0.95f, 0.35f);
+    const ullong64 renderStart = SystemMonitor::getTimeUS();
+    Renderer::get()->renderScene(m_scene);
+    m_sysmonitor->recordRenderTime(SystemMonitor::getTimeUS() - renderStart);
+
+    // Profiling. Lines are formatted on the stack, as the
+    // renderer copies the glyphs into its text batch
+    const Renderer::FrameStats& frameStats = Renderer::get()->getFrameStats();
+    char statLine[32];
+
+    snprintf(statLine, sizeof(statLine), "Fps: %u", m_sysmonitor->getFPS());
+    Renderer::get()->renderString(statLine, -0.95f, 0.95f);
+    snprintf(statLine, sizeof(statLine), "Cpu: %u%%", m_sysmonitor->getCpuUsagePerc());
+    Renderer::get()->renderString(statLine, -0.95f, 0.80f);
+    snprintf(statLine, sizeof(statLine), "Mem: %umb", m_sysmonitor->getMemUsage());
+    Renderer::get()->renderString(statLine, -0.95f, 0.65f);
+    snprintf(statLine, sizeof(statLine), "Update: %.2fms", m_sysmonitor->getUpdateTimeMS());
+    Renderer::get()->renderString(statLine, -0.95f, 0.5f);
+    snprintf(statLine, sizeof(statLine), "Render: %.2fms", m_sysmonitor->getRenderTimeMS());
+    Renderer::get()->renderString(statLine, -0.95f, 0.35f);
+    snprintf(statLine, sizeof(statLine), "Tris: %u", frameStats.fs_triangles);
+    Renderer::get()->renderString(statLine, -0.95f, 0.2f);
+    snprintf(statLine, sizeof(statLine), "Draws: %u", frameStats.fs_drawCalls);
+    Renderer::get()->renderString(statLine, -0.95f, 0.05f);
+    snprintf(statLine, sizeof(statLine), "States: %u", frameStats.fs_stateChanges);
+    Renderer::get()->renderString(statLine, -0.95f, -0.1f);
+    snprintf(statLine, sizeof(statLine), "Cbuf: %ukb", frameStats.fs_constantBytes / 1024U);
+    Renderer::get()->renderString(statLine, -0.95f, -0.25f);
+    snprintf(statLine, sizeof(statLine), "Hitches: %u", m_sysmonitor->getHitchCount());
+    Renderer::get()->renderString(statLine, -0.95f, -0.4f);
     Renderer::get()->endFrame();
 }
\ No newline at end of file
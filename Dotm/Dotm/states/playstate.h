@@ -13,15 +13,16 @@
 
 #include "agamestate.h"
 #include "../util/strings.h"
+#include <random>
 
 class Mesh;
 class Entity;
 class EAIMinion;
 class BaseManager;
 class PointLight;
+class DirectionalLight;
 class Camera;
 class SystemMonitor;
-class Light;
 class Scene;
 class Tilemap;
 class PlayState: public AGameState
@@ -50,15 +51,19 @@ private:
 
 private:    
     
-    Scene*          m_scene;
-    EAIMinion*      m_enemy;    
-    BaseManager*    m_baseManager;
-    Entity*         m_field;        
-    Mesh*           m_sky;
-    PointLight*     m_pointLights[4];
-    Camera*         m_camera;
-    SystemMonitor*  m_sysmonitor;
-    Light*          m_sun;        
-    Tilemap*        m_levelGrid;
+    Scene*            m_scene;
+    EAIMinion*        m_enemy;
+    BaseManager*      m_baseManager;
+    Entity*           m_field;
+    Mesh*             m_sky;
+    PointLight*       m_pointLights[4];
+    Camera*           m_camera;
+    SystemMonitor*    m_sysmonitor;
+    DirectionalLight* m_sun;
+    Tilemap*          m_levelGrid;
+
+    // Seeded with the input session's seed, so that replayed
+    // sessions spawn the same enemies
+    std::mt19937      m_random;
 
 };
\ No newline at end of file
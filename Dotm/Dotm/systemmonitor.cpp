@@ -9,32 +9,95 @@
    ------------------------------------------ */
 
 #include "systemmonitor.h"
-#include <Windows.h>
-#include <Psapi.h>
+#include "config/configparser.h"
 #include "util/logging.h"
+#include "util/memtracker.h"
+#include <algorithm>
+#include <cstdio>
 
+#if defined(_WIN32)
+#include <Windows.h>
+#include <Psapi.h>
 #pragma comment (lib, "winmm.lib")
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/* ---------
+   Constants
+   --------- */
+#define TIME_BUCKET_MICROS       50U
+#define TIME_BUCKET_COUNT        5000U
+#define ALLOC_BUCKET_COUNT       4096U
+#define DEFAULT_HITCH_MS         33.3f
+#define DEFAULT_REPORT_PATH      "perf_report.json"
 
 /* -------------
    Internal Vars
    ------------- */
-static ULARGE_INTEGER lastCPU, lastSysCPU, lastUserCPU;
-static HANDLE thisProcess;
+static ullong64 s_lastCpuMicros  = 0U;
+static ullong64 s_lastWallMicros = 0U;
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static uint32
+queryProcessorCount();
+
+static ullong64
+queryProcessCpuMicros();
+
+static ullong64
+queryResidentBytes();
+
+static uint32
+clampToUint(const ullong64 value);
+
+static uint32
+getPercentile(const std::vector<uint32>& buckets,
+              const uint32               bucketWidth,
+              const uint32               nSamples,
+              const uint32               maxSample,
+              const real64               percentile);
 
 /* --------------
    Static Methods
    -------------- */
-
 uint64
 SystemMonitor::getTimeMS()
 {
+#if defined(_WIN32)
     return timeGetTime();
+#else
+    return static_cast<uint64>(getTimeUS() / 1000U);
+#endif
 }
 
 uint64
 SystemMonitor::getTimeS()
 {
-    return timeGetTime() / 1000;
+    return getTimeMS() / 1000;
+}
+
+ullong64
+SystemMonitor::getTimeUS()
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER s_frequency = {};
+    if (!s_frequency.QuadPart) QueryPerformanceFrequency(&s_frequency);
+
+    // Split to not overflow on long uptimes
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    const ullong64 ticks     = static_cast<ullong64>(counter.QuadPart);
+    const ullong64 frequency = static_cast<ullong64>(s_frequency.QuadPart);
+    return (ticks / frequency) * 1000000U + (ticks % frequency) * 1000000U / frequency;
+#else
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<ullong64>(now.tv_sec) * 1000000U + static_cast<ullong64>(now.tv_nsec) / 1000U;
+#endif
 }
 
 /* --------------
@@ -44,24 +107,50 @@ SystemMonitor::SystemMonitor():
     
     m_fpsCounter(0U),
     m_memUsage(0U),
+    m_peakMemUsage(0U),
     m_cpuUsage(0U),
-    m_numProcessors(0U),
+    m_numProcessors(queryProcessorCount()),
     m_frames(0U),
-    m_startTime(timeGetTime())
+    m_startTime(getTimeMS()),
+    m_reportPath(DEFAULT_REPORT_PATH),
+    m_hitchMicros(static_cast<uint32>(DEFAULT_HITCH_MS * 1000.0f)),
+    m_hitchCount(0U),
+    m_frameIndex(0U),
+    m_sessionStart(getTimeUS()),
+    m_frameStart(0U),
+    m_frameAllocStart(0U),
+    m_updateMicros(0U),
+    m_renderMicros(0U),
+    m_secondUpdateMicros(0U),
+    m_secondRenderMicros(0U),
+    m_avgUpdateMS(0.0f),
+    m_avgRenderMS(0.0f)
 {
-    SYSTEM_INFO sysInfo;
-    FILETIME ftime, fsys, fuser;
+    for (size_t i = 0;
+                i < METRIC_COUNT;
+              ++i)
+    {
+        // The last bucket collects everything beyond the range
+        Histogram& histogram    = m_histograms[i];
+        const bool allocations  = i == METRIC_ALLOCATIONS;
+        histogram.h_bucketWidth = allocations ? 1U : TIME_BUCKET_MICROS;
+        histogram.h_buckets.assign(allocations ? ALLOC_BUCKET_COUNT : TIME_BUCKET_COUNT, 0U);
+        histogram.h_samples     = 0U;
+        histogram.h_max         = 0U;
+        histogram.h_sum         = 0U;
+    }
 
-    GetSystemInfo(&sysInfo);
-    m_numProcessors = sysInfo.dwNumberOfProcessors;
-    
-    GetSystemTimeAsFileTime(&ftime);
-    memcpy(&lastCPU, &ftime, sizeof(FILETIME));
-    
-    thisProcess = GetCurrentProcess();
-    GetProcessTimes(thisProcess, &ftime, &ftime, &fsys, &fuser);
-    memcpy(&lastSysCPU, &fsys, sizeof(FILETIME));
-    memcpy(&lastUserCPU, &fuser, sizeof(FILETIME));
+    if (config::initConfigFile("monconfig"))
+    {
+        const real32 hitchMS = config::getFloat("monconfig", "hitch_threshold_ms", DEFAULT_HITCH_MS);
+        m_hitchMicros = static_cast<uint32>(hitchMS * 1000.0f);
+
+        cstring reportPath = retrieveString(config::getString("monconfig", "report_path", DEFAULT_REPORT_PATH));
+        if (reportPath && *reportPath) m_reportPath = reportPath;
+    }
+
+    s_lastWallMicros = getTimeUS();
+    s_lastCpuMicros  = queryProcessCpuMicros();
 }
 
 SystemMonitor::~SystemMonitor()
@@ -72,51 +161,151 @@ SystemMonitor::~SystemMonitor()
 void
 SystemMonitor::update()
 {
+    const ullong64 now         = getTimeUS();
+    const ullong64 allocations = memtracker::getAllocationCount();
+
+    // Nothing to record before the first frame has started
+    if (m_frameStart)
+    {
+        const uint32 samples[METRIC_COUNT] =
+        {
+            clampToUint(now - m_frameStart),
+            clampToUint(m_updateMicros),
+            clampToUint(m_renderMicros),
+            clampToUint(allocations - m_frameAllocStart)
+        };
+
+        for (size_t i = 0;
+                    i < METRIC_COUNT;
+                  ++i)
+        {
+            Histogram&   histogram = m_histograms[i];
+            const size_t bucket    = std::min(static_cast<size_t>(samples[i] / histogram.h_bucketWidth),
+                                              histogram.h_buckets.size() - 1U);
+            ++histogram.h_buckets[bucket];
+            ++histogram.h_samples;
+            histogram.h_sum += samples[i];
+            histogram.h_max  = std::max(histogram.h_max, samples[i]);
+        }
+
+        if (samples[METRIC_FRAME_TIME] > m_hitchMicros)
+        {
+            ++m_hitchCount;
+            if (m_hitches.size() < MAX_RECORDED_HITCHES)
+            {
+                Hitch hitch = {};
+                hitch.h_frame        = m_frameIndex;
+                hitch.h_frameMicros  = samples[METRIC_FRAME_TIME];
+                hitch.h_updateMicros = samples[METRIC_UPDATE_TIME];
+                hitch.h_renderMicros = samples[METRIC_RENDER_TIME];
+                hitch.h_allocations  = samples[METRIC_ALLOCATIONS];
+                m_hitches.push_back(hitch);
+            }
+
+            logstring("Hitch (us): ");
+            logline(samples[METRIC_FRAME_TIME]);
+        }
+
+        ++m_frameIndex;
+    }
+
+    m_frameStart          = now;
+    m_frameAllocStart     = allocations;
+    m_secondUpdateMicros += m_updateMicros;
+    m_secondRenderMicros += m_renderMicros;
+    m_updateMicros        = 0U;
+    m_renderMicros        = 0U;
+
     // FPS calculations
     m_frames++;
-    uint64 currTime = timeGetTime();
+    uint64 currTime = getTimeMS();
     if (currTime >= (m_startTime + 1000))
     {
-        m_fpsCounter = m_frames;
-        m_startTime  = currTime;
-        m_frames     = 0U;
+        m_fpsCounter  = m_frames;
+        m_avgUpdateMS = static_cast<real64>(m_secondUpdateMicros) / (m_frames * 1000.0f);
+        m_avgRenderMS = static_cast<real64>(m_secondRenderMicros) / (m_frames * 1000.0f);
 
-        // Physical memory calculations
-        MEMORYSTATUSEX memoryInfo = {};
-        memoryInfo.dwLength = sizeof(MEMORYSTATUSEX);
-        GlobalMemoryStatusEx(&memoryInfo);
+        m_startTime          = currTime;
+        m_frames             = 0U;
+        m_secondUpdateMicros = 0U;
+        m_secondRenderMicros = 0U;
 
-        DWORDLONG totalPhysicalMemory = memoryInfo.ullTotalPhys;
+        sampleProcess();
+    }
+}
 
-        PROCESS_MEMORY_COUNTERS pmc;
-        GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
-        SIZE_T memUsedByProcess = pmc.WorkingSetSize;
+void
+SystemMonitor::recordUpdateTime(const ullong64 micros)
+{
+    m_updateMicros += micros;
+}
+
+void
+SystemMonitor::recordRenderTime(const ullong64 micros)
+{
+    m_renderMicros += micros;
+}
 
-        real64 ratio = ((real64) memUsedByProcess / (real64) totalPhysicalMemory);
-        m_memUsage = (uint32) (memUsedByProcess / 1e6);
+bool
+SystemMonitor::writeReport() logical_const
+{
+    FILE* file = fopen(m_reportPath.c_str(), "w");
+    if (!file) return false;
 
-        // CPU calculations
-        FILETIME ftime, fsys, fuser;
-        ULARGE_INTEGER now, sys, user;
-        real64 percent;
+    static const cstring s_metricNames[METRIC_COUNT] =
+    {
+        "frame_time_us",
+        "update_time_us",
+        "render_time_us",
+        "allocations_per_frame"
+    };
 
-        GetSystemTimeAsFileTime(&ftime);
-        memcpy(&now, &ftime, sizeof(FILETIME));
+    fprintf(file, "{\n");
+    fprintf(file, "  \"frames\": %u,\n", m_frameIndex);
+    fprintf(file, "  \"session_seconds\": %.3f,\n", (getTimeUS() - m_sessionStart) / 1000000.0);
+    fprintf(file, "  \"processors\": %u,\n", m_numProcessors);
+    fprintf(file, "  \"peak_memory_mb\": %u,\n", m_peakMemUsage);
+    fprintf(file, "  \"hitch_threshold_us\": %u,\n", m_hitchMicros);
+    fprintf(file, "  \"hitch_count\": %u,\n", m_hitchCount);
+    fprintf(file, "  \"metrics\": {\n");
 
+    for (size_t i = 0;
+                i < METRIC_COUNT;
+              ++i)
+    {
+        const MetricSummary summary = getSummary(static_cast<FrameMetric>(i));
+        fprintf(file,
+                "    \"%s\": { \"samples\": %u, \"p50\": %u, \"p95\": %u, \"p99\": %u, \"max\": %u, \"mean\": %.3f }%s\n",
+                s_metricNames[i],
+                summary.ms_samples,
+                summary.ms_p50,
+                summary.ms_p95,
+                summary.ms_p99,
+                summary.ms_max,
+                summary.ms_mean,
+                i + 1U < METRIC_COUNT ? "," : "");
+    }
 
-        GetProcessTimes(thisProcess, &ftime, &ftime, &fsys, &fuser);
-        memcpy(&sys, &fsys, sizeof(FILETIME));
-        memcpy(&user, &fuser, sizeof(FILETIME));
-        percent = (real64) ((sys.QuadPart - lastSysCPU.QuadPart) +
-            (user.QuadPart - lastUserCPU.QuadPart));
-        percent /= (now.QuadPart - lastCPU.QuadPart);
-        percent /= m_numProcessors;
-        lastCPU = now;
-        lastUserCPU = user;
-        lastSysCPU = sys;
+    fprintf(file, "  },\n");
+    fprintf(file, "  \"hitches\": [");
 
-        m_cpuUsage = (uint32) (percent * 100);
+    for (size_t i = 0;
+                i < m_hitches.size();
+              ++i)
+    {
+        const Hitch& hitch = m_hitches[i];
+        fprintf(file,
+                "%s\n    { \"frame\": %u, \"frame_us\": %u, \"update_us\": %u, \"render_us\": %u, \"allocations\": %u }",
+                i ? "," : "",
+                hitch.h_frame,
+                hitch.h_frameMicros,
+                hitch.h_updateMicros,
+                hitch.h_renderMicros,
+                hitch.h_allocations);
     }
+
+    fprintf(file, "%s]\n}\n", m_hitches.empty() ? "" : "\n  ");
+    return fclose(file) == 0;
 }
 
 void
@@ -144,3 +333,154 @@ SystemMonitor::getCpuUsagePerc() logical_const
 {
     return m_cpuUsage;
 }
+
+real64
+SystemMonitor::getUpdateTimeMS() logical_const
+{
+    return m_avgUpdateMS;
+}
+
+real64
+SystemMonitor::getRenderTimeMS() logical_const
+{
+    return m_avgRenderMS;
+}
+
+uint32
+SystemMonitor::getHitchCount() logical_const
+{
+    return m_hitchCount;
+}
+
+SystemMonitor::MetricSummary
+SystemMonitor::getSummary(const FrameMetric metric) logical_const
+{
+    const Histogram& histogram = m_histograms[metric];
+
+    MetricSummary summary = {};
+    summary.ms_samples = histogram.h_samples;
+    if (!histogram.h_samples) return summary;
+
+    summary.ms_p50  = getPercentile(histogram.h_buckets, histogram.h_bucketWidth, histogram.h_samples, histogram.h_max, 0.50f);
+    summary.ms_p95  = getPercentile(histogram.h_buckets, histogram.h_bucketWidth, histogram.h_samples, histogram.h_max, 0.95f);
+    summary.ms_p99  = getPercentile(histogram.h_buckets, histogram.h_bucketWidth, histogram.h_samples, histogram.h_max, 0.99f);
+    summary.ms_max  = histogram.h_max;
+    summary.ms_mean = static_cast<real64>(histogram.h_sum) / histogram.h_samples;
+    return summary;
+}
+
+/* ---------------
+   Private Methods
+   --------------- */
+void
+SystemMonitor::sampleProcess()
+{
+    // Physical memory calculations
+    m_memUsage     = static_cast<uint32>(queryResidentBytes() / 1000000U);
+    m_peakMemUsage = std::max(m_peakMemUsage, m_memUsage);
+
+    // CPU calculations, as the share of all processors' time
+    const ullong64 wallMicros = getTimeUS();
+    const ullong64 cpuMicros  = queryProcessCpuMicros();
+    if (wallMicros > s_lastWallMicros && m_numProcessors)
+    {
+        real64 percent = static_cast<real64>(cpuMicros - s_lastCpuMicros);
+        percent /= static_cast<real64>(wallMicros - s_lastWallMicros);
+        percent /= m_numProcessors;
+        m_cpuUsage = static_cast<uint32>(percent * 100);
+    }
+
+    s_lastWallMicros = wallMicros;
+    s_lastCpuMicros  = cpuMicros;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static uint32
+queryProcessorCount()
+{
+#if defined(_WIN32)
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    return sysInfo.dwNumberOfProcessors;
+#else
+    const long nProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+    return nProcessors > 0 ? static_cast<uint32>(nProcessors) : 1U;
+#endif
+}
+
+static ullong64
+queryProcessCpuMicros()
+{
+#if defined(_WIN32)
+    // Kernel plus user time, in 100ns units
+    FILETIME ftime, fsys, fuser;
+    ULARGE_INTEGER sys, user;
+    GetProcessTimes(GetCurrentProcess(), &ftime, &ftime, &fsys, &fuser);
+    memcpy(&sys, &fsys, sizeof(FILETIME));
+    memcpy(&user, &fuser, sizeof(FILETIME));
+    return (sys.QuadPart + user.QuadPart) / 10U;
+#else
+    timespec cpuTime;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuTime);
+    return static_cast<ullong64>(cpuTime.tv_sec) * 1000000U + static_cast<ullong64>(cpuTime.tv_nsec) / 1000U;
+#endif
+}
+
+static ullong64
+queryResidentBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
+    return pmc.WorkingSetSize;
+#else
+    // The second field of statm is the resident set, in pages
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) return 0U;
+
+    unsigned long totalPages    = 0U;
+    unsigned long residentPages = 0U;
+    const int     nRead         = fscanf(statm, "%lu %lu", &totalPages, &residentPages);
+    fclose(statm);
+
+    if (nRead != 2) return 0U;
+    return static_cast<ullong64>(residentPages) * static_cast<ullong64>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+static uint32
+clampToUint(const ullong64 value)
+{
+    return value > 0xFFFFFFFFULL ? 0xFFFFFFFFU : static_cast<uint32>(value);
+}
+
+static uint32
+getPercentile(const std::vector<uint32>& buckets,
+              const uint32               bucketWidth,
+              const uint32               nSamples,
+              const uint32               maxSample,
+              const real64               percentile)
+{
+    // The sample of this rank falls in the first bucket where the
+    // running count reaches it, reported as the bucket's upper end.
+    // The last bucket also holds every larger sample, so it has no
+    // upper end but the largest sample seen
+    const uint32 rank = std::max(1U, static_cast<uint32>(percentile * nSamples + 0.999f));
+
+    uint32 count = 0U;
+    for (size_t i = 0;
+                i < buckets.size();
+              ++i)
+    {
+        count += buckets[i];
+        if (count >= rank)
+        {
+            if (i + 1U == buckets.size()) return maxSample;
+            return std::min(static_cast<uint32>((i + 1U) * bucketWidth - 1U), maxSample);
+        }
+    }
+
+    return maxSample;
+}
@@ -4,15 +4,56 @@
    File name:        systemmonitor.h
    
    File description: A class representing
-   a monitor for the current system
+   a monitor for the current system. Besides
+   the once per second FPS, CPU and memory
+   figures, every frame's update, render and
+   total times and heap allocation count are
+   kept in histograms, frames slower than the
+   hitch threshold are recorded, and the lot
+   can be written as a JSON report for the
+   perf regression dashboards. Win32 and
+   POSIX (Linux /proc) are supported.
    ------------------------------------------ */
 
 #pragma once
 
 #include "dotmdef.h"
+#include <string>
+#include <vector>
 
 class SystemMonitor
 {
+public:
+
+    enum FrameMetric
+    {
+        METRIC_FRAME_TIME,
+        METRIC_UPDATE_TIME,
+        METRIC_RENDER_TIME,
+        METRIC_ALLOCATIONS,
+        METRIC_COUNT
+    };
+
+    // Times are in microseconds
+    struct MetricSummary
+    {
+        uint32 ms_samples;
+        uint32 ms_p50;
+        uint32 ms_p95;
+        uint32 ms_p99;
+        uint32 ms_max;
+        real64 ms_mean;
+    };
+
+    struct Hitch
+    {
+        uint32 h_frame;
+        uint32 h_frameMicros;
+        uint32 h_updateMicros;
+        uint32 h_renderMicros;
+        uint32 h_allocations;
+    };
+
 public:
     
     static uint64
@@ -21,6 +62,10 @@ public:
     static uint64
     getTimeS();
 
+    // Monotonic, high resolution
+    static ullong64
+    getTimeUS();
+
 public:
 
     SystemMonitor();
@@ -32,9 +77,28 @@ public:
     SystemMonitor&
     operator = (const SystemMonitor& rhs) = delete;
 
+    // <summary>
+    // <para>
+    // Closes the frame started by the previous call, recording
+    // its total time, the update and render times reported for it
+    // and the heap allocations made during it. Call once per
+    // frame, before the frame's update.
+    // </para>
+    // </summary>
     void
     update();
 
+    void
+    recordUpdateTime(const ullong64 micros);
+
+    void
+    recordRenderTime(const ullong64 micros);
+
+    // Writes the session's summaries and hitches as JSON to the
+    // configured report path
+    bool
+    writeReport() logical_const;
+
     void
     loglap(const uint64 startTime,
            uint64 (*timefunc)()) logical_const;
@@ -48,13 +112,63 @@ public:
     uint32
     getCpuUsagePerc() logical_const;
 
+    // Averages over the last second, in milliseconds
+    real64
+    getUpdateTimeMS() logical_const;
+
+    real64
+    getRenderTimeMS() logical_const;
+
+    uint32
+    getHitchCount() logical_const;
+
+    MetricSummary
+    getSummary(const FrameMetric metric) logical_const;
+
+private:
+
+    struct Histogram
+    {
+        std::vector<uint32> h_buckets;
+        uint32              h_bucketWidth;
+        uint32              h_samples;
+        uint32              h_max;
+        ullong64            h_sum;
+    };
+
 private:
 
-    uint32 m_fpsCounter;
-    uint32 m_memUsage;
-    uint32 m_cpuUsage;
-    uint32 m_numProcessors;
-    uint32 m_frames;    
-    uint64 m_startTime;
+    void
+    sampleProcess();
+
+private:
+
+    static const uint32 MAX_RECORDED_HITCHES = 256U;
+
+private:
 
-};
\ No newline at end of file
+    uint32             m_fpsCounter;
+    uint32             m_memUsage;
+    uint32             m_peakMemUsage;
+    uint32             m_cpuUsage;
+    uint32             m_numProcessors;
+    uint32             m_frames;
+    uint64             m_startTime;
+
+    Histogram          m_histograms[METRIC_COUNT];
+    std::vector<Hitch> m_hitches;
+    std::string        m_reportPath;
+    uint32             m_hitchMicros;
+    uint32             m_hitchCount;
+    uint32             m_frameIndex;
+    ullong64           m_sessionStart;
+    ullong64           m_frameStart;
+    ullong64           m_frameAllocStart;
+    ullong64           m_updateMicros;
+    ullong64           m_renderMicros;
+    ullong64           m_secondUpdateMicros;
+    ullong64           m_secondRenderMicros;
+    real64             m_avgUpdateMS;
+    real64             m_avgRenderMS;
+
+};
@@ -0,0 +1,138 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        clusterbench.cpp
+
+   File description: Command line benchmark of the
+   clustered light assignment. Random point lights
+   are scattered in front of a camera and assigned
+   repeatedly, without a device or a window. It
+   needs the DirectX SDK for the math types only,
+   i.e. from a developer command prompt:
+
+   cl /O2 /EHsc tools/clusterbench.cpp
+      rendering/lightcluster.cpp
+
+   Usage (counts default to a sweep up to 4096):
+   clusterbench [lights] [iterations] [seed]
+   ------------------------------------------------ */
+
+#include "../rendering/lightcluster.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+/* ---------
+   Constants
+   --------- */
+#define BENCH_VIEWPORT_WIDTH     1280.0f
+#define BENCH_VIEWPORT_HEIGHT    720.0f
+#define BENCH_FOV_DEGREES        45.0f
+#define BENCH_ZNEAR              0.1f
+#define BENCH_ZFAR               200.0f
+#define BENCH_SCENE_EXTENT       100.0f
+#define BENCH_MIN_RANGE          2.0f
+#define BENCH_MAX_RANGE          12.0f
+#define BENCH_DEFAULT_ITERATIONS 200
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static void
+generateLights(const uint32                            nLights,
+               const uint32                            seed,
+               std::vector<lightcluster::ClusterLight>& outLights);
+
+static void
+runBenchmark(const uint32 nLights,
+             const uint32 nIterations,
+             const uint32 seed);
+
+/* -----------
+   Entry Point
+   ----------- */
+int
+main(int argc, char** argv)
+{
+    const uint32 nIterations = argc > 2 ? static_cast<uint32>(atoi(argv[2])) : BENCH_DEFAULT_ITERATIONS;
+    const uint32 seed        = argc > 3 ? static_cast<uint32>(atoi(argv[3])) : 1U;
+
+    printf("%8s %12s %12s %12s\n", "lights", "assigned", "dropped", "micros");
+    if (argc > 1)
+    {
+        runBenchmark(static_cast<uint32>(atoi(argv[1])), nIterations, seed);
+        return 0;
+    }
+
+    for (uint32 nLights = 64U;
+                nLights <= 4096U;
+                nLights *= 4U)
+    {
+        runBenchmark(nLights, nIterations, seed);
+    }
+    return 0;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static void
+generateLights(const uint32                            nLights,
+               const uint32                            seed,
+               std::vector<lightcluster::ClusterLight>& outLights)
+{
+    // Lights spread over a square map seen from above, as in game
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<real32> position(-BENCH_SCENE_EXTENT, BENCH_SCENE_EXTENT);
+    std::uniform_real_distribution<real32> range(BENCH_MIN_RANGE, BENCH_MAX_RANGE);
+
+    outLights.resize(nLights);
+    for (uint32 i = 0;
+                i < nLights;
+              ++i)
+    {
+        lightcluster::ClusterLight& light = outLights[i];
+        light.cl_ambientColor = vec4f(0.1f, 0.1f, 0.1f, 1.0f);
+        light.cl_diffuseColor = vec4f(1.0f, 1.0f, 1.0f, 1.0f);
+        light.cl_position     = vec3f(position(rng), 1.0f, position(rng));
+        light.cl_range        = range(rng);
+    }
+}
+
+static void
+runBenchmark(const uint32 nLights,
+             const uint32 nIterations,
+             const uint32 seed)
+{
+    std::vector<lightcluster::ClusterLight> lights;
+    generateLights(nLights, seed, lights);
+
+    const vec3f eye(0.0f, 60.0f, -80.0f);
+    const vec3f target(0.0f, 0.0f, 0.0f);
+    const vec3f up(0.0f, 1.0f, 0.0f);
+
+    mat4x4 viewMatrix, projMatrix;
+    D3DXMatrixLookAtLH(&viewMatrix, &eye, &target, &up);
+    D3DXMatrixPerspectiveFovLH(&projMatrix,
+                               math::toRadians(BENCH_FOV_DEGREES),
+                               BENCH_VIEWPORT_WIDTH / BENCH_VIEWPORT_HEIGHT,
+                               BENCH_ZNEAR,
+                               BENCH_ZFAR);
+
+    const lightcluster::ClusterParams params = lightcluster::makeParams(BENCH_VIEWPORT_WIDTH,
+                                                                        BENCH_VIEWPORT_HEIGHT,
+                                                                        BENCH_ZNEAR,
+                                                                        BENCH_ZFAR);
+
+    const lightcluster::BenchmarkResult result = lightcluster::benchmark(params,
+                                                                         viewMatrix,
+                                                                         projMatrix,
+                                                                         lights,
+                                                                         nIterations);
+
+    printf("%8u %12u %12u %12.1f\n",
+           result.br_nLights,
+           result.br_nAssignments,
+           result.br_nDroppedAssignments,
+           result.br_assignMicros);
+}
@@ -0,0 +1,310 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        instancingtest.cpp
+
+   File description: Command line test of the
+   instance grouping. Group keys are checked to
+   ignore depth but not state or level of detail,
+   and buildGroups to split on keys, bound objects
+   and the group size, packing the instances in
+   input order. Queues sorted by renderqueue are
+   checked to group every draw state once, in key
+   order. It needs the DirectX SDK for the math
+   types only, i.e. from a developer command prompt:
+
+   cl /O2 /EHsc tools/instancingtest.cpp
+      rendering/instancing.cpp
+      rendering/renderqueue.cpp d3dx10.lib
+
+   Usage (exits with 1 if any check fails):
+   instancingtest
+   ------------------------------------------------ */
+
+#include "../rendering/instancing.h"
+#include "../rendering/renderqueue.h"
+#include "../util/strings.h"
+#include <cstdio>
+#include <vector>
+
+/* ---------
+   Constants
+   --------- */
+#define IT_SORT_STATES     5
+#define IT_SORT_DRAWS      60
+#define IT_MAX_GROUP_SIZE  4
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static instancing::InstanceInput
+makeInput(const ullong64 groupKey,
+          const void*    mesh,
+          const void*    texture,
+          const uint32   itemIndex);
+
+static void
+check(const bool condition,
+      cstring    caseName,
+      cstring    description);
+
+static bool
+instancesInInputOrder(const std::vector<instancing::InstanceInput>& inputs,
+                      const std::vector<instancing::InstanceData>&  instances);
+
+static void
+testGroupKeys();
+
+static void
+testEmptyInputs();
+
+static void
+testStateSplits();
+
+static void
+testGroupSizeSplits();
+
+static void
+testSortedQueue();
+
+/* -------------
+   Internal Vars
+   ------------- */
+static uint32 s_nChecks   = 0U;
+static uint32 s_nFailures = 0U;
+
+// Only their addresses are compared, standing in for
+// the mesh, texture and shader objects. Not const, so
+// that the linker cannot fold them into one address
+static int s_meshA    = 0;
+static int s_meshB    = 0;
+static int s_textureA = 0;
+static int s_textureB = 0;
+static int s_shader   = 0;
+
+/* -----------
+   Entry Point
+   ----------- */
+int
+main()
+{
+    testGroupKeys();
+    testEmptyInputs();
+    testStateSplits();
+    testGroupSizeSplits();
+    testSortedQueue();
+
+    printf("%s: %u of %u checks failed\n", s_nFailures ? "FAILED" : "OK", s_nFailures, s_nChecks);
+    return s_nFailures ? 1 : 0;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+// The instance's highlight carries its item index, so
+// that the packed order can be traced back to the inputs
+static instancing::InstanceInput
+makeInput(const ullong64 groupKey,
+          const void*    mesh,
+          const void*    texture,
+          const uint32   itemIndex)
+{
+    instancing::InstanceInput input = {};
+    input.ii_groupKey           = groupKey;
+    input.ii_mesh               = mesh;
+    input.ii_texture            = texture;
+    input.ii_shader             = &s_shader;
+    input.ii_itemIndex          = itemIndex;
+    input.ii_data.id_highlight  = static_cast<int32>(itemIndex);
+    return input;
+}
+
+static void
+check(const bool condition,
+      cstring    caseName,
+      cstring    description)
+{
+    ++s_nChecks;
+    if (condition) return;
+
+    ++s_nFailures;
+    printf("  FAILED %s: %s\n", caseName, description);
+}
+
+static bool
+instancesInInputOrder(const std::vector<instancing::InstanceInput>& inputs,
+                      const std::vector<instancing::InstanceData>&  instances)
+{
+    if (instances.size() != inputs.size()) return false;
+
+    for (size_t i = 0;
+                i < inputs.size();
+              ++i)
+    {
+        if (instances[i].id_highlight != inputs[i].ii_data.id_highlight) return false;
+    }
+    return true;
+}
+
+static void
+testGroupKeys()
+{
+    using namespace renderqueue;
+
+    const ullong64 nearKey  = makeKey(PASS_OPAQUE, 3U, 7U, 11U, 0U);
+    const ullong64 farKey   = makeKey(PASS_OPAQUE, 3U, 7U, 11U, (1U << KEY_DEPTH_BITS) - 1U);
+    const ullong64 meshKey  = makeKey(PASS_OPAQUE, 3U, 7U, 12U, 0U);
+    const ullong64 texKey   = makeKey(PASS_OPAQUE, 3U, 8U, 11U, 0U);
+    const ullong64 passKey  = makeKey(PASS_BILLBOARD, 3U, 7U, 11U, 0U);
+
+    check(instancing::makeGroupKey(nearKey, 0U) == instancing::makeGroupKey(farKey, 0U),
+          "group keys", "draws differing only in depth have different keys");
+    check(instancing::makeGroupKey(nearKey, 0U) != instancing::makeGroupKey(meshKey, 0U),
+          "group keys", "draws of different meshes share a key");
+    check(instancing::makeGroupKey(nearKey, 0U) != instancing::makeGroupKey(texKey, 0U),
+          "group keys", "draws of different textures share a key");
+    check(instancing::makeGroupKey(nearKey, 0U) != instancing::makeGroupKey(passKey, 0U),
+          "group keys", "draws of different passes share a key");
+    check(instancing::makeGroupKey(nearKey, 0U) != instancing::makeGroupKey(nearKey, 1U),
+          "group keys", "draws of different levels of detail share a key");
+
+    // The level of detail sits below the state, so group keys
+    // keep the order of the sort keys they were built from
+    check(instancing::makeGroupKey(nearKey, 3U) < instancing::makeGroupKey(meshKey, 0U),
+          "group keys", "the level of detail reorders draws of different state");
+}
+
+static void
+testEmptyInputs()
+{
+    std::vector<instancing::InstanceInput> inputs;
+    std::vector<instancing::InstanceData>  instances(3);
+    std::vector<instancing::InstanceGroup> groups(3);
+
+    instancing::buildGroups(inputs, IT_MAX_GROUP_SIZE, instances, groups);
+    check(instances.empty() && groups.empty(), "empty inputs", "outputs were not cleared");
+
+    inputs.push_back(makeInput(1ULL, &s_meshA, &s_textureA, 0U));
+    instancing::buildGroups(inputs, 0U, instances, groups);
+    check(instances.empty() && groups.empty(), "empty inputs", "a zero group size produced groups");
+}
+
+// Equal keys with different bound objects (a sort ID
+// collision) must not share a draw call
+static void
+testStateSplits()
+{
+    std::vector<instancing::InstanceInput> inputs;
+    inputs.push_back(makeInput(1ULL, &s_meshA, &s_textureA, 0U));
+    inputs.push_back(makeInput(1ULL, &s_meshA, &s_textureA, 1U));
+    inputs.push_back(makeInput(1ULL, &s_meshB, &s_textureA, 2U));
+    inputs.push_back(makeInput(1ULL, &s_meshB, &s_textureB, 3U));
+    inputs.push_back(makeInput(2ULL, &s_meshB, &s_textureB, 4U));
+    inputs.push_back(makeInput(2ULL, &s_meshB, &s_textureB, 5U));
+
+    std::vector<instancing::InstanceData>  instances;
+    std::vector<instancing::InstanceGroup> groups;
+    instancing::buildGroups(inputs, IT_MAX_GROUP_SIZE, instances, groups);
+
+    check(instancesInInputOrder(inputs, instances), "state splits", "instances are not in input order");
+    check(groups.size() == 4U, "state splits", "wrong number of groups");
+    if (groups.size() != 4U) return;
+
+    const uint32 expectedItems[4]  = { 0U, 2U, 3U, 4U };
+    const uint32 expectedFirsts[4] = { 0U, 2U, 3U, 4U };
+    const uint32 expectedCounts[4] = { 2U, 1U, 1U, 2U };
+    for (size_t i = 0;
+                i < groups.size();
+              ++i)
+    {
+        check(groups[i].ig_itemIndex     == expectedItems[i],  "state splits", "wrong group item index");
+        check(groups[i].ig_firstInstance == expectedFirsts[i], "state splits", "wrong group first instance");
+        check(groups[i].ig_nInstances    == expectedCounts[i], "state splits", "wrong group instance count");
+    }
+}
+
+static void
+testGroupSizeSplits()
+{
+    std::vector<instancing::InstanceInput> inputs;
+    for (uint32 i = 0;
+                i < 2U * IT_MAX_GROUP_SIZE + 1U;
+              ++i)
+    {
+        inputs.push_back(makeInput(1ULL, &s_meshA, &s_textureA, i));
+    }
+
+    std::vector<instancing::InstanceData>  instances;
+    std::vector<instancing::InstanceGroup> groups;
+    instancing::buildGroups(inputs, IT_MAX_GROUP_SIZE, instances, groups);
+
+    check(instancesInInputOrder(inputs, instances), "group size", "instances are not in input order");
+    check(groups.size() == 3U, "group size", "wrong number of groups");
+    if (groups.size() != 3U) return;
+
+    for (uint32 i = 0;
+                i < groups.size();
+              ++i)
+    {
+        const uint32 expectedCount = i < 2U ? IT_MAX_GROUP_SIZE : 1U;
+        check(groups[i].ig_firstInstance == i * IT_MAX_GROUP_SIZE, "group size", "wrong group first instance");
+        check(groups[i].ig_itemIndex     == i * IT_MAX_GROUP_SIZE, "group size", "wrong group item index");
+        check(groups[i].ig_nInstances    == expectedCount,         "group size", "wrong group instance count");
+    }
+}
+
+// Draws of a few states at scattered depths, interleaved as a
+// scene would submit them, then sorted the way the renderer does
+static void
+testSortedQueue()
+{
+    std::vector<renderqueue::DrawItem> items;
+    for (uint32 i = 0;
+                i < IT_SORT_DRAWS;
+              ++i)
+    {
+        const uint32 state = (i * 7U) % IT_SORT_STATES;
+        const uint32 depth = (i * 2654435761U) >> (32U - renderqueue::KEY_DEPTH_BITS);
+
+        renderqueue::DrawItem item = {};
+        item.di_key   = renderqueue::makeKey(renderqueue::PASS_OPAQUE, 0U, state, state, depth);
+        item.di_index = i;
+        items.push_back(item);
+    }
+
+    std::vector<renderqueue::DrawItem> scratch;
+    renderqueue::sortItems(items, scratch);
+
+    std::vector<instancing::InstanceInput> inputs;
+    for (size_t i = 0;
+                i < items.size();
+              ++i)
+    {
+        inputs.push_back(makeInput(instancing::makeGroupKey(items[i].di_key, 0U),
+                                   &s_meshA,
+                                   &s_textureA,
+                                   items[i].di_index));
+    }
+
+    std::vector<instancing::InstanceData>  instances;
+    std::vector<instancing::InstanceGroup> groups;
+    instancing::buildGroups(inputs, IT_SORT_DRAWS, instances, groups);
+
+    check(instancesInInputOrder(inputs, instances), "sorted queue", "instances are not in input order");
+    check(groups.size() == IT_SORT_STATES, "sorted queue", "a draw state was split across groups");
+
+    uint32   nInstances = 0U;
+    ullong64 lastKey    = 0ULL;
+    for (size_t i = 0;
+                i < groups.size();
+              ++i)
+    {
+        const instancing::InstanceInput& first = inputs[groups[i].ig_firstInstance];
+        check(first.ii_itemIndex == groups[i].ig_itemIndex, "sorted queue", "wrong group item index");
+        check(i == 0 || first.ii_groupKey > lastKey, "sorted queue", "groups are not in key order");
+
+        lastKey     = first.ii_groupKey;
+        nInstances += groups[i].ig_nInstances;
+    }
+    check(nInstances == IT_SORT_DRAWS, "sorted queue", "groups do not cover every draw");
+}
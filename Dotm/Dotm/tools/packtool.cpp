@@ -0,0 +1,193 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        packtool.cpp
+
+   File description: Command line tool building,
+   verifying and listing asset packs. It only
+   depends on the standard library, so it builds
+   on the asset build machines as well, i.e.:
+
+   g++ -std=c++11 -O2 -o packtool tools/packtool.cpp
+       util/packformat.cpp util/lz4.cpp
+
+   Usage (run from the directory holding assets/):
+   packtool build  <pack> [-nocompress] <file|@list>...
+   packtool verify <pack> [-sources]
+   packtool list   <pack>
+   ------------------------------------------------ */
+
+#include "../util/packformat.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static int
+printUsage();
+
+static bool
+appendListFile(const std::string&        listPath,
+               std::vector<std::string>& outPaths);
+
+static void
+printReport(const packformat::PackReport& report);
+
+static int
+build(int argc, char** argv);
+
+static int
+verify(int argc, char** argv);
+
+static int
+list(int argc, char** argv);
+
+/* -----------
+   Entry Point
+   ----------- */
+int
+main(int argc, char** argv)
+{
+    if (argc < 3) return printUsage();
+
+    if (strcmp(argv[1], "build")  == 0) return build(argc, argv);
+    if (strcmp(argv[1], "verify") == 0) return verify(argc, argv);
+    if (strcmp(argv[1], "list")   == 0) return list(argc, argv);
+
+    return printUsage();
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static int
+printUsage()
+{
+    fprintf(stderr,
+            "usage: packtool build  <pack> [-nocompress] <file|@list>...\n"
+            "       packtool verify <pack> [-sources]\n"
+            "       packtool list   <pack>\n"
+            "Entries are named after the given paths, which must be relative\n"
+            "to the game's working directory (i.e. assets/models/x.obj).\n");
+    return 2;
+}
+
+static bool
+appendListFile(const std::string&        listPath,
+               std::vector<std::string>& outPaths)
+{
+    std::ifstream file(listPath);
+    if (!file.is_open()) return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+        if (!line.empty()) outPaths.push_back(line);
+    }
+
+    return true;
+}
+
+static void
+printReport(const packformat::PackReport& report)
+{
+    for (auto citer = report.pr_entries.cbegin();
+              citer != report.pr_entries.cend();
+            ++citer)
+    {
+        printf("%-48s %10u %10u %s%s\n",
+               citer->er_name.c_str(),
+               citer->er_originalSize,
+               citer->er_storedSize,
+               citer->er_compressed ? "lz4" : "raw",
+               citer->er_valid ? "" : "  INVALID");
+    }
+
+    printf("%u entries, %llu bytes stored for %llu bytes of assets\n",
+           static_cast<uint32>(report.pr_entries.size()),
+           report.pr_totalStoredBytes,
+           report.pr_totalOriginalBytes);
+}
+
+static int
+build(int argc, char** argv)
+{
+    bool                     compress = true;
+    std::vector<std::string> filePaths;
+
+    for (int i = 3;
+             i < argc;
+           ++i)
+    {
+        if (strcmp(argv[i], "-nocompress") == 0)
+        {
+            compress = false;
+        }
+        else if (argv[i][0] == '@')
+        {
+            if (!appendListFile(argv[i] + 1, filePaths))
+            {
+                fprintf(stderr, "Could not read list file %s\n", argv[i] + 1);
+                return 1;
+            }
+        }
+        else
+        {
+            filePaths.push_back(argv[i]);
+        }
+    }
+
+    packformat::PackReport report;
+    if (!packformat::buildPack(argv[2], filePaths, compress, report))
+    {
+        fprintf(stderr, "Build failed: %s\n", report.pr_error.c_str());
+        return 1;
+    }
+
+    printReport(report);
+    return 0;
+}
+
+static int
+verify(int argc, char** argv)
+{
+    const bool compareSources = argc > 3 && strcmp(argv[3], "-sources") == 0;
+
+    packformat::PackReport report;
+    const bool valid = packformat::verifyPack(argv[2], compareSources, report);
+
+    if (!report.pr_error.empty())
+    {
+        fprintf(stderr, "Verification failed: %s\n", report.pr_error.c_str());
+        return 1;
+    }
+
+    printReport(report);
+    printf("%s: %u invalid entries\n", valid ? "OK" : "FAILED", report.pr_nInvalid);
+    return valid ? 0 : 1;
+}
+
+static int
+list(int argc, char** argv)
+{
+    (void) argc;
+
+    // Listing still walks the whole pack, but does not fail on
+    // invalid entries; they are only flagged
+    packformat::PackReport report;
+    packformat::verifyPack(argv[2], false, report);
+
+    if (!report.pr_error.empty())
+    {
+        fprintf(stderr, "Could not read pack: %s\n", report.pr_error.c_str());
+        return 1;
+    }
+
+    printReport(report);
+    return 0;
+}
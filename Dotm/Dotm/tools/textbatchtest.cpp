@@ -0,0 +1,274 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        textbatchtest.cpp
+
+   File description: Command line test of the text
+   batching. Glyph quads are checked for their
+   screen positions, atlas texture coordinates and
+   pen advance, including spaces and characters
+   missing from the glyph table, the quad indices
+   for their winding and range, and the batches for
+   flushing exactly at their capacity. It needs the
+   DirectX SDK for the math types only, i.e. from a
+   developer command prompt:
+
+   cl /O2 /EHsc tools/textbatchtest.cpp
+      rendering/textbatch.cpp d3dx10.lib
+
+   Usage (exits with 1 if any check fails):
+   textbatchtest
+   ------------------------------------------------ */
+
+#include "../rendering/textbatch.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/* ---------
+   Constants
+   --------- */
+#define TBT_EPSILON      1e-6f
+#define TBT_PEN_X        0.1f
+#define TBT_PEN_Y        0.2f
+#define TBT_SIZE         0.1f
+#define TBT_ASPECT       2.0f
+#define TBT_ADVANCE      (TBT_SIZE / 1.5f)
+#define TBT_SMALL_BATCH  4U
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static void
+check(const bool condition,
+      cstring    caseName,
+      cstring    description);
+
+static bool
+nearlyEqual(const real32 a,
+            const real32 b);
+
+static void
+setGlyph(textbatch::GlyphTable& table,
+         const uint8            chr,
+         const real32           minU,
+         const real32           minV);
+
+static bool
+isGlyphQuad(const textbatch::GlyphVertex* quad,
+            const textbatch::GlyphRect&   rect,
+            const real32                  centerX);
+
+static void
+testGlyphQuads();
+
+static void
+testSkippedCharacters();
+
+static void
+testQuadIndices();
+
+static void
+testBatchCapacity();
+
+/* -------------
+   Internal Vars
+   ------------- */
+static uint32                s_nChecks   = 0U;
+static uint32                s_nFailures = 0U;
+static textbatch::GlyphTable s_table     = {};
+
+/* -----------
+   Entry Point
+   ----------- */
+int
+main()
+{
+    setGlyph(s_table, 'A', 0.0f,  0.0f);
+    setGlyph(s_table, 'B', 0.25f, 0.0f);
+    setGlyph(s_table, 0xC8, 0.5f, 0.5f);
+
+    testGlyphQuads();
+    testSkippedCharacters();
+    testQuadIndices();
+    testBatchCapacity();
+
+    printf("%s: %u of %u checks failed\n", s_nFailures ? "FAILED" : "OK", s_nFailures, s_nChecks);
+    return s_nFailures ? 1 : 0;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static void
+check(const bool condition,
+      cstring    caseName,
+      cstring    description)
+{
+    ++s_nChecks;
+    if (condition) return;
+
+    ++s_nFailures;
+    printf("  FAILED %s: %s\n", caseName, description);
+}
+
+static bool
+nearlyEqual(const real32 a,
+            const real32 b)
+{
+    return std::fabs(a - b) <= TBT_EPSILON;
+}
+
+// Glyphs a quarter of the atlas wide and high
+static void
+setGlyph(textbatch::GlyphTable& table,
+         const uint8            chr,
+         const real32           minU,
+         const real32           minV)
+{
+    textbatch::GlyphRect& rect = table.gt_glyphs[chr];
+    rect.gr_minTexCoord = vec2f(minU, minV);
+    rect.gr_maxTexCoord = vec2f(minU + 0.25f, minV + 0.25f);
+    rect.gr_valid       = true;
+}
+
+// The four vertices, top left first and clockwise, of a glyph
+// centered at (centerX, TBT_PEN_Y) facing the screen
+static bool
+isGlyphQuad(const textbatch::GlyphVertex* quad,
+            const textbatch::GlyphRect&   rect,
+            const real32                  centerX)
+{
+    const real32 halfWidth  = 0.5f * TBT_SIZE / TBT_ASPECT;
+    const real32 halfHeight = 0.5f * TBT_SIZE;
+
+    const real32 expectedX[4] = { centerX - halfWidth, centerX + halfWidth, centerX + halfWidth, centerX - halfWidth };
+    const real32 expectedY[4] = { TBT_PEN_Y + halfHeight, TBT_PEN_Y + halfHeight,
+                                  TBT_PEN_Y - halfHeight, TBT_PEN_Y - halfHeight };
+    const real32 expectedU[4] = { rect.gr_minTexCoord.x, rect.gr_maxTexCoord.x,
+                                  rect.gr_maxTexCoord.x, rect.gr_minTexCoord.x };
+    const real32 expectedV[4] = { rect.gr_minTexCoord.y, rect.gr_minTexCoord.y,
+                                  rect.gr_maxTexCoord.y, rect.gr_maxTexCoord.y };
+
+    for (size_t i = 0;
+                i < 4;
+              ++i)
+    {
+        const textbatch::GlyphVertex& vertex = quad[i];
+        if (!nearlyEqual(vertex.gv_x,  expectedX[i]) ||
+            !nearlyEqual(vertex.gv_y,  expectedY[i]) ||
+            !nearlyEqual(vertex.gv_z,  0.0f)         ||
+            !nearlyEqual(vertex.gv_tu, expectedU[i]) ||
+            !nearlyEqual(vertex.gv_tv, expectedV[i]) ||
+            !nearlyEqual(vertex.gv_nx, 0.0f)         ||
+            !nearlyEqual(vertex.gv_ny, 0.0f)         ||
+            !nearlyEqual(vertex.gv_nz, 1.0f)) return false;
+    }
+    return true;
+}
+
+static void
+testGlyphQuads()
+{
+    std::vector<textbatch::GlyphVertex> vertices;
+    uint32 nQuads = textbatch::appendString(s_table, "AB", TBT_PEN_X, TBT_PEN_Y, TBT_SIZE, TBT_ASPECT, vertices);
+
+    check(nQuads == 2U && vertices.size() == 8U, "glyph quads", "wrong number of quads");
+    if (vertices.size() != 8U) return;
+
+    check(isGlyphQuad(&vertices[0], s_table.gt_glyphs['A'], TBT_PEN_X),
+          "glyph quads", "wrong first glyph quad");
+    check(isGlyphQuad(&vertices[4], s_table.gt_glyphs['B'], TBT_PEN_X + TBT_ADVANCE),
+          "glyph quads", "wrong second glyph quad");
+
+    // Strings append to the frame's queue rather than replace it
+    nQuads = textbatch::appendString(s_table, "\xC8", TBT_PEN_X, TBT_PEN_Y, TBT_SIZE, TBT_ASPECT, vertices);
+    check(nQuads == 1U && vertices.size() == 12U, "glyph quads", "a second string did not append");
+    if (vertices.size() != 12U) return;
+
+    check(isGlyphQuad(&vertices[8], s_table.gt_glyphs[0xC8], TBT_PEN_X),
+          "glyph quads", "wrong quad for a character above 127");
+}
+
+static void
+testSkippedCharacters()
+{
+    std::vector<textbatch::GlyphVertex> vertices;
+    uint32 nQuads = textbatch::appendString(s_table, "A B?A", TBT_PEN_X, TBT_PEN_Y, TBT_SIZE, TBT_ASPECT, vertices);
+
+    check(nQuads == 3U && vertices.size() == 12U, "skipped characters", "wrong number of quads");
+    if (vertices.size() != 12U) return;
+
+    check(isGlyphQuad(&vertices[4], s_table.gt_glyphs['B'], TBT_PEN_X + 2.0f * TBT_ADVANCE),
+          "skipped characters", "a space did not advance the pen");
+    check(isGlyphQuad(&vertices[8], s_table.gt_glyphs['A'], TBT_PEN_X + 4.0f * TBT_ADVANCE),
+          "skipped characters", "a missing glyph did not advance the pen");
+
+    vertices.clear();
+    nQuads = textbatch::appendString(s_table, nullptr, TBT_PEN_X, TBT_PEN_Y, TBT_SIZE, TBT_ASPECT, vertices);
+    check(nQuads == 0U && vertices.empty(), "skipped characters", "a null string emitted quads");
+}
+
+static void
+testQuadIndices()
+{
+    std::vector<uint16> indices(1, 0xFFFF);
+    textbatch::buildQuadIndices(3U, indices);
+    check(indices.size() == 18U, "quad indices", "wrong number of indices");
+    if (indices.size() != 18U) return;
+
+    // Top left, top right, bottom right then bottom right,
+    // bottom left, top left: clockwise on screen
+    static const uint16 s_quadPattern[6] = { 0U, 1U, 2U, 2U, 3U, 0U };
+    bool patternOK = true;
+    for (uint32 i = 0;
+                i < indices.size();
+              ++i)
+    {
+        patternOK &= indices[i] == (i / 6U) * 4U + s_quadPattern[i % 6U];
+    }
+    check(patternOK, "quad indices", "wrong index pattern");
+
+    // A full batch must fit 16 bit indices exactly
+    textbatch::buildQuadIndices(textbatch::MAX_BATCH_GLYPHS, indices);
+    check(indices.size() == textbatch::MAX_BATCH_GLYPHS * 6U, "quad indices", "wrong full batch index count");
+    check(!indices.empty() && indices[indices.size() - 2U] == textbatch::MAX_BATCH_GLYPHS * 4U - 1U,
+          "quad indices", "a full batch does not reach the last 16 bit index");
+}
+
+static void
+testBatchCapacity()
+{
+    std::vector<textbatch::TextBatch> batches(1);
+
+    textbatch::buildBatches(0U, TBT_SMALL_BATCH, batches);
+    check(batches.empty(), "batch capacity", "no glyphs produced batches");
+
+    textbatch::buildBatches(TBT_SMALL_BATCH, 0U, batches);
+    check(batches.empty(), "batch capacity", "a zero capacity produced batches");
+
+    textbatch::buildBatches(TBT_SMALL_BATCH, TBT_SMALL_BATCH, batches);
+    check(batches.size() == 1U, "batch capacity", "a full batch was flushed early");
+
+    textbatch::buildBatches(TBT_SMALL_BATCH + 1U, TBT_SMALL_BATCH, batches);
+    check(batches.size() == 2U && batches[1].tb_nGlyphs == 1U,
+          "batch capacity", "one glyph past capacity did not start a batch");
+
+    // Batches cover the queue in order without gaps
+    const uint32 nGlyphs = 2U * textbatch::MAX_BATCH_GLYPHS + textbatch::MAX_BATCH_GLYPHS / 2U;
+    textbatch::buildBatches(nGlyphs, textbatch::MAX_BATCH_GLYPHS, batches);
+    check(batches.size() == 3U, "batch capacity", "wrong number of batches");
+
+    uint32 nextGlyph = 0U;
+    bool   batchesOK = true;
+    for (size_t i = 0;
+                i < batches.size();
+              ++i)
+    {
+        batchesOK &= batches[i].tb_firstGlyph == nextGlyph;
+        batchesOK &= batches[i].tb_nGlyphs > 0U && batches[i].tb_nGlyphs <= textbatch::MAX_BATCH_GLYPHS;
+        batchesOK &= i + 1U == batches.size() || batches[i].tb_nGlyphs == textbatch::MAX_BATCH_GLYPHS;
+        nextGlyph  = batches[i].tb_firstGlyph + batches[i].tb_nGlyphs;
+    }
+    check(batchesOK && nextGlyph == nGlyphs, "batch capacity", "batches do not cover the queue in order");
+}
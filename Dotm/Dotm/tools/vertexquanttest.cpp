@@ -0,0 +1,404 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        vertexquanttest.cpp
+
+   File description: Command line test of the
+   compact vertex encoding. Positions, normals and
+   texture coordinates at the edges of their ranges
+   are round tripped through vertexquant and their
+   errors checked against the bounds documented in
+   vertexquant.h, independently of measureError. It
+   needs the DirectX SDK for the math types only,
+   i.e. from a developer command prompt:
+
+   cl /O2 /EHsc tools/vertexquanttest.cpp
+      rendering/vertexquant.cpp d3dx10.lib
+
+   Usage (exits with 1 if any check fails):
+   vertexquanttest
+   ------------------------------------------------ */
+
+#include "../rendering/vertexquant.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/* ---------
+   Constants
+   --------- */
+#define VQT_UNORM16_MAX          65535.0f
+#define VQT_HALF_RELATIVE_ERROR  (1.0f / 2048.0f)
+#define VQT_HALF_ABSOLUTE_ERROR  (1.0f / 33554432.0f)
+#define VQT_HALF_MAX             65504.0f
+#define VQT_MAX_NORMAL_ERROR_DEG 0.01f
+#define VQT_SWEEP_STEPS          720
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static Mesh::Vertex
+makeVertex(const vec3f& position,
+           const vec2f& texcoord,
+           const vec3f& normal);
+
+static void
+check(const bool condition,
+      cstring    caseName,
+      cstring    description);
+
+static void
+runCase(cstring                          caseName,
+        const std::vector<Mesh::Vertex>& vertices);
+
+static void
+testPositions();
+
+static void
+testNormals();
+
+static void
+testTexcoords();
+
+static void
+testHalfConversions();
+
+static void
+testErrorDetection();
+
+/* -------------
+   Internal Vars
+   ------------- */
+static uint32 s_nChecks   = 0U;
+static uint32 s_nFailures = 0U;
+
+/* -----------
+   Entry Point
+   ----------- */
+int
+main()
+{
+    testPositions();
+    testNormals();
+    testTexcoords();
+    testHalfConversions();
+    testErrorDetection();
+
+    printf("%s: %u of %u checks failed\n", s_nFailures ? "FAILED" : "OK", s_nFailures, s_nChecks);
+    return s_nFailures ? 1 : 0;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static Mesh::Vertex
+makeVertex(const vec3f& position,
+           const vec2f& texcoord,
+           const vec3f& normal)
+{
+    Mesh::Vertex vertex = {};
+    vertex.v_x  = position.x;
+    vertex.v_y  = position.y;
+    vertex.v_z  = position.z;
+    vertex.v_tu = texcoord.x;
+    vertex.v_tv = texcoord.y;
+    vertex.v_nx = normal.x;
+    vertex.v_ny = normal.y;
+    vertex.v_nz = normal.z;
+    return vertex;
+}
+
+static void
+check(const bool condition,
+      cstring    caseName,
+      cstring    description)
+{
+    ++s_nChecks;
+    if (condition) return;
+
+    ++s_nFailures;
+    printf("  FAILED %s: %s\n", caseName, description);
+}
+
+// Encodes the vertices with the grid spanning their bounds,
+// then checks every decoded attribute against its documented
+// bound, as well as measureError's verdict
+static void
+runCase(cstring                          caseName,
+        const std::vector<Mesh::Vertex>& vertices)
+{
+    const vertexquant::QuantParams params = vertexquant::calculateParams(&vertices[0], vertices.size());
+
+    std::vector<vertexquant::CompactVertex> compact;
+    vertexquant::encode(&vertices[0], vertices.size(), params, compact);
+
+    std::vector<Mesh::Vertex> decoded;
+    vertexquant::decode(compact, params, decoded);
+
+    const real32 scales[3]  = { params.qp_scale.x,  params.qp_scale.y,  params.qp_scale.z  };
+    const real32 offsets[3] = { params.qp_offset.x, params.qp_offset.y, params.qp_offset.z };
+
+    real32 maxPositionError = 0.0f, maxTexcoordError = 0.0f, maxNormalError = 0.0f;
+    bool   positionsOK      = true, texcoordsOK      = true, normalsOK      = true;
+
+    for (size_t i = 0;
+                i < vertices.size();
+              ++i)
+    {
+        const Mesh::Vertex& original = vertices[i];
+        const Mesh::Vertex& result   = decoded[i];
+
+        // Half a grid step, plus float rounding relative to the
+        // magnitude of the values involved
+        const real32 originalPosition[3] = { original.v_x, original.v_y, original.v_z };
+        const real32 resultPosition[3]   = { result.v_x,   result.v_y,   result.v_z   };
+        for (size_t axis = 0;
+                    axis < 3;
+                  ++axis)
+        {
+            const real32 error = std::fabs(resultPosition[axis] - originalPosition[axis]);
+            const real32 bound = 0.5f * scales[axis] / VQT_UNORM16_MAX +
+                                 4.0f * FLT_EPSILON * (std::fabs(offsets[axis]) + scales[axis]);
+            maxPositionError = error > maxPositionError ? error : maxPositionError;
+            if (error > bound) positionsOK = false;
+        }
+
+        const real32 originalTexcoord[2] = { original.v_tu, original.v_tv };
+        const real32 resultTexcoord[2]   = { result.v_tu,   result.v_tv   };
+        for (size_t axis = 0;
+                    axis < 2;
+                  ++axis)
+        {
+            const real32 error    = std::fabs(resultTexcoord[axis] - originalTexcoord[axis]);
+            const real32 relative = std::fabs(originalTexcoord[axis]) * VQT_HALF_RELATIVE_ERROR;
+            const real32 bound    = relative > VQT_HALF_ABSOLUTE_ERROR ? relative : VQT_HALF_ABSOLUTE_ERROR;
+            maxTexcoordError = error > maxTexcoordError ? error : maxTexcoordError;
+            if (error > bound) texcoordsOK = false;
+        }
+
+        // Even degenerate normals must decode to a unit vector
+        const real64 resultLength = std::sqrt(result.v_nx * result.v_nx +
+                                              result.v_ny * result.v_ny +
+                                              result.v_nz * result.v_nz);
+        if (!(std::fabs(resultLength - 1.0f) < 1e-4f)) normalsOK = false;
+
+        const double originalLength = std::sqrt(static_cast<double>(original.v_nx) * original.v_nx +
+                                                static_cast<double>(original.v_ny) * original.v_ny +
+                                                static_cast<double>(original.v_nz) * original.v_nz);
+        if (originalLength <= 0.0) continue;
+
+        // Measured in doubles, so the test's own rounding stays
+        // far below the bound
+        const double dot = (original.v_nx * static_cast<double>(result.v_nx) +
+                            original.v_ny * static_cast<double>(result.v_ny) +
+                            original.v_nz * static_cast<double>(result.v_nz)) / (originalLength * resultLength);
+        const double cross[3] = { (original.v_ny * static_cast<double>(result.v_nz) - original.v_nz * static_cast<double>(result.v_ny)),
+                                  (original.v_nz * static_cast<double>(result.v_nx) - original.v_nx * static_cast<double>(result.v_nz)),
+                                  (original.v_nx * static_cast<double>(result.v_ny) - original.v_ny * static_cast<double>(result.v_nx)) };
+        const double sine  = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]) /
+                             (originalLength * resultLength);
+        const real32 angle = static_cast<real32>(std::atan2(sine, dot) * 180.0 / 3.14159265358979323846);
+        maxNormalError = angle > maxNormalError ? angle : maxNormalError;
+        if (angle > VQT_MAX_NORMAL_ERROR_DEG) normalsOK = false;
+    }
+
+    const vertexquant::ErrorReport report = vertexquant::measureError(&vertices[0], compact, params);
+
+    printf("%-32s position %.3e  texcoord %.3e  normal %.5f deg\n",
+           caseName, maxPositionError, maxTexcoordError, maxNormalError);
+
+    check(positionsOK, caseName, "position error above half a grid step");
+    check(texcoordsOK, caseName, "texture coordinate error above half a half-float ulp");
+    check(normalsOK,   caseName, "normal error above a hundredth of a degree");
+    check(report.er_withinBounds == (positionsOK && texcoordsOK && normalsOK), caseName, "measureError disagrees");
+}
+
+static void
+testPositions()
+{
+    const vec2f texcoord(0.0f, 0.0f);
+    const vec3f normal(0.0f, 1.0f, 0.0f);
+
+    // The bounds themselves, points just inside them and the
+    // midpoints between grid steps, where rounding is worst
+    std::vector<Mesh::Vertex> unitBox;
+    const real32 step = 2.0f / VQT_UNORM16_MAX;
+    unitBox.push_back(makeVertex(vec3f(-1.0f, -1.0f, -1.0f), texcoord, normal));
+    unitBox.push_back(makeVertex(vec3f( 1.0f,  1.0f,  1.0f), texcoord, normal));
+    unitBox.push_back(makeVertex(vec3f(-1.0f + FLT_EPSILON, 1.0f - FLT_EPSILON, 0.0f), texcoord, normal));
+    for (uint32 k = 0;
+                k < VQT_SWEEP_STEPS;
+              ++k)
+    {
+        const real32 halfway = -1.0f + (k * 91U + 0.5f) * step;
+        unitBox.push_back(makeVertex(vec3f(halfway, -halfway, halfway * 0.5f), texcoord, normal));
+    }
+    runCase("positions, unit box", unitBox);
+
+    // Small extents far from the origin, where the float
+    // rounding of the offset dominates
+    std::vector<Mesh::Vertex> farAway;
+    for (uint32 k = 0;
+                k <= VQT_SWEEP_STEPS;
+              ++k)
+    {
+        const real32 t = static_cast<real32>(k) / VQT_SWEEP_STEPS;
+        farAway.push_back(makeVertex(vec3f(1000.0f + 0.25f * t, -5000.0f - 3.0f * t, 0.001f * t), texcoord, normal));
+    }
+    runCase("positions, far from the origin", farAway);
+
+    // Flat axes span no range at all
+    std::vector<Mesh::Vertex> flat;
+    flat.push_back(makeVertex(vec3f(-2.0f, 3.0f, 7.5f), texcoord, normal));
+    flat.push_back(makeVertex(vec3f( 2.0f, 3.0f, 7.5f), texcoord, normal));
+    flat.push_back(makeVertex(vec3f( 0.5f, 3.0f, 7.5f), texcoord, normal));
+    runCase("positions, flat axes", flat);
+
+    // A single vertex
+    std::vector<Mesh::Vertex> single(1, makeVertex(vec3f(12.0f, -4.0f, 0.0f), texcoord, normal));
+    runCase("positions, single vertex", single);
+}
+
+static void
+testNormals()
+{
+    const vec3f position(0.0f, 0.0f, 0.0f);
+    const vec2f texcoord(0.0f, 0.0f);
+
+    // The octahedron's vertices, edges and faces, and the fold
+    // between the hemispheres from either side
+    const real32 tiny = 1e-6f;
+    const vec3f  edges[] = { vec3f( 1.0f,  0.0f,  0.0f), vec3f(-1.0f,  0.0f,  0.0f),
+                             vec3f( 0.0f,  1.0f,  0.0f), vec3f( 0.0f, -1.0f,  0.0f),
+                             vec3f( 0.0f,  0.0f,  1.0f), vec3f( 0.0f,  0.0f, -1.0f),
+                             vec3f( 1.0f,  1.0f,  0.0f), vec3f(-1.0f,  1.0f,  0.0f),
+                             vec3f( 1.0f,  0.0f,  1.0f), vec3f( 0.0f, -1.0f, -1.0f),
+                             vec3f( 1.0f,  1.0f,  1.0f), vec3f(-1.0f, -1.0f, -1.0f),
+                             vec3f( 1.0f, -1.0f, -1.0f), vec3f(-1.0f,  1.0f, -1.0f),
+                             vec3f( 1.0f,  0.0f, -tiny), vec3f( 1.0f,  0.0f,  tiny),
+                             vec3f( tiny,  tiny, -1.0f), vec3f(-tiny, -tiny, -1.0f),
+                             vec3f( tiny, -1.0f, -tiny), vec3f(-1.0f,  tiny,  tiny),
+                             vec3f( 0.0f,  0.0f,  0.0f) };
+
+    std::vector<Mesh::Vertex> special;
+    for (size_t i = 0;
+                i < sizeof(edges) / sizeof(edges[0]);
+              ++i)
+    {
+        vec3f normal = edges[i];
+        const real32 length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        if (length > 0.0f) normal /= length;
+        special.push_back(makeVertex(position, texcoord, normal));
+    }
+    runCase("normals, octahedron edges", special);
+
+    // A dense sweep of the whole sphere
+    std::vector<Mesh::Vertex> sphere;
+    for (uint32 lat = 0;
+                lat <= VQT_SWEEP_STEPS / 4;
+              ++lat)
+    {
+        for (uint32 lon = 0;
+                    lon < VQT_SWEEP_STEPS;
+                  ++lon)
+        {
+            const real64 theta = 3.14159265f * lat / (VQT_SWEEP_STEPS / 4);
+            const real64 phi   = 2.0f * 3.14159265f * lon / VQT_SWEEP_STEPS;
+            const vec3f  normal(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+            sphere.push_back(makeVertex(position, texcoord, normal));
+        }
+    }
+    runCase("normals, sphere sweep", sphere);
+}
+
+static void
+testTexcoords()
+{
+    const vec3f position(0.0f, 0.0f, 0.0f);
+    const vec3f normal(0.0f, 0.0f, 1.0f);
+
+    // The unit range edges, tiling coordinates, the smallest
+    // normal and subnormal halves, and the largest finite half
+    const real32 values[] = { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 1.0f / 3.0f, 0.9999f, 1.0001f,
+                              -0.0001f, 10.3f, -250.7f, 2048.5f, 6.103515625e-05f, 5.9604645e-08f,
+                              2.9802322e-08f, 1e-9f, VQT_HALF_MAX, -VQT_HALF_MAX };
+
+    std::vector<Mesh::Vertex> special;
+    for (size_t i = 0;
+                i < sizeof(values) / sizeof(values[0]);
+              ++i)
+    {
+        special.push_back(makeVertex(position, vec2f(values[i], -values[i]), normal));
+    }
+    runCase("texcoords, range edges", special);
+
+    std::vector<Mesh::Vertex> sweep;
+    for (uint32 k = 0;
+                k <= VQT_SWEEP_STEPS;
+              ++k)
+    {
+        const real32 t = static_cast<real32>(k) / VQT_SWEEP_STEPS;
+        sweep.push_back(makeVertex(position, vec2f(t, 4.0f * t - 2.0f), normal));
+    }
+    runCase("texcoords, sweep", sweep);
+}
+
+static void
+testHalfConversions()
+{
+    cstring caseName = "half conversions";
+
+    // Every finite half survives a round trip through float exactly
+    bool exact = true;
+    for (uint32 bits = 0;
+                bits <= 0xFFFFU;
+              ++bits)
+    {
+        if ((bits & 0x7C00U) == 0x7C00U) continue;
+        if (vertexquant::floatToHalf(vertexquant::halfToFloat(static_cast<uint16>(bits))) != bits) exact = false;
+    }
+    check(exact, caseName, "finite halves do not round trip exactly");
+
+    check(vertexquant::floatToHalf(VQT_HALF_MAX)                  == 0x7BFFU, caseName, "largest half not exact");
+    check(vertexquant::floatToHalf(65520.0f)                      == 0x7C00U, caseName, "overflow not rounded to infinity");
+    check(vertexquant::floatToHalf(1.0f + 1.0f / 2048.0f)         == 0x3C00U, caseName, "tie not rounded to even");
+    check(vertexquant::floatToHalf(1.0f + 3.0f / 2048.0f)         == 0x3C02U, caseName, "tie not rounded to even");
+    check(vertexquant::floatToHalf(-0.0f)                         == 0x8000U, caseName, "negative zero lost its sign");
+    check(std::isnan(vertexquant::halfToFloat(vertexquant::floatToHalf(std::nanf("")))), caseName, "NaN not preserved");
+
+    printf("%-32s %u finite halves\n", caseName, 0x10000U - 2U * 0x400U);
+}
+
+static void
+testErrorDetection()
+{
+    cstring caseName = "error detection";
+
+    std::vector<Mesh::Vertex> vertices;
+    vertices.push_back(makeVertex(vec3f(-1.0f, 0.0f, 0.0f), vec2f(0.25f, 0.75f), vec3f(0.0f, 1.0f, 0.0f)));
+    vertices.push_back(makeVertex(vec3f( 1.0f, 1.0f, 1.0f), vec2f(0.75f, 0.25f), vec3f(1.0f, 0.0f, 0.0f)));
+
+    const vertexquant::QuantParams params = vertexquant::calculateParams(&vertices[0], vertices.size());
+
+    std::vector<vertexquant::CompactVertex> compact;
+    vertexquant::encode(&vertices[0], vertices.size(), params, compact);
+    check(vertexquant::measureError(&vertices[0], compact, params).er_withinBounds, caseName, "clean encoding rejected");
+
+    // A single step off in a position or texture coordinate must
+    // be reported, as must a normal off by a few hundredths of a
+    // degree
+    std::vector<vertexquant::CompactVertex> corrupted = compact;
+    corrupted[0].cv_position[0] += 1U;
+    check(!vertexquant::measureError(&vertices[0], corrupted, params).er_withinBounds, caseName, "position step not detected");
+
+    corrupted = compact;
+    corrupted[0].cv_texcoord[1] += 1U;
+    check(!vertexquant::measureError(&vertices[0], corrupted, params).er_withinBounds, caseName, "texcoord ulp not detected");
+
+    corrupted = compact;
+    corrupted[1].cv_normal[1] += 16;
+    check(!vertexquant::measureError(&vertices[0], corrupted, params).er_withinBounds, caseName, "normal steps not detected");
+
+    printf("%-32s 3 corrupted encodings\n", caseName);
+}
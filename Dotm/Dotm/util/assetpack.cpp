@@ -0,0 +1,187 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        assetpack.cpp
+
+   File description: Implementation of the
+   AssetPack class declared in assetpack.h
+   ------------------------------------------------ */
+
+#include "assetpack.h"
+#include "logging.h"
+#include "lz4.h"
+#include "math.h"
+#include <cstring>
+
+/* ---------
+   Constants
+   --------- */
+#define AP_PACK_PATH      "assets/assets.dpak"
+#define AP_PAGE_SIZE      4096
+#define AP_PREFETCH_CHUNK (1024 * 1024)
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static inline stringID
+getAssetID(const std::string& assetPath);
+
+/* --------------
+   Static Methods
+   -------------- */
+AssetPack*
+AssetPack::get()
+{
+    static AssetPack instance;
+    return &instance;
+}
+
+/* --------------
+   Public Methods
+   -------------- */
+AssetPack::~AssetPack()
+{
+    JobSystem::get()->waitFor(&m_prefetchJobs);
+}
+
+bool
+AssetPack::isOpen() logical_const
+{
+    return m_file.isOpen();
+}
+
+bool
+AssetPack::contains(const std::string& assetPath) logical_const
+{
+    return m_entries.find(getAssetID(assetPath)) != m_entries.cend();
+}
+
+bool
+AssetPack::read(const std::string& assetPath,
+                AssetData&         outData) logical_const
+{
+    auto citer = m_entries.find(getAssetID(assetPath));
+    if (citer == m_entries.cend()) return false;
+
+    const packformat::PackEntry& entry = citer->second;
+    const uint8* stored = m_entryData + entry.pe_dataOffset;
+
+    if ((entry.pe_flags & packformat::PACK_FLAG_COMPRESSED) != 0)
+    {
+        outData.ad_storage.resize(entry.pe_originalSize);
+        if (!lz4::decompress(stored,
+                             entry.pe_storedSize,
+                             &outData.ad_storage[0],
+                             outData.ad_storage.size())) return false;
+
+        outData.ad_data = &outData.ad_storage[0];
+    }
+    else
+    {
+        outData.ad_storage.clear();
+        outData.ad_data = stored;
+    }
+    outData.ad_size = entry.pe_originalSize;
+
+#if defined(_DEBUG)
+    if (packformat::checksum(outData.ad_data, outData.ad_size) != entry.pe_checksum)
+    {
+        logstring("Corrupted pack entry: ");
+        logline(assetPath.c_str());
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+void
+AssetPack::prefetch()
+{
+    if (!isOpen()) return;
+
+    const uint8* data = m_file.getData();
+    const size_t size = m_file.getSize();
+
+    for (size_t chunkStart = 0;
+                chunkStart < size;
+                chunkStart += AP_PREFETCH_CHUNK)
+    {
+        const size_t chunkEnd = math::min2ui(chunkStart + AP_PREFETCH_CHUNK, size);
+        JobSystem::get()->run([=]()
+        {
+            volatile uint8 touched = 0U;
+            for (size_t offset = chunkStart;
+                        offset < chunkEnd;
+                        offset += AP_PAGE_SIZE)
+            {
+                touched += data[offset];
+            }
+        }, &m_prefetchJobs);
+    }
+}
+
+/* ---------------
+   Private Methods
+   --------------- */
+AssetPack::AssetPack():
+
+    m_entryData(nullptr)
+{
+    if (!m_file.open(AP_PACK_PATH)) return;
+
+    const uint8* data = m_file.getData();
+    const size_t size = m_file.getSize();
+
+    // The pack is only trusted after its sections are known to be
+    // in bounds; entries are checked as they are indexed
+    packformat::PackHeader header = {};
+    if (size >= sizeof(packformat::PackHeader)) memcpy(&header, data, sizeof(packformat::PackHeader));
+
+    if (header.ph_magic   != packformat::PACK_MAGIC                                                     ||
+        header.ph_version != packformat::PACK_VERSION                                                   ||
+        header.ph_tocOffset   + static_cast<ullong64>(sizeof(packformat::PackEntry)) * header.ph_nEntries > size ||
+        header.ph_namesOffset + static_cast<ullong64>(header.ph_namesSize) > size                       ||
+        header.ph_dataOffset  + static_cast<ullong64>(header.ph_dataSize)  > size)
+    {
+        logline("Invalid asset pack, falling back to loose files");
+        m_file.close();
+        return;
+    }
+
+    m_entryData = data + header.ph_dataOffset;
+
+    // Entry names are stored as strings, as stringIDs are not stable
+    // across platforms, and interned here once
+    m_entries.reserve(header.ph_nEntries);
+    for (uint32 i = 0;
+                i < header.ph_nEntries;
+              ++i)
+    {
+        packformat::PackEntry entry = {};
+        memcpy(&entry, data + header.ph_tocOffset + sizeof(packformat::PackEntry) * i, sizeof(packformat::PackEntry));
+
+        if (entry.pe_nameOffset + static_cast<ullong64>(entry.pe_nameLength) > header.ph_namesSize ||
+            entry.pe_dataOffset + static_cast<ullong64>(entry.pe_storedSize) > header.ph_dataSize  ||
+            ((entry.pe_flags & packformat::PACK_FLAG_COMPRESSED) == 0 &&
+             entry.pe_storedSize != entry.pe_originalSize)) continue;
+
+        std::string name(reinterpret_cast<const char*>(data + header.ph_namesOffset + entry.pe_nameOffset),
+                         entry.pe_nameLength);
+        m_entries[internString(name.c_str())] = entry;
+    }
+
+    logstring("Opened asset pack, entries: ");
+    logline(static_cast<uint32>(m_entries.size()));
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static inline stringID
+getAssetID(const std::string& assetPath)
+{
+    // Same ID internString would produce, without storing
+    // every asset path in the string table
+    return hashString(assetPath.c_str());
+}
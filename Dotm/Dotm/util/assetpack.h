@@ -0,0 +1,90 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        assetpack.h
+
+   File description: A singleton reader over the
+   packed asset archive (see packformat.h). The pack
+   is opened and mapped once, and its table of
+   contents is indexed by stringID so that loaders
+   can look assets up without touching the file
+   system. When no pack is present every lookup
+   fails and loaders fall back to the loose files.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "jobsystem.h"
+#include "mappedfile.h"
+#include "packformat.h"
+#include "strings.h"
+#include "../dotmdef.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The contents of a pack entry. Uncompressed entries point
+// straight into the mapped pack, while compressed ones are
+// decompressed into ad_storage.
+struct AssetData
+{
+    const uint8*       ad_data;
+    size_t             ad_size;
+    std::vector<uint8> ad_storage;
+};
+
+class AssetPack
+{
+public:
+
+    static AssetPack*
+    get();
+
+public:
+
+    ~AssetPack();
+
+    bool
+    isOpen() logical_const;
+
+    bool
+    contains(const std::string& assetPath) logical_const;
+
+    // <summary>
+    // <para>
+    // Reads the entry of the given asset path (i.e.
+    // "assets/models/sample_cube.obj") into outData. Returns false
+    // if there is no such entry or it failed its checksum.
+    // Safe to call from any thread.
+    // </para>
+    // </summary>
+    bool
+    read(const std::string& assetPath,
+         AssetData&         outData) logical_const;
+
+    // <summary>
+    // <para>
+    // Touches every page of the pack on the job system, so that
+    // the first loads of a level hit memory instead of the disk.
+    // </para>
+    // </summary>
+    void
+    prefetch();
+
+private:
+
+    AssetPack();
+
+    AssetPack(const AssetPack& rhs) = delete;
+
+    AssetPack&
+    operator = (const AssetPack& rhs) = delete;
+
+private:
+
+    MappedFile                                           m_file;
+    std::unordered_map<stringID, packformat::PackEntry> m_entries;
+    const uint8*                                         m_entryData;
+    JobCounter                                           m_prefetchJobs;
+
+};
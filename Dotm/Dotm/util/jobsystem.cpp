@@ -0,0 +1,387 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        jobsystem.cpp
+
+   File description: Implementation of the
+   JobCounter and JobSystem classes declared in
+   jobsystem.h
+   ------------------------------------------------ */
+
+#include "jobsystem.h"
+#include "profiler.h"
+#include <chrono>
+
+/* ---------
+   Constants
+   --------- */
+#define JS_IDLE_WAIT_MS        1
+#define JS_COUNTER_DEPENDENTS  0x80000000U
+#define JS_COUNTER_COUNT_MASK  0x7FFFFFFFU
+
+/* -------------
+   Internal Vars
+   ------------- */
+static thread_local size_t s_workerIndex = JobSystem::INVALID_WORKER_INDEX;
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static size_t
+getQueueIndex();
+
+/* =================
+   Class: JobCounter
+   ================= */
+JobCounter::JobCounter():
+
+    m_pending(0U)
+{
+
+}
+
+bool
+JobCounter::isDone() logical_const
+{
+    return (m_pending & JS_COUNTER_COUNT_MASK) == 0U;
+}
+
+/* ================
+   Class: JobSystem
+   ================ */
+
+/* --------------
+   Static Methods
+   -------------- */
+JobSystem*
+JobSystem::get()
+{
+    static JobSystem instance;
+    return &instance;
+}
+
+size_t
+JobSystem::getWorkerIndex()
+{
+    return s_workerIndex;
+}
+
+bool
+JobSystem::isMainThread()
+{
+    return s_workerIndex == 0U;
+}
+
+/* --------------
+   Public Methods
+   -------------- */
+JobSystem::~JobSystem()
+{
+    m_running = false;
+    m_wakeCondition.notify_all();
+
+    for (auto iter = m_threads.begin();
+              iter != m_threads.end();
+            ++iter)
+    {
+        iter->join();
+    }
+
+    for (auto iter = m_queues.begin();
+              iter != m_queues.end();
+            ++iter)
+    {
+        delete *iter;
+    }
+}
+
+void
+JobSystem::run(Job               job,
+               JobCounter*       optCounter,    /* nullptr */
+               const JobCounter* optDependency  /* nullptr */)
+{
+    if (optCounter) ++optCounter->m_pending;
+
+    QueuedJob queued = {};
+    queued.qj_job        = std::move(job);
+    queued.qj_counter    = optCounter;
+    queued.qj_dependency = optDependency;
+
+    if (optDependency)
+    {
+        // Flagging the dependency makes its last decrement take the
+        // waiting lock (see completeJob), so the job cannot miss the
+        // dependency's completion
+        std::lock_guard<std::mutex> lock(m_waitingMutex);
+        uint32 pending = optDependency->m_pending.load();
+        while (pending & JS_COUNTER_COUNT_MASK)
+        {
+            if (optDependency->m_pending.compare_exchange_weak(pending, pending | JS_COUNTER_DEPENDENTS))
+            {
+                m_waitingJobs.push_back(std::move(queued));
+                return;
+            }
+        }
+    }
+
+    push(getQueueIndex(), std::move(queued));
+    m_wakeCondition.notify_one();
+}
+
+void
+JobSystem::runOnMainThread(Job         job,
+                           JobCounter* optCounter /* nullptr */)
+{
+    if (optCounter) ++optCounter->m_pending;
+
+    QueuedJob queued = {};
+    queued.qj_job     = std::move(job);
+    queued.qj_counter = optCounter;
+
+    std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+    m_mainThreadJobs.push_back(std::move(queued));
+}
+
+void
+JobSystem::waitFor(const JobCounter* counter)
+{
+    if (!counter) return;
+
+    const size_t workerIndex = getQueueIndex();
+    const bool   mainThread  = isMainThread();
+
+    while (!counter->isDone())
+    {
+        // The main thread also serves main thread jobs, since the
+        // awaited work may well depend on one of them
+        if (mainThread && tryRunMainThreadJob()) continue;
+        if (tryRunJob(workerIndex)) continue;
+        std::this_thread::yield();
+    }
+}
+
+void
+JobSystem::parallelFor(const size_t    count,
+                       const size_t    grainSize,
+                       const RangeJob& body)
+{
+    if (!count) return;
+
+    const size_t grain   = grainSize ? grainSize : 1U;
+    const size_t nChunks = (count + grain - 1) / grain;
+
+    // A single chunk is not worth the queueing overhead
+    if (nChunks == 1 || m_threads.empty())
+    {
+        body(0U, count);
+        return;
+    }
+
+    JobCounter chunksCounter;
+    for (size_t chunk = 0;
+                chunk < nChunks;
+              ++chunk)
+    {
+        const size_t begin = chunk * grain;
+        const size_t end   = begin + grain < count ? begin + grain : count;
+
+        run([&body, begin, end]() { body(begin, end); }, &chunksCounter);
+    }
+    m_wakeCondition.notify_all();
+
+    waitFor(&chunksCounter);
+}
+
+void
+JobSystem::pumpMainThread()
+{
+    // Only drain what was queued up to this point so that jobs
+    // re-queuing themselves cannot stall the frame
+    size_t nJobs = 0U;
+    {
+        std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+        nJobs = m_mainThreadJobs.size();
+    }
+
+    for (; nJobs && tryRunMainThreadJob(); --nJobs);
+}
+
+size_t
+JobSystem::getNumWorkers() logical_const
+{
+    return m_queues.size();
+}
+
+/* ---------------
+   Private Methods
+   --------------- */
+JobSystem::JobSystem():
+
+    m_running(true),
+    m_queuedJobs(0U)
+{
+    // The singleton is first requested by the main thread
+    s_workerIndex = 0U;
+
+    uint32 hwThreads = std::thread::hardware_concurrency();
+    size_t nWorkers  = hwThreads > 1 ? hwThreads : 1U;
+
+    for (size_t i = 0;
+                i < nWorkers;
+              ++i)
+    {
+        m_queues.push_back(new WorkerQueue);
+    }
+
+    // Worker 0 is the main thread itself
+    for (size_t i = 1;
+                i < nWorkers;
+              ++i)
+    {
+        m_threads.push_back(std::thread(&JobSystem::workerLoop, this, i));
+    }
+}
+
+void
+JobSystem::workerLoop(const size_t workerIndex)
+{
+    s_workerIndex = workerIndex;
+
+    while (m_running)
+    {
+        if (tryRunJob(workerIndex)) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeCondition.wait_for(lock,
+                                 std::chrono::milliseconds(JS_IDLE_WAIT_MS),
+                                 [this]() { return !m_running || m_queuedJobs > 0; });
+    }
+}
+
+void
+JobSystem::push(const size_t workerIndex, QueuedJob job)
+{
+    WorkerQueue* queue = m_queues[workerIndex % m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue->wq_mutex);
+    queue->wq_jobs.push_back(std::move(job));
+    ++m_queuedJobs;
+}
+
+bool
+JobSystem::tryRunJob(const size_t workerIndex)
+{
+    QueuedJob job = {};
+    const size_t nQueues = m_queues.size();
+
+    // Own queue first (LIFO for cache warmth), then steal
+    // from the other workers' queues (FIFO)
+    for (size_t offset = 0;
+                offset < nQueues && !job.qj_job;
+              ++offset)
+    {
+        WorkerQueue* queue = m_queues[(workerIndex + offset) % nQueues];
+        std::lock_guard<std::mutex> lock(queue->wq_mutex);
+        if (queue->wq_jobs.empty()) continue;
+
+        if (offset == 0)
+        {
+            job = std::move(queue->wq_jobs.back());
+            queue->wq_jobs.pop_back();
+        }
+        else
+        {
+            job = std::move(queue->wq_jobs.front());
+            queue->wq_jobs.pop_front();
+        }
+        --m_queuedJobs;
+    }
+
+    if (!job.qj_job) return false;
+
+    execute(job);
+    return true;
+}
+
+bool
+JobSystem::tryRunMainThreadJob()
+{
+    QueuedJob job = {};
+    {
+        std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+        if (m_mainThreadJobs.empty()) return false;
+
+        job = std::move(m_mainThreadJobs.front());
+        m_mainThreadJobs.pop_front();
+    }
+
+    execute(job);
+    return true;
+}
+
+void
+JobSystem::execute(QueuedJob& job)
+{
+    PROFILE_ZONE("JobSystem::execute");
+
+    job.qj_job();
+
+    if (job.qj_counter) completeJob(job.qj_counter);
+}
+
+void
+JobSystem::completeJob(JobCounter* counter)
+{
+    // Counters nobody depends on are decremented lock free
+    uint32 pending = counter->m_pending.load();
+    while ((pending & JS_COUNTER_DEPENDENTS) == 0U)
+    {
+        if (counter->m_pending.compare_exchange_weak(pending, pending - 1U)) return;
+    }
+
+    // The counter's owner may destroy it as soon as it reaches
+    // zero, so it is only compared by address afterwards. Doing
+    // the decrement and the release under the waiting lock keeps
+    // a new counter at the same address from parking jobs in
+    // between
+    std::vector<QueuedJob> released;
+    {
+        std::lock_guard<std::mutex> lock(m_waitingMutex);
+        if (((counter->m_pending.fetch_sub(1U) - 1U) & JS_COUNTER_COUNT_MASK) != 0U) return;
+
+        for (auto iter = m_waitingJobs.begin();
+                  iter != m_waitingJobs.end();)
+        {
+            if (iter->qj_dependency == counter)
+            {
+                released.push_back(std::move(*iter));
+                iter = m_waitingJobs.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    if (released.empty()) return;
+
+    for (auto iter = released.begin();
+              iter != released.end();
+            ++iter)
+    {
+        push(getQueueIndex(), std::move(*iter));
+    }
+    m_wakeCondition.notify_all();
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static size_t
+getQueueIndex()
+{
+    // Threads outside the pool push to and help from the main
+    // thread's deque, which is locked like every other
+    const size_t workerIndex = JobSystem::getWorkerIndex();
+    return workerIndex == JobSystem::INVALID_WORKER_INDEX ? 0U : workerIndex;
+}
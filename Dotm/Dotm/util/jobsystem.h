@@ -0,0 +1,209 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        jobsystem.h
+
+   File description: A singleton work-stealing
+   thread pool used as the engine wide task runtime.
+   Each worker (the main thread being worker 0) owns
+   a job deque; owners pop from the back while idle
+   workers steal from the front of the other
+   workers' deques. Jobs can be tracked and chained
+   through JobCounters, and jobs that must touch the
+   D3D immediate context can be routed to the main
+   thread.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* =================
+   Class: JobCounter
+   ================= */
+
+// Counts the jobs still pending against it. A counter
+// reaching zero marks all of its jobs as completed and
+// releases any job that was waiting on it. The owner may
+// destroy the counter as soon as isDone returns true.
+class JobCounter
+{
+public:
+
+    JobCounter();
+
+    JobCounter(const JobCounter& rhs) = delete;
+
+    JobCounter&
+    operator = (const JobCounter& rhs) = delete;
+
+    bool
+    isDone() logical_const;
+
+private:
+
+    friend class JobSystem;
+
+    // The pending count, with the top bit set once a job has
+    // been parked on the counter. Mutable as dependencies are
+    // passed as const counters
+    mutable std::atomic<uint32> m_pending;
+
+};
+
+/* ================
+   Class: JobSystem
+   ================ */
+class JobSystem
+{
+public:
+
+    typedef std::function<void()>               Job;
+    typedef std::function<void(size_t, size_t)> RangeJob;
+
+    // The worker index of threads outside the pool
+    static const size_t INVALID_WORKER_INDEX = static_cast<size_t>(-1);
+
+public:
+
+    static JobSystem*
+    get();
+
+    // <summary>
+    // <para>
+    // Index of the worker the calling thread belongs to.
+    // The main thread is always worker 0, and threads outside
+    // the pool get INVALID_WORKER_INDEX.
+    // </para>
+    // </summary>
+    static size_t
+    getWorkerIndex();
+
+    static bool
+    isMainThread();
+
+public:
+
+    ~JobSystem();
+
+    // <summary>
+    // <para>
+    // Queues a job on the calling worker's deque. If optCounter
+    // is set it is incremented now and decremented once the job
+    // completes. If optDependency is set the job is held back
+    // until that counter reaches zero.
+    // </para>
+    // </summary>
+    void
+    run(Job               job,
+        JobCounter*       optCounter    = nullptr,
+        const JobCounter* optDependency = nullptr);
+
+    // <summary>
+    // <para>
+    // Queues a job that may only run on the main thread (i.e.
+    // anything using the D3D immediate context). Main thread
+    // jobs are executed in pumpMainThread, or while the main
+    // thread is blocked in waitFor.
+    // </para>
+    // </summary>
+    void
+    runOnMainThread(Job         job,
+                    JobCounter* optCounter = nullptr);
+
+    // <summary>
+    // <para>
+    // Blocks until the counter reaches zero. The calling thread
+    // executes queued jobs in the meantime instead of idling.
+    // </para>
+    // </summary>
+    void
+    waitFor(const JobCounter* counter);
+
+    // <summary>
+    // <para>
+    // Splits [0, count) into chunks of at most grainSize elements
+    // and runs body(begin, end) for each chunk across the pool.
+    // The calling thread participates and the call returns only
+    // when every chunk has completed.
+    // </para>
+    // </summary>
+    void
+    parallelFor(const size_t    count,
+                const size_t    grainSize,
+                const RangeJob& body);
+
+    // Executes the jobs queued through runOnMainThread.
+    // Must be called once per frame from the main thread
+    void
+    pumpMainThread();
+
+    // Number of workers including the main thread
+    size_t
+    getNumWorkers() logical_const;
+
+private:
+
+    struct QueuedJob
+    {
+        Job               qj_job;
+        JobCounter*       qj_counter;
+        const JobCounter* qj_dependency;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex            wq_mutex;
+        std::deque<QueuedJob> wq_jobs;
+    };
+
+private:
+
+    JobSystem();
+
+    JobSystem(const JobSystem& rhs) = delete;
+
+    JobSystem&
+    operator = (const JobSystem& rhs) = delete;
+
+    void
+    workerLoop(const size_t workerIndex);
+
+    void
+    push(const size_t workerIndex, QueuedJob job);
+
+    bool
+    tryRunJob(const size_t workerIndex);
+
+    bool
+    tryRunMainThreadJob();
+
+    void
+    execute(QueuedJob& job);
+
+    // Decrements the counter of a finished job, releasing the jobs
+    // parked on it when it reaches zero
+    void
+    completeJob(JobCounter* counter);
+
+private:
+
+    std::vector<WorkerQueue*> m_queues;
+    std::vector<std::thread>  m_threads;
+    std::atomic<bool>         m_running;
+    std::atomic<uint32>       m_queuedJobs;
+    std::mutex                m_sleepMutex;
+    std::condition_variable   m_wakeCondition;
+    std::mutex                m_mainThreadMutex;
+    std::deque<QueuedJob>     m_mainThreadJobs;
+    std::mutex                m_waitingMutex;
+    std::vector<QueuedJob>    m_waitingJobs;
+
+};
@@ -0,0 +1,221 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        lz4.cpp
+
+   File description: Implementation of the LZ4
+   block functions declared in lz4.h
+   ------------------------------------------------ */
+
+#include "lz4.h"
+#include <cstring>
+
+/* ---------
+   Constants
+   --------- */
+#define LZ4_MIN_MATCH      4
+#define LZ4_LAST_LITERALS  5
+#define LZ4_MF_LIMIT       12
+#define LZ4_MAX_OFFSET     65535
+#define LZ4_HASH_LOG       16
+#define LZ4_RUN_MASK       15
+#define LZ4_NO_POSITION    0xFFFFFFFF
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static inline uint32
+read32(const uint8* p);
+
+static inline uint32
+hashSequence(const uint32 sequence);
+
+static void
+writeLength(size_t length, std::vector<uint8>& out);
+
+static void
+writeSequence(const uint8*        literals,
+              const size_t        nLiterals,
+              const size_t        offset,
+              const size_t        matchLength,
+              std::vector<uint8>& out);
+
+static bool
+readLength(const uint8*& ip, const uint8* end, size_t& length);
+
+/* --------------
+   Public Methods
+   -------------- */
+size_t
+lz4::compressBound(const size_t srcSize)
+{
+    return srcSize + srcSize / 255 + 16;
+}
+
+void
+lz4::compress(const uint8*        src,
+              const size_t        srcSize,
+              std::vector<uint8>& outBlock)
+{
+    outBlock.clear();
+    outBlock.reserve(compressBound(srcSize));
+
+    size_t anchor = 0U;
+
+    // Inputs too short to hold a match are a single literal run
+    if (srcSize > LZ4_MF_LIMIT)
+    {
+        std::vector<uint32> hashTable(1U << LZ4_HASH_LOG, LZ4_NO_POSITION);
+
+        // A match may not start within the last 12 bytes, and
+        // the last 5 bytes are always literals
+        const size_t matchStartLimit = srcSize - LZ4_MF_LIMIT;
+        const size_t matchEndLimit   = srcSize - LZ4_LAST_LITERALS;
+
+        size_t ip = 0U;
+        while (ip < matchStartLimit)
+        {
+            const uint32 sequence = read32(src + ip);
+            const uint32 hash     = hashSequence(sequence);
+            const uint32 ref      = hashTable[hash];
+            hashTable[hash]       = ip;
+
+            if (ref == LZ4_NO_POSITION    ||
+                ip - ref > LZ4_MAX_OFFSET ||
+                read32(src + ref) != sequence)
+            {
+                ++ip;
+                continue;
+            }
+
+            size_t matchLength = LZ4_MIN_MATCH;
+            while (ip + matchLength < matchEndLimit &&
+                   src[ref + matchLength] == src[ip + matchLength])
+            {
+                ++matchLength;
+            }
+
+            writeSequence(src + anchor, ip - anchor, ip - ref, matchLength, outBlock);
+            ip    += matchLength;
+            anchor = ip;
+        }
+    }
+
+    // Trailing literals, without an offset
+    const size_t nLiterals = srcSize - anchor;
+    const uint8  token     = static_cast<uint8>((nLiterals < LZ4_RUN_MASK ? nLiterals : LZ4_RUN_MASK) << 4);
+    outBlock.push_back(token);
+    if (nLiterals >= LZ4_RUN_MASK) writeLength(nLiterals - LZ4_RUN_MASK, outBlock);
+    outBlock.insert(outBlock.end(), src + anchor, src + srcSize);
+}
+
+bool
+lz4::decompress(const uint8* src,
+                const size_t srcSize,
+                uint8*       dst,
+                const size_t dstSize)
+{
+    const uint8* ip     = src;
+    const uint8* ipEnd  = src + srcSize;
+    uint8*       op     = dst;
+    uint8*       opEnd  = dst + dstSize;
+
+    while (ip < ipEnd)
+    {
+        const uint8 token = *ip++;
+
+        // Literal run
+        size_t nLiterals = token >> 4;
+        if (nLiterals == LZ4_RUN_MASK && !readLength(ip, ipEnd, nLiterals)) return false;
+        if (nLiterals > static_cast<size_t>(ipEnd - ip) ||
+            nLiterals > static_cast<size_t>(opEnd - op)) return false;
+
+        memcpy(op, ip, nLiterals);
+        ip += nLiterals;
+        op += nLiterals;
+
+        // The last sequence has no match part
+        if (ip == ipEnd) break;
+
+        // Match
+        if (ipEnd - ip < 2) return false;
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) return false;
+
+        size_t matchLength = token & LZ4_RUN_MASK;
+        if (matchLength == LZ4_RUN_MASK && !readLength(ip, ipEnd, matchLength)) return false;
+        matchLength += LZ4_MIN_MATCH;
+        if (matchLength > static_cast<size_t>(opEnd - op)) return false;
+
+        // Byte wise copy, as the match may overlap its own output
+        const uint8* match = op - offset;
+        for (size_t i = 0;
+                    i < matchLength;
+                  ++i)
+        {
+            op[i] = match[i];
+        }
+        op += matchLength;
+    }
+
+    return op == opEnd;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static inline uint32
+read32(const uint8* p)
+{
+    uint32 value;
+    memcpy(&value, p, sizeof(uint32));
+    return value;
+}
+
+static inline uint32
+hashSequence(const uint32 sequence)
+{
+    return (sequence * 2654435761U) >> (32 - LZ4_HASH_LOG);
+}
+
+static void
+writeLength(size_t length, std::vector<uint8>& out)
+{
+    for (; length >= 255; length -= 255) out.push_back(255);
+    out.push_back(static_cast<uint8>(length));
+}
+
+static void
+writeSequence(const uint8*        literals,
+              const size_t        nLiterals,
+              const size_t        offset,
+              const size_t        matchLength,
+              std::vector<uint8>& out)
+{
+    const size_t matchCode = matchLength - LZ4_MIN_MATCH;
+
+    const uint8 token = static_cast<uint8>(((nLiterals < LZ4_RUN_MASK ? nLiterals : LZ4_RUN_MASK) << 4) |
+                                           (matchCode < LZ4_RUN_MASK ? matchCode : LZ4_RUN_MASK));
+    out.push_back(token);
+
+    if (nLiterals >= LZ4_RUN_MASK) writeLength(nLiterals - LZ4_RUN_MASK, out);
+    out.insert(out.end(), literals, literals + nLiterals);
+
+    out.push_back(static_cast<uint8>(offset & 0xFF));
+    out.push_back(static_cast<uint8>(offset >> 8));
+
+    if (matchCode >= LZ4_RUN_MASK) writeLength(matchCode - LZ4_RUN_MASK, out);
+}
+
+static bool
+readLength(const uint8*& ip, const uint8* end, size_t& length)
+{
+    for (;;)
+    {
+        if (ip >= end) return false;
+        const uint8 byte = *ip++;
+        length += byte;
+        if (byte != 255) return true;
+    }
+}
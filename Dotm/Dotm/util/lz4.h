@@ -0,0 +1,51 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        lz4.h
+
+   File description: A compact implementation of
+   the LZ4 block format. The compressor is a greedy
+   single probe hash matcher (fast rather than
+   tight), and the decompressor validates every
+   length and offset against both buffers so that
+   corrupted data can never read or write out of
+   bounds. Blocks are compatible with the reference
+   implementation's LZ4_decompress_safe.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include <cstddef>
+#include <vector>
+
+namespace lz4
+{
+    // Worst case compressed size of srcSize input bytes
+    size_t
+    compressBound(const size_t srcSize);
+
+    // <summary>
+    // <para>
+    // Compresses [src, src + srcSize) into a single LZ4 block,
+    // replacing the contents of outBlock.
+    // </para>
+    // </summary>
+    void
+    compress(const uint8*        src,
+             const size_t        srcSize,
+             std::vector<uint8>& outBlock);
+
+    // <summary>
+    // <para>
+    // Decompresses the LZ4 block [src, src + srcSize) into dst,
+    // which must be exactly dstSize bytes long (the original size).
+    // Returns false if the block is malformed.
+    // </para>
+    // </summary>
+    bool
+    decompress(const uint8* src,
+               const size_t srcSize,
+               uint8*       dst,
+               const size_t dstSize);
+}
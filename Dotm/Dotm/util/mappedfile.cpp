@@ -0,0 +1,114 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        mappedfile.cpp
+
+   File description: Implementation of the
+   MappedFile class declared in mappedfile.h
+   ------------------------------------------------ */
+
+#include "mappedfile.h"
+
+/* --------------
+   Static Methods
+   -------------- */
+bool
+MappedFile::getLastWriteTime(const std::string& path,
+                             ullong64&          outTime)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+    if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &attributes)) return false;
+
+    outTime = (static_cast<ullong64>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+               static_cast<ullong64>(attributes.ftLastWriteTime.dwLowDateTime);
+    return true;
+}
+
+/* --------------
+   Public Methods
+   -------------- */
+MappedFile::MappedFile():
+
+    m_file(INVALID_HANDLE_VALUE),
+    m_mapping(NULL),
+    m_data(nullptr),
+    m_size(0U)
+{
+
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool
+MappedFile::open(const std::string& path)
+{
+    close();
+
+    m_file = CreateFileA(path.c_str(),
+                         GENERIC_READ,
+                         FILE_SHARE_READ,
+                         NULL,
+                         OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                         NULL);
+    if (m_file == INVALID_HANDLE_VALUE) return false;
+
+    // Empty files cannot be mapped
+    LARGE_INTEGER fileSize = {};
+    if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!m_mapping)
+    {
+        close();
+        return false;
+    }
+
+    m_data = static_cast<const uint8*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data)
+    {
+        close();
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void
+MappedFile::close()
+{
+    if (m_data)                         UnmapViewOfFile(m_data);
+    if (m_mapping)                      CloseHandle(m_mapping);
+    if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+
+    m_file    = INVALID_HANDLE_VALUE;
+    m_mapping = NULL;
+    m_data    = nullptr;
+    m_size    = 0U;
+}
+
+bool
+MappedFile::isOpen() logical_const
+{
+    return m_data != nullptr;
+}
+
+const uint8*
+MappedFile::getData() logical_const
+{
+    return m_data;
+}
+
+size_t
+MappedFile::getSize() logical_const
+{
+    return m_size;
+}
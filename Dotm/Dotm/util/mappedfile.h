@@ -0,0 +1,69 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        mappedfile.h
+
+   File description: A read only memory mapped
+   file. The file contents are paged in on demand
+   by the OS, so loaders can hand pointers into the
+   mapping straight to their consumers without an
+   intermediate copy.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include <Windows.h>
+#include "../dotmdef.h"
+#include <string>
+
+class MappedFile
+{
+public:
+
+    // <summary>
+    // <para>
+    // Retrieves the last write time of the file at the given path
+    // in 100ns ticks. Returns false if the file does not exist.
+    // </para>
+    // </summary>
+    static bool
+    getLastWriteTime(const std::string& path,
+                     ullong64&          outTime);
+
+public:
+
+    MappedFile();
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile& rhs) = delete;
+
+    MappedFile&
+    operator = (const MappedFile& rhs) = delete;
+
+    // Maps the whole file at the given path, closing any file
+    // mapped so far. Returns false if the file could not be
+    // opened or is empty.
+    bool
+    open(const std::string& path);
+
+    void
+    close();
+
+    bool
+    isOpen() logical_const;
+
+    const uint8*
+    getData() logical_const;
+
+    size_t
+    getSize() logical_const;
+
+private:
+
+    HANDLE       m_file;
+    HANDLE       m_mapping;
+    const uint8* m_data;
+    size_t       m_size;
+
+};
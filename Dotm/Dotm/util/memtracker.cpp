@@ -0,0 +1,350 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        memtracker.cpp
+
+   File description: Implementation of the global
+   allocation functions and the accounting functions
+   declared in memtracker.h.
+
+   Every block is prefixed with a small header
+   holding its size and tag, so that frees are
+   attributed to the tag that allocated them no
+   matter which thread or scope frees them.
+   ------------------------------------------------ */
+
+#include "memtracker.h"
+#include "logging.h"
+#include "../config/configparser.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+/* --------------
+   Internal Types
+   -------------- */
+
+// Padded to keep the user block aligned as malloc's
+struct alignas(alignof(std::max_align_t)) BlockHeader
+{
+    size_t bh_size;
+    uint32 bh_tag;
+};
+
+// Counters of different tags live on different cache lines,
+// so that subsystems allocating in parallel do not contend
+struct alignas(64) TagCounters
+{
+    std::atomic<size_t>   tc_liveBytes;
+    std::atomic<size_t>   tc_peakBytes;
+    std::atomic<size_t>   tc_liveAllocations;
+    std::atomic<ullong64> tc_totalAllocations;
+};
+
+struct TagFrameState
+{
+    ullong64 tf_frameStartAllocations;
+    uint32   tf_frameAllocations;
+    size_t   tf_budgetBytes;
+    uint32   tf_budgetWarnings;
+    bool     tf_overBudget;
+};
+
+/* -------------
+   Internal Vars
+   ------------- */
+
+// Zero initialized before any dynamic initialization, so that
+// allocations made during static initialization are counted too
+static TagCounters                     s_counters[memtracker::MEM_TAG_COUNT];
+static TagFrameState                   s_frameStates[memtracker::MEM_TAG_COUNT];
+static thread_local memtracker::MemTag s_currentTag = memtracker::MEM_TAG_GENERAL;
+
+static const cstring s_tagNames[memtracker::MEM_TAG_COUNT] =
+{
+    "general",
+    "meshes",
+    "textures",
+    "entities",
+    "commands",
+    "pathfinding",
+    "strings"
+};
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static void*
+allocate(const size_t             size,
+         const memtracker::MemTag tag);
+
+static void
+deallocate(void* ptr);
+
+/* ----------------
+   Public Functions
+   ---------------- */
+ullong64
+memtracker::getAllocationCount()
+{
+    ullong64 count = 0U;
+    for (size_t i = 0;
+                i < MEM_TAG_COUNT;
+              ++i)
+    {
+        count += s_counters[i].tc_totalAllocations.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+void*
+memtracker::allocateTagged(const size_t size,
+                           const MemTag tag)
+{
+    // As the standard operator new: the new handler may free some
+    // memory (or throw) before every retry, and the allocation
+    // only fails once there is no handler installed
+    for (;;)
+    {
+        void* ptr = allocate(size, tag);
+        if (ptr) return ptr;
+
+        const std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+memtracker::MemTag
+memtracker::getCurrentTag()
+{
+    return s_currentTag;
+}
+
+void
+memtracker::setCurrentTag(const MemTag tag)
+{
+    s_currentTag = tag;
+}
+
+cstring
+memtracker::getTagName(const MemTag tag)
+{
+    return s_tagNames[tag];
+}
+
+void
+memtracker::loadBudgets()
+{
+    if (!config::initConfigFile("memconfig")) return;
+
+    for (size_t i = 0;
+                i < MEM_TAG_COUNT;
+              ++i)
+    {
+        const std::string key = std::string("budget_") + s_tagNames[i] + "_mb";
+        s_frameStates[i].tf_budgetBytes = static_cast<size_t>(config::getUint("memconfig", key.c_str(), 0U)) * 1024U * 1024U;
+    }
+}
+
+void
+memtracker::beginFrame()
+{
+    for (size_t i = 0;
+                i < MEM_TAG_COUNT;
+              ++i)
+    {
+        TagFrameState& frameState = s_frameStates[i];
+
+        const ullong64 totalAllocations = s_counters[i].tc_totalAllocations.load(std::memory_order_relaxed);
+        frameState.tf_frameAllocations      = static_cast<uint32>(totalAllocations - frameState.tf_frameStartAllocations);
+        frameState.tf_frameStartAllocations = totalAllocations;
+
+        if (!frameState.tf_budgetBytes) continue;
+
+        const bool overBudget = s_counters[i].tc_liveBytes.load(std::memory_order_relaxed) > frameState.tf_budgetBytes;
+        if (overBudget && !frameState.tf_overBudget)
+        {
+            ++frameState.tf_budgetWarnings;
+            logstring("Memory budget exceeded: ");
+            logline(s_tagNames[i]);
+        }
+        frameState.tf_overBudget = overBudget;
+    }
+}
+
+memtracker::TagStats
+memtracker::getTagStats(const MemTag tag)
+{
+    const TagCounters&   counters   = s_counters[tag];
+    const TagFrameState& frameState = s_frameStates[tag];
+
+    TagStats stats = {};
+    stats.ts_liveBytes        = counters.tc_liveBytes.load(std::memory_order_relaxed);
+    stats.ts_peakBytes        = counters.tc_peakBytes.load(std::memory_order_relaxed);
+    stats.ts_liveAllocations  = counters.tc_liveAllocations.load(std::memory_order_relaxed);
+    stats.ts_totalAllocations = counters.tc_totalAllocations.load(std::memory_order_relaxed);
+    stats.ts_frameAllocations = frameState.tf_frameAllocations;
+    stats.ts_budgetBytes      = frameState.tf_budgetBytes;
+    stats.ts_budgetWarnings   = frameState.tf_budgetWarnings;
+    return stats;
+}
+
+bool
+memtracker::writeSnapshot(cstring path)
+{
+    // Stats are read before the file is opened, as opening it
+    // allocates too
+    TagStats stats[MEM_TAG_COUNT];
+    for (size_t i = 0;
+                i < MEM_TAG_COUNT;
+              ++i)
+    {
+        stats[i] = getTagStats(static_cast<MemTag>(i));
+    }
+
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\n  \"tags\": {\n");
+    for (size_t i = 0;
+                i < MEM_TAG_COUNT;
+              ++i)
+    {
+        fprintf(file,
+                "    \"%s\": { \"live_bytes\": %llu, \"peak_bytes\": %llu, \"live_allocations\": %llu, "
+                "\"total_allocations\": %llu, \"frame_allocations\": %u, \"budget_bytes\": %llu, \"budget_warnings\": %u }%s\n",
+                s_tagNames[i],
+                static_cast<ullong64>(stats[i].ts_liveBytes),
+                static_cast<ullong64>(stats[i].ts_peakBytes),
+                static_cast<ullong64>(stats[i].ts_liveAllocations),
+                stats[i].ts_totalAllocations,
+                stats[i].ts_frameAllocations,
+                static_cast<ullong64>(stats[i].ts_budgetBytes),
+                stats[i].ts_budgetWarnings,
+                i + 1U < MEM_TAG_COUNT ? "," : "");
+    }
+    fprintf(file, "  }\n}\n");
+
+    return fclose(file) == 0;
+}
+
+/* -----------------------------
+   Global Allocation Functions
+   ----------------------------- */
+void*
+operator new(size_t size)
+{
+    return memtracker::allocateTagged(size, s_currentTag);
+}
+
+void*
+operator new[](size_t size)
+{
+    return memtracker::allocateTagged(size, s_currentTag);
+}
+
+void*
+operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return memtracker::allocateTagged(size, s_currentTag);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void*
+operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    try
+    {
+        return memtracker::allocateTagged(size, s_currentTag);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void
+operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static void*
+allocate(const size_t             size,
+         const memtracker::MemTag tag)
+{
+    // The header must not wrap the size around to a small block
+    if (size > static_cast<size_t>(-1) - sizeof(BlockHeader)) return nullptr;
+
+    BlockHeader* header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+    if (!header) return nullptr;
+
+    header->bh_size = size;
+    header->bh_tag  = tag;
+
+    TagCounters& counters = s_counters[tag];
+    counters.tc_totalAllocations.fetch_add(1U, std::memory_order_relaxed);
+    counters.tc_liveAllocations.fetch_add(1U, std::memory_order_relaxed);
+
+    const size_t liveBytes = counters.tc_liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t       peakBytes = counters.tc_peakBytes.load(std::memory_order_relaxed);
+    while (liveBytes > peakBytes &&
+           !counters.tc_peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed));
+
+    return header + 1;
+}
+
+static void
+deallocate(void* ptr)
+{
+    if (!ptr) return;
+
+    BlockHeader* header   = static_cast<BlockHeader*>(ptr) - 1;
+    TagCounters& counters = s_counters[header->bh_tag];
+    counters.tc_liveAllocations.fetch_sub(1U, std::memory_order_relaxed);
+    counters.tc_liveBytes.fetch_sub(header->bh_size, std::memory_order_relaxed);
+
+    std::free(header);
+}
@@ -0,0 +1,132 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        memtracker.h
+
+   File description: Heap allocation accounting.
+   The global operator new and delete are replaced
+   so that every heap allocation made through them
+   is counted and attributed to a subsystem tag:
+   the tag passed explicitly (class specific
+   operator new), otherwise the innermost
+   MEM_TAG_SCOPE of the allocating thread. Live
+   bytes, peak and allocations per frame are kept
+   per tag, budgets loaded from config/memconfig.ini
+   are checked once per frame, and a snapshot of
+   all tags can be written as JSON.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include "strings.h"
+#include <cstddef>
+
+#define MEM_TAG_CONCAT_IMPL(a, b) a##b
+#define MEM_TAG_CONCAT(a, b)      MEM_TAG_CONCAT_IMPL(a, b)
+
+// Attributes the allocations of the enclosing scope, on the
+// calling thread, to the tag
+#define MEM_TAG_SCOPE(tag) MemTagScope MEM_TAG_CONCAT(memTagScope, __LINE__)(tag)
+
+namespace memtracker
+{
+    enum MemTag
+    {
+        MEM_TAG_GENERAL,
+        MEM_TAG_MESHES,
+        MEM_TAG_TEXTURES,
+        MEM_TAG_ENTITIES,
+        MEM_TAG_COMMANDS,
+        MEM_TAG_PATHFINDING,
+        MEM_TAG_STRINGS,
+        MEM_TAG_COUNT
+    };
+
+    struct TagStats
+    {
+        size_t   ts_liveBytes;
+        size_t   ts_peakBytes;
+        size_t   ts_liveAllocations;
+        ullong64 ts_totalAllocations;
+        uint32   ts_frameAllocations;
+        size_t   ts_budgetBytes;
+        uint32   ts_budgetWarnings;
+    };
+
+    // Allocations made since startup, from all threads
+    ullong64
+    getAllocationCount();
+
+    // Frees through the global operator delete. Like operator new,
+    // calls the new handler and retries until the allocation
+    // succeeds, throwing std::bad_alloc once no handler is set
+    void*
+    allocateTagged(const size_t size,
+                   const MemTag tag);
+
+    MemTag
+    getCurrentTag();
+
+    void
+    setCurrentTag(const MemTag tag);
+
+    cstring
+    getTagName(const MemTag tag);
+
+    // <summary>
+    // <para>
+    // Reads the per tag budgets (e.g. budget_meshes_mb = 64) from
+    // config/memconfig.ini. Tags without a budget are unlimited.
+    // </para>
+    // </summary>
+    void
+    loadBudgets();
+
+    // <summary>
+    // <para>
+    // Marks the start of a new frame. Main thread only. Closes
+    // the previous frame's per tag allocation counts and warns,
+    // once per crossing, about tags over their budget.
+    // </para>
+    // </summary>
+    void
+    beginFrame();
+
+    TagStats
+    getTagStats(const MemTag tag);
+
+    bool
+    writeSnapshot(cstring path);
+}
+
+/* ==================
+   Class: MemTagScope
+   ================== */
+class MemTagScope
+{
+public:
+
+    explicit
+    MemTagScope(const memtracker::MemTag tag):
+
+        m_previousTag(memtracker::getCurrentTag())
+    {
+        memtracker::setCurrentTag(tag);
+    }
+
+    ~MemTagScope()
+    {
+        memtracker::setCurrentTag(m_previousTag);
+    }
+
+    MemTagScope(const MemTagScope& rhs) = delete;
+
+    MemTagScope&
+    operator = (const MemTagScope& rhs) = delete;
+
+private:
+
+    memtracker::MemTag m_previousTag;
+
+};
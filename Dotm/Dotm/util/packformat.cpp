@@ -0,0 +1,317 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        packformat.cpp
+
+   File description: Implementation of the pack
+   building and verification functions declared
+   in packformat.h
+   ------------------------------------------------ */
+
+#include "packformat.h"
+#include "lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+/* ----------------
+   Internal Structs
+   ---------------- */
+struct PendingEntry
+{
+    std::string        pen_name;
+    std::string        pen_path;
+    std::vector<uint8> pen_data;
+    bool               pen_compressed;
+    uint32             pen_originalSize;
+    uint32             pen_checksum;
+};
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static bool
+readWholeFile(const std::string& path, std::vector<uint8>& outData);
+
+static inline uint32
+alignUp(const uint32 value);
+
+static bool
+validateEntry(const std::vector<uint8>&     pack,
+              const packformat::PackHeader& header,
+              const packformat::PackEntry&  entry,
+              std::vector<uint8>&           outData);
+
+/* --------------
+   Public Methods
+   -------------- */
+bool
+packformat::buildPack(const std::string&              packPath,
+                      const std::vector<std::string>& filePaths,
+                      const bool                      compress,
+                      PackReport&                     outReport)
+{
+    outReport = PackReport();
+
+    std::vector<PendingEntry> entries(filePaths.size());
+    for (size_t i = 0;
+                i < filePaths.size();
+              ++i)
+    {
+        PendingEntry& entry = entries[i];
+        entry.pen_name = getEntryName(filePaths[i]);
+        entry.pen_path = filePaths[i];
+
+        if (!readWholeFile(entry.pen_path, entry.pen_data))
+        {
+            outReport.pr_error = "Could not read " + entry.pen_path;
+            return false;
+        }
+
+        entry.pen_originalSize = entry.pen_data.size();
+        entry.pen_checksum     = checksum(entry.pen_data.empty() ? nullptr : &entry.pen_data[0],
+                                          entry.pen_data.size());
+        entry.pen_compressed   = false;
+
+        // Already compressed formats (i.e. png) are stored as is
+        if (compress && !entry.pen_data.empty())
+        {
+            std::vector<uint8> block;
+            lz4::compress(&entry.pen_data[0], entry.pen_data.size(), block);
+            if (block.size() < entry.pen_data.size())
+            {
+                entry.pen_data.swap(block);
+                entry.pen_compressed = true;
+            }
+        }
+    }
+
+    // Sorting by name keeps each asset kind (and each directory)
+    // contiguous within the data section
+    std::sort(entries.begin(), entries.end(), [](const PendingEntry& lhs, const PendingEntry& rhs)
+    {
+        return lhs.pen_name < rhs.pen_name;
+    });
+
+    for (size_t i = 1;
+                i < entries.size();
+              ++i)
+    {
+        if (entries[i].pen_name == entries[i - 1].pen_name)
+        {
+            outReport.pr_error = "Duplicate entry " + entries[i].pen_name;
+            return false;
+        }
+    }
+
+    // Layout: header, toc, names, then the aligned entry data
+    PackHeader header = {};
+    header.ph_magic       = PACK_MAGIC;
+    header.ph_version     = PACK_VERSION;
+    header.ph_nEntries    = entries.size();
+    header.ph_tocOffset   = sizeof(PackHeader);
+    header.ph_namesOffset = header.ph_tocOffset + sizeof(PackEntry) * header.ph_nEntries;
+
+    std::vector<PackEntry> toc(entries.size());
+    std::string            names;
+    for (size_t i = 0;
+                i < entries.size();
+              ++i)
+    {
+        toc[i].pe_nameOffset = names.size();
+        toc[i].pe_nameLength = entries[i].pen_name.size();
+        names += entries[i].pen_name;
+    }
+
+    header.ph_namesSize  = names.size();
+    header.ph_dataOffset = alignUp(header.ph_namesOffset + header.ph_namesSize);
+
+    uint32 dataCursor = 0U;
+    for (size_t i = 0;
+                i < entries.size();
+              ++i)
+    {
+        toc[i].pe_dataOffset   = dataCursor;
+        toc[i].pe_storedSize   = entries[i].pen_data.size();
+        toc[i].pe_originalSize = entries[i].pen_originalSize;
+        toc[i].pe_flags        = entries[i].pen_compressed ? PACK_FLAG_COMPRESSED : 0U;
+        toc[i].pe_checksum     = entries[i].pen_checksum;
+        dataCursor             = alignUp(dataCursor + toc[i].pe_storedSize);
+
+        EntryReport entryReport = {};
+        entryReport.er_name         = entries[i].pen_name;
+        entryReport.er_originalSize = toc[i].pe_originalSize;
+        entryReport.er_storedSize   = toc[i].pe_storedSize;
+        entryReport.er_compressed   = entries[i].pen_compressed;
+        entryReport.er_valid        = true;
+        outReport.pr_entries.push_back(entryReport);
+        outReport.pr_totalOriginalBytes += toc[i].pe_originalSize;
+        outReport.pr_totalStoredBytes   += toc[i].pe_storedSize;
+    }
+    header.ph_dataSize = dataCursor;
+
+    std::vector<uint8> pack(header.ph_dataOffset + header.ph_dataSize, 0U);
+    memcpy(&pack[0], &header, sizeof(PackHeader));
+    if (!toc.empty())   memcpy(&pack[header.ph_tocOffset], &toc[0], sizeof(PackEntry) * toc.size());
+    if (!names.empty()) memcpy(&pack[header.ph_namesOffset], names.data(), names.size());
+
+    for (size_t i = 0;
+                i < entries.size();
+              ++i)
+    {
+        if (entries[i].pen_data.empty()) continue;
+        memcpy(&pack[header.ph_dataOffset + toc[i].pe_dataOffset],
+               &entries[i].pen_data[0],
+               entries[i].pen_data.size());
+    }
+
+    std::ofstream file(packPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open() ||
+        !file.write(reinterpret_cast<const char*>(&pack[0]), pack.size()))
+    {
+        outReport.pr_error = "Could not write " + packPath;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+packformat::verifyPack(const std::string& packPath,
+                       const bool         compareSources,
+                       PackReport&        outReport)
+{
+    outReport = PackReport();
+
+    std::vector<uint8> pack;
+    if (!readWholeFile(packPath, pack))
+    {
+        outReport.pr_error = "Could not read " + packPath;
+        return false;
+    }
+
+    PackHeader header = {};
+    if (pack.size() < sizeof(PackHeader))
+    {
+        outReport.pr_error = "Truncated header";
+        return false;
+    }
+    memcpy(&header, &pack[0], sizeof(PackHeader));
+
+    if (header.ph_magic != PACK_MAGIC || header.ph_version != PACK_VERSION)
+    {
+        outReport.pr_error = "Not a pack or unsupported version";
+        return false;
+    }
+
+    const ullong64 tocEnd = header.ph_tocOffset + static_cast<ullong64>(sizeof(PackEntry)) * header.ph_nEntries;
+    if (tocEnd > pack.size()                                                   ||
+        header.ph_namesOffset + static_cast<ullong64>(header.ph_namesSize) > pack.size() ||
+        header.ph_dataOffset  + static_cast<ullong64>(header.ph_dataSize)  > pack.size())
+    {
+        outReport.pr_error = "Sections out of bounds";
+        return false;
+    }
+
+    std::vector<uint8> data, source;
+    std::string        previousName;
+    for (uint32 i = 0;
+                i < header.ph_nEntries;
+              ++i)
+    {
+        PackEntry entry = {};
+        memcpy(&entry, &pack[header.ph_tocOffset + sizeof(PackEntry) * i], sizeof(PackEntry));
+
+        EntryReport entryReport = {};
+        entryReport.er_originalSize = entry.pe_originalSize;
+        entryReport.er_storedSize   = entry.pe_storedSize;
+        entryReport.er_compressed   = (entry.pe_flags & PACK_FLAG_COMPRESSED) != 0;
+
+        if (entry.pe_nameOffset + static_cast<ullong64>(entry.pe_nameLength) <= header.ph_namesSize)
+        {
+            entryReport.er_name.assign(reinterpret_cast<const char*>(&pack[header.ph_namesOffset + entry.pe_nameOffset]),
+                                       entry.pe_nameLength);
+        }
+
+        // Names must be present, unique and sorted
+        entryReport.er_valid = !entryReport.er_name.empty()                    &&
+                               (i == 0 || previousName < entryReport.er_name) &&
+                               validateEntry(pack, header, entry, data);
+
+        if (entryReport.er_valid && compareSources)
+        {
+            entryReport.er_valid = readWholeFile(entryReport.er_name, source) &&
+                                   source == data;
+        }
+
+        if (!entryReport.er_valid) ++outReport.pr_nInvalid;
+        outReport.pr_totalOriginalBytes += entry.pe_originalSize;
+        outReport.pr_totalStoredBytes   += entry.pe_storedSize;
+        outReport.pr_entries.push_back(entryReport);
+        previousName = entryReport.er_name;
+    }
+
+    return outReport.pr_nInvalid == 0U;
+}
+
+std::string
+packformat::getEntryName(const std::string& path)
+{
+    std::string name(path);
+    std::replace(name.begin(), name.end(), '\\', '/');
+    while (name.compare(0, 2, "./") == 0) name.erase(0, 2);
+    return name;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static bool
+readWholeFile(const std::string& path, std::vector<uint8>& outData)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+
+    const std::streamoff fileSize = file.tellg();
+    if (fileSize < 0) return false;
+
+    outData.resize(static_cast<size_t>(fileSize));
+    file.seekg(0, std::ios::beg);
+    if (fileSize > 0 && !file.read(reinterpret_cast<char*>(&outData[0]), fileSize)) return false;
+
+    return true;
+}
+
+static inline uint32
+alignUp(const uint32 value)
+{
+    return (value + packformat::PACK_DATA_ALIGNMENT - 1) & ~(packformat::PACK_DATA_ALIGNMENT - 1);
+}
+
+static bool
+validateEntry(const std::vector<uint8>&     pack,
+              const packformat::PackHeader& header,
+              const packformat::PackEntry&  entry,
+              std::vector<uint8>&           outData)
+{
+    if (entry.pe_dataOffset % packformat::PACK_DATA_ALIGNMENT != 0 ||
+        entry.pe_dataOffset + static_cast<ullong64>(entry.pe_storedSize) > header.ph_dataSize) return false;
+
+    const uint8* stored = pack.empty() ? nullptr : &pack[0] + header.ph_dataOffset + entry.pe_dataOffset;
+
+    outData.resize(entry.pe_originalSize);
+    if ((entry.pe_flags & packformat::PACK_FLAG_COMPRESSED) != 0)
+    {
+        if (!lz4::decompress(stored,
+                             entry.pe_storedSize,
+                             outData.empty() ? nullptr : &outData[0],
+                             outData.size())) return false;
+    }
+    else
+    {
+        if (entry.pe_storedSize != entry.pe_originalSize) return false;
+        if (!outData.empty()) memcpy(&outData[0], stored, outData.size());
+    }
+
+    return packformat::checksum(outData.empty() ? nullptr : &outData[0], outData.size()) == entry.pe_checksum;
+}
@@ -0,0 +1,110 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        packformat.h
+
+   File description: The asset pack file format,
+   along with the (platform independent) functions
+   that build and verify packs. A pack holds a
+   header, a table of contents, a blob of entry
+   names and the entry data, sorted by name so that
+   assets of the same kind are contiguous. Entries
+   may be LZ4 compressed, and are checksummed so
+   that a pack can be verified against its sources.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include <string>
+#include <vector>
+
+namespace packformat
+{
+    static const uint32 PACK_MAGIC            = 0x4B415044; // "DPAK"
+    static const uint32 PACK_VERSION          = 1;
+    static const uint32 PACK_DATA_ALIGNMENT   = 16;
+    static const uint32 PACK_FLAG_COMPRESSED  = 0x01;
+
+    struct PackHeader
+    {
+        uint32 ph_magic;
+        uint32 ph_version;
+        uint32 ph_nEntries;
+        uint32 ph_tocOffset;
+        uint32 ph_namesOffset;
+        uint32 ph_namesSize;
+        uint32 ph_dataOffset;
+        uint32 ph_dataSize;
+    };
+
+    struct PackEntry
+    {
+        uint32 pe_nameOffset;
+        uint32 pe_nameLength;
+        uint32 pe_dataOffset;
+        uint32 pe_storedSize;
+        uint32 pe_originalSize;
+        uint32 pe_flags;
+        uint32 pe_checksum;
+        uint32 pe_reserved;
+    };
+
+    struct EntryReport
+    {
+        std::string er_name;
+        uint32      er_originalSize;
+        uint32      er_storedSize;
+        bool        er_compressed;
+        bool        er_valid;
+    };
+
+    struct PackReport
+    {
+        std::vector<EntryReport> pr_entries;
+        ullong64                 pr_totalOriginalBytes;
+        ullong64                 pr_totalStoredBytes;
+        uint32                   pr_nInvalid;
+        std::string              pr_error;
+    };
+
+    // FNV-1a, used both as the entry checksum and by the tools
+    inline uint32
+    checksum(const uint8* data, const size_t size)
+    {
+        uint32 hash = 2166136261U;
+        for (size_t i = 0; i < size; ++i) hash = (hash ^ data[i]) * 16777619U;
+        return hash;
+    }
+
+    // <summary>
+    // <para>
+    // Builds a pack at packPath out of the given files. Entries are
+    // named after the paths as given (with forward slashes), which is
+    // how the engine looks them up. Entries are LZ4 compressed when
+    // compress is set and compression actually saves space.
+    // </para>
+    // </summary>
+    bool
+    buildPack(const std::string&              packPath,
+              const std::vector<std::string>& filePaths,
+              const bool                      compress,
+              PackReport&                     outReport);
+
+    // <summary>
+    // <para>
+    // Checks the layout of the pack at packPath and that every entry
+    // decompresses to data matching its checksum. If compareSources
+    // is set every entry is also compared against the file it was
+    // built from.
+    // </para>
+    // </summary>
+    bool
+    verifyPack(const std::string& packPath,
+               const bool         compareSources,
+               PackReport&        outReport);
+
+    // Normalizes a path into the form used for entry names
+    std::string
+    getEntryName(const std::string& path);
+}
@@ -114,10 +114,11 @@ physics::isPicked(const Mesh* mesh, const Camera* camera)
     
     // Create final ray
     math::Ray ray(rayOrigin, rayDirection);
+    const math::Sphere meshSphere = mesh->getCollidableGeometry();
 
     return intersectionTest(PHYSICS_INTERSECTION_TYPE_RAYSPHERE,
                             &ray,
-                            &mesh->getCollidableGeometry());
+                            &meshSphere);
 }
 
 bool
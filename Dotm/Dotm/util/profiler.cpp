@@ -0,0 +1,215 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        profiler.cpp
+
+   File description: Implementation of the profiler
+   functions declared in profiler.h
+   ------------------------------------------------ */
+
+#include "profiler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/* --------------
+   Internal Types
+   -------------- */
+struct ZoneEvent
+{
+    cstring ze_name;
+    llong64 ze_startTicks;
+    llong64 ze_endTicks;
+    uint32  ze_depth;
+};
+
+// Only the owning thread writes, and publishes each event by
+// advancing tb_nWritten. Exporters copy behind it and drop the
+// events the owner may have lapped in the meantime
+struct ThreadBuffer
+{
+    uint32                 tb_threadID;
+    std::atomic<ullong64>  tb_nWritten;
+    ZoneEvent              tb_events[profiler::MAX_EVENTS_PER_THREAD];
+};
+
+/* -------------
+   Internal Vars
+   ------------- */
+static std::mutex                                 s_registryMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> s_threadBuffers;
+static llong64                                    s_frameStarts[profiler::MAX_CAPTURED_FRAMES];
+static std::atomic<ullong64>                      s_nFrames(0U);
+static thread_local ThreadBuffer*                 s_threadBuffer = nullptr;
+static thread_local uint32                        s_zoneDepth    = 0U;
+
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static ThreadBuffer*
+registerThread();
+
+static void
+writeEscaped(FILE*   file,
+             cstring str);
+
+/* ----------------
+   Public Functions
+   ---------------- */
+llong64
+profiler::getTicks()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void
+profiler::beginFrame()
+{
+    const ullong64 frame = s_nFrames.load(std::memory_order_relaxed);
+    s_frameStarts[frame % MAX_CAPTURED_FRAMES] = getTicks();
+    s_nFrames.store(frame + 1U, std::memory_order_release);
+}
+
+bool
+profiler::exportChromeTrace(cstring      path,
+                            const uint32 nFrames /* MAX_CAPTURED_FRAMES */)
+{
+    // The capture window starts at the oldest requested frame
+    // still remembered
+    const ullong64 frameCount = s_nFrames.load(std::memory_order_acquire);
+    if (!frameCount || !nFrames) return false;
+
+    ullong64 firstFrame = frameCount > nFrames ? frameCount - nFrames : 0U;
+    if (frameCount - firstFrame > MAX_CAPTURED_FRAMES) firstFrame = frameCount - MAX_CAPTURED_FRAMES;
+    const llong64 windowStart = s_frameStarts[firstFrame % MAX_CAPTURED_FRAMES];
+
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    bool firstEvent = true;
+
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+    std::vector<ZoneEvent> events;
+    for (auto citer = s_threadBuffers.cbegin();
+              citer != s_threadBuffers.cend();
+            ++citer)
+    {
+        const ThreadBuffer& buffer = **citer;
+
+        const ullong64 nWritten = buffer.tb_nWritten.load(std::memory_order_acquire);
+        const ullong64 first    = nWritten > MAX_EVENTS_PER_THREAD ? nWritten - MAX_EVENTS_PER_THREAD : 0U;
+
+        events.clear();
+        for (ullong64 i = first;
+                      i < nWritten;
+                    ++i)
+        {
+            events.push_back(buffer.tb_events[i % MAX_EVENTS_PER_THREAD]);
+        }
+
+        // Anything the owner wrote since, plus the event it may be
+        // writing right now, may have replaced the oldest copied events
+        const ullong64 nWrittenAfter = buffer.tb_nWritten.load(std::memory_order_acquire);
+        const ullong64 firstSafe     = nWrittenAfter + 1U > MAX_EVENTS_PER_THREAD ? nWrittenAfter + 1U - MAX_EVENTS_PER_THREAD : 0U;
+        const ullong64 lapped        = firstSafe > first ? firstSafe - first : 0U;
+        const size_t   firstValid    = static_cast<size_t>(lapped < events.size() ? lapped : events.size());
+
+        fprintf(file,
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",
+                firstEvent ? "" : ",\n",
+                buffer.tb_threadID,
+                buffer.tb_threadID);
+        firstEvent = false;
+
+        for (size_t i = firstValid;
+                    i < events.size();
+                  ++i)
+        {
+            const ZoneEvent& zoneEvent = events[i];
+            if (zoneEvent.ze_startTicks < windowStart) continue;
+
+            fprintf(file, ",\n{\"name\":\"");
+            writeEscaped(file, zoneEvent.ze_name);
+            fprintf(file,
+                    "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"depth\":%u}}",
+                    buffer.tb_threadID,
+                    (zoneEvent.ze_startTicks - windowStart) / 1000.0,
+                    (zoneEvent.ze_endTicks - zoneEvent.ze_startTicks) / 1000.0,
+                    zoneEvent.ze_depth);
+        }
+    }
+
+    // Frame boundaries as instant events
+    for (ullong64 frame = firstFrame;
+                  frame < frameCount;
+                ++frame)
+    {
+        fprintf(file,
+                ",\n{\"name\":\"Frame %llu\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":%.3f}",
+                frame,
+                (s_frameStarts[frame % MAX_CAPTURED_FRAMES] - windowStart) / 1000.0);
+    }
+
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    return fclose(file) == 0;
+}
+
+void
+profiler::recordZone(cstring       name,
+                     const llong64 startTicks,
+                     const llong64 endTicks,
+                     const uint32  depth)
+{
+    ThreadBuffer* buffer = s_threadBuffer ? s_threadBuffer : registerThread();
+
+    const ullong64 index = buffer->tb_nWritten.load(std::memory_order_relaxed);
+    ZoneEvent& zoneEvent    = buffer->tb_events[index % MAX_EVENTS_PER_THREAD];
+    zoneEvent.ze_name       = name;
+    zoneEvent.ze_startTicks = startTicks;
+    zoneEvent.ze_endTicks   = endTicks;
+    zoneEvent.ze_depth      = depth;
+    buffer->tb_nWritten.store(index + 1U, std::memory_order_release);
+}
+
+uint32&
+profiler::getZoneDepth()
+{
+    return s_zoneDepth;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static ThreadBuffer*
+registerThread()
+{
+    // Buffers outlive their threads, so that the zones of finished
+    // threads can still be exported
+    std::lock_guard<std::mutex> lock(s_registryMutex);
+
+    ThreadBuffer* buffer = new ThreadBuffer();
+    buffer->tb_threadID  = static_cast<uint32>(s_threadBuffers.size());
+    buffer->tb_nWritten.store(0U, std::memory_order_relaxed);
+    s_threadBuffers.emplace_back(buffer);
+
+    s_threadBuffer = buffer;
+    return buffer;
+}
+
+static void
+writeEscaped(FILE*   file,
+             cstring str)
+{
+    for (cstring chr = str;
+                *chr;
+              ++chr)
+    {
+        if (*chr == '"' || *chr == '\\') fputc('\\', file);
+        fputc(*chr, file);
+    }
+}
@@ -0,0 +1,108 @@
+/* ------------------------------------------------
+   Author:           Alex Koukoulas
+   Date:             19/10/2026
+   File name:        profiler.h
+
+   File description: A hierarchical CPU profiler.
+   Scoped zones (PROFILE_ZONE) record their start
+   and end time into a ring buffer owned by the
+   calling thread, so recording takes no locks and
+   zones nest naturally. The main loop marks frame
+   boundaries, and the zones of the last captured
+   frames can be exported as a Chrome trace
+   (chrome://tracing, or ui.perfetto.dev) for
+   offline analysis.
+   ------------------------------------------------ */
+
+#pragma once
+
+#include "../dotmdef.h"
+#include "strings.h"
+
+// Comment out to compile all the zones out
+#define PROFILER_ENABLED
+
+#define PROFILE_ZONE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b)      PROFILE_ZONE_CONCAT_IMPL(a, b)
+
+#if defined(PROFILER_ENABLED)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
+
+namespace profiler
+{
+    // Zones of at most this many frames back can be exported
+    static const uint32 MAX_CAPTURED_FRAMES   = 120U;
+
+    // Per thread. Older zones are overwritten first
+    static const uint32 MAX_EVENTS_PER_THREAD = 65536U;
+
+    // Nanoseconds on a monotonic clock
+    llong64
+    getTicks();
+
+    // Marks the start of a new frame. Main thread only
+    void
+    beginFrame();
+
+    // <summary>
+    // <para>
+    // Writes the zones of the last nFrames frames, from every
+    // thread, as a Chrome trace JSON file. Zones still being
+    // overwritten while exporting are skipped. Returns false if
+    // the file could not be written.
+    // </para>
+    // </summary>
+    bool
+    exportChromeTrace(cstring      path,
+                      const uint32 nFrames = MAX_CAPTURED_FRAMES);
+
+    // Called by ProfileZone
+    void
+    recordZone(cstring       name,
+               const llong64 startTicks,
+               const llong64 endTicks,
+               const uint32  depth);
+
+    uint32&
+    getZoneDepth();
+}
+
+/* ==================
+   Class: ProfileZone
+   ================== */
+
+// The name must outlive the profiler (e.g. a string literal)
+class ProfileZone
+{
+public:
+
+    explicit
+    ProfileZone(cstring name):
+
+        m_name(name),
+        m_depth(profiler::getZoneDepth()++),
+        m_startTicks(profiler::getTicks())
+    {
+    }
+
+    ~ProfileZone()
+    {
+        profiler::recordZone(m_name, m_startTicks, profiler::getTicks(), m_depth);
+        --profiler::getZoneDepth();
+    }
+
+    ProfileZone(const ProfileZone& rhs) = delete;
+
+    ProfileZone&
+    operator = (const ProfileZone& rhs) = delete;
+
+private:
+
+    cstring m_name;
+    uint32  m_depth;
+    llong64 m_startTicks;
+
+};
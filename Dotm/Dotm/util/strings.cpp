@@ -4,20 +4,97 @@
    File name:        strings.cpp
 
    File description: Implementation of
-   the functinos declared in strings.h
+   the functinos declared in strings.h.
+
+   The intern table is split into shards by
+   the low bits of the ID. Each shard is an
+   open addressing table of pointers into an
+   append-only arena. Writers lock their shard,
+   while readers only follow atomic pointers:
+   entries are never moved or freed, and a
+   grown table is published whole, the old one
+   being kept alive for readers still probing it.
    ------------------------------------------- */
 
 #include "strings.h"
-#include "../dotmdef.h"
-#include <unordered_map>
-#include <functional>
+#include "logging.h"
+#include "memtracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
+
+/* ---------
+   Constants
+   --------- */
+#define INTERN_SHARD_BITS          4
+#define INTERN_SHARD_COUNT         (1U << INTERN_SHARD_BITS)
+#define INTERN_INITIAL_SLOTS       256
+#define INTERN_ARENA_BLOCK_SIZE    16384
+
+/* --------------
+   Internal Types
+   -------------- */
+struct InternEntry
+{
+    stringID ie_id;
+    size_t   ie_length;
+    cstring  ie_chars;
+};
+
+// Slot count is a power of two, kept at most half full
+struct InternSlotTable
+{
+    explicit
+    InternSlotTable(const size_t nSlots):
+
+        ist_mask(nSlots - 1U),
+        ist_slots(new std::atomic<const InternEntry*>[nSlots])
+    {
+        for (size_t i = 0;
+                    i < nSlots;
+                  ++i)
+        {
+            ist_slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    size_t                                            ist_mask;
+    std::unique_ptr<std::atomic<const InternEntry*>[]> ist_slots;
+};
+
+struct InternShard
+{
+    std::mutex                                    is_writeMutex;
+    std::atomic<InternSlotTable*>                 is_table;
+    std::vector<std::unique_ptr<InternSlotTable>> is_tables;
+    size_t                                        is_nEntries;
+    std::vector<std::unique_ptr<uint8[]>>         is_arenaBlocks;
+    size_t                                        is_arenaUsed;
+    size_t                                        is_arenaSize;
+};
 
-/* -------------
-   Global Vars
-   ------------- */
-static std::unordered_map<stringID, std::string> stringTable;
-static std::hash<std::string> hashFunc;
+/* -------------------
+   Internal Signatures
+   ------------------- */
+static InternShard&
+getShard(const stringID id);
+
+static const InternEntry*
+findEntry(const InternSlotTable* table,
+          const stringID         id);
+
+static void
+insertEntry(InternSlotTable*   table,
+            const InternEntry* entry);
+
+static void*
+allocateArena(InternShard& shard,
+              const size_t size);
 
 /* ----------------
    Public Functions
@@ -25,9 +102,67 @@ static std::hash<std::string> hashFunc;
 stringID 
 internString(cstring str)
 {
-    std::string internalString = std::string(str);
-    stringID id = hashFunc(internalString);
-    stringTable[id] = internalString;
+    const stringID id     = hashString(str);
+    const size_t   length = strlen(str);
+
+    // Most strings are interned many times over, so the
+    // lock free lookup comes first
+    InternShard&       shard = getShard(id);
+    const InternEntry* entry = findEntry(shard.is_table.load(std::memory_order_acquire), id);
+    if (!entry)
+    {
+        std::lock_guard<std::mutex> writeLock(shard.is_writeMutex);
+        MEM_TAG_SCOPE(memtracker::MEM_TAG_STRINGS);
+
+        InternSlotTable* table = shard.is_table.load(std::memory_order_relaxed);
+        entry = findEntry(table, id);
+        if (!entry)
+        {
+            if ((shard.is_nEntries + 1U) * 2U > table->ist_mask + 1U)
+            {
+                // Readers may still be probing the old table, so it
+                // stays alive and the grown one is published whole
+                InternSlotTable* grownTable = new InternSlotTable((table->ist_mask + 1U) * 2U);
+                for (size_t i = 0;
+                            i <= table->ist_mask;
+                          ++i)
+                {
+                    const InternEntry* oldEntry = table->ist_slots[i].load(std::memory_order_relaxed);
+                    if (oldEntry) insertEntry(grownTable, oldEntry);
+                }
+                shard.is_tables.emplace_back(grownTable);
+                shard.is_table.store(grownTable, std::memory_order_release);
+                table = grownTable;
+            }
+
+            char* chars = static_cast<char*>(allocateArena(shard, length + 1U));
+            memcpy(chars, str, length + 1U);
+
+            InternEntry* newEntry = static_cast<InternEntry*>(allocateArena(shard, sizeof(InternEntry)));
+            newEntry->ie_id       = id;
+            newEntry->ie_length   = length;
+            newEntry->ie_chars    = chars;
+
+            insertEntry(table, newEntry);
+            ++shard.is_nEntries;
+            return id;
+        }
+    }
+
+    // IDs are also computed from the strings directly (see
+    // hashString), so a colliding string cannot be given another
+    // ID. Carrying on would silently alias two assets, in release
+    // builds too, hence the abort
+    if (entry->ie_length != length || memcmp(entry->ie_chars, str, length) != 0)
+    {
+        fprintf(stderr, "String ID collision: \"%s\" / \"%s\"\n", entry->ie_chars, str);
+        logstring("String ID collision: ");
+        logstring(entry->ie_chars);
+        logstring(" / ");
+        logline(str);
+        abort();
+    }
+
     return id;
 }
 
@@ -49,6 +184,87 @@ internString(void* number)
 cstring 
 retrieveString(const stringID id)
 {
-    if (stringTable.count(id)) return stringTable[id].c_str();
-    return nullptr;
-}
\ No newline at end of file
+    const InternEntry* entry = findEntry(getShard(id).is_table.load(std::memory_order_acquire), id);
+    return entry ? entry->ie_chars : nullptr;
+}
+
+/* ------------------
+   Internal Functions
+   ------------------ */
+static InternShard&
+getShard(const stringID id)
+{
+    // Shards and their first tables are created on first use, so
+    // strings can be interned during static initialization
+    struct InternShards
+    {
+        InternShards()
+        {
+            for (size_t i = 0;
+                        i < INTERN_SHARD_COUNT;
+                      ++i)
+            {
+                is_shards[i].is_tables.emplace_back(new InternSlotTable(INTERN_INITIAL_SLOTS));
+                is_shards[i].is_table.store(is_shards[i].is_tables.back().get(), std::memory_order_release);
+                is_shards[i].is_nEntries  = 0U;
+                is_shards[i].is_arenaUsed = 0U;
+                is_shards[i].is_arenaSize = 0U;
+            }
+        }
+
+        InternShard is_shards[INTERN_SHARD_COUNT];
+    };
+
+    static InternShards s_shards;
+    return s_shards.is_shards[id & (INTERN_SHARD_COUNT - 1U)];
+}
+
+static const InternEntry*
+findEntry(const InternSlotTable* table,
+          const stringID         id)
+{
+    // The shard bits are the same for all of a shard's IDs
+    for (size_t slot = (id >> INTERN_SHARD_BITS) & table->ist_mask;
+                ;
+                slot = (slot + 1U) & table->ist_mask)
+    {
+        const InternEntry* entry = table->ist_slots[slot].load(std::memory_order_acquire);
+        if (!entry || entry->ie_id == id) return entry;
+    }
+}
+
+static void
+insertEntry(InternSlotTable*   table,
+            const InternEntry* entry)
+{
+    size_t slot = (entry->ie_id >> INTERN_SHARD_BITS) & table->ist_mask;
+    while (table->ist_slots[slot].load(std::memory_order_relaxed))
+    {
+        slot = (slot + 1U) & table->ist_mask;
+    }
+
+    // Release, so that a reader seeing the pointer also sees
+    // the entry and its characters
+    table->ist_slots[slot].store(entry, std::memory_order_release);
+}
+
+static void*
+allocateArena(InternShard& shard,
+              const size_t size)
+{
+    const size_t alignment   = alignof(InternEntry);
+    const size_t alignedUsed = (shard.is_arenaUsed + alignment - 1U) & ~(alignment - 1U);
+
+    if (alignedUsed + size > shard.is_arenaSize)
+    {
+        // Strings longer than a block get a block of their own
+        const size_t blockSize = size > INTERN_ARENA_BLOCK_SIZE ? size : INTERN_ARENA_BLOCK_SIZE;
+        shard.is_arenaBlocks.emplace_back(new uint8[blockSize]);
+        shard.is_arenaUsed = size;
+        shard.is_arenaSize = blockSize;
+        return shard.is_arenaBlocks.back().get();
+    }
+
+    shard.is_arenaUsed = alignedUsed + size;
+    return shard.is_arenaBlocks.back().get() + alignedUsed;
+}
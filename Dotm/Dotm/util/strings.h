@@ -11,10 +11,54 @@
 
 #pragma once
 
+#include "../dotmdef.h"
+#include <cstddef>
+
 typedef size_t stringID;
 typedef const char* cstring;
 typedef const wchar_t* cwstring;
 
+// <summary>
+// <para>
+// The ID of a string is the FNV-1a hash of its bytes, so it can
+// be computed without the intern table, and at compile time for
+// literals, e.g. constexpr stringID id = hashString("bullet01").
+// internString returns the same ID for the same string.
+// </para>
+// </summary>
+constexpr stringID
+hashString(cstring str, const ullong64 hash = 14695981039346656037ULL)
+{
+    return *str ? hashString(str + 1, (hash ^ static_cast<uint8>(*str)) * 1099511628211ULL) :
+                  static_cast<stringID>(hash);
+}
+
+// <summary>
+// <para>
+// A string together with its ID. Declared constexpr for literal
+// asset names (e.g. static constexpr HashedString s_name("x")),
+// it lets hot constructors skip hashing entirely: the ID finds
+// the cached asset, and the string is only read (and interned)
+// when the asset has to be loaded.
+// </para>
+// </summary>
+struct HashedString
+{
+    explicit constexpr
+    HashedString(cstring str): hs_id(hashString(str)), hs_str(str) {}
+
+    stringID hs_id;
+    cstring  hs_str;
+};
+
+// <summary>
+// <para>
+// Stores a copy of the string and returns its ID. Safe to call
+// from any thread. Strings are never freed. Interning a string
+// whose ID collides with a different string already interned
+// aborts, in all builds, as one of the two must be renamed.
+// </para>
+// </summary>
 stringID 
 internString(cstring str);
 
@@ -24,5 +68,6 @@ internString(cwstring str);
 stringID 
 internString(void* number);
 
+// Lock free. Returns nullptr for IDs never interned
 cstring
 retrieveString(const stringID id);
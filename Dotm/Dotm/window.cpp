@@ -9,6 +9,7 @@
 
 #include "window.h"
 #include "config/configparser.h"
+#include <string>
 
 /* -----------------
    Const Definitions
@@ -37,7 +38,14 @@ Window::Window(const char*      configPath,
                      (real32) m_screenHeight;
     
     // assert config file exists
-    if(!config::initConfigFile(configPath)) return;
+    if(!config::initConfigFile(configPath))
+    {
+        std::string message("The ");
+        message += configPath;
+        message += " config file could not be found. Press OK to exit the application";
+        MessageBox(nullptr, message.c_str(), "Config file not Found", MB_ICONERROR);
+        return;
+    }
     
     config::extractConfigString("winconfig", "app_name", &m_appName);    
     config::extractConfigBool("winconfig", "fullscreen", &m_fullscreen);